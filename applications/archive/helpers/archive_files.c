@@ -2,6 +2,7 @@
 #include "archive_browser.h"
 
 #define TAG "Archive"
+#define ARCHIVE_DIR_PAGE 8
 
 bool filter_by_extension(FileInfo* file_info, const char* tab_ext, const char* name) {
     furi_assert(file_info);
@@ -66,32 +67,12 @@ bool archive_get_filenames(void* context, const char* path) {
 bool archive_dir_empty(void* context, const char* path) { // can be simpler?
     furi_assert(context);
 
-    FileInfo file_info;
     Storage* fs_api = furi_record_open("storage");
-    File* directory = storage_file_alloc(fs_api);
     char name[MAX_NAME_LEN];
+    uint32_t readed = 0;
 
-    if(!storage_dir_open(directory, path)) {
-        storage_dir_close(directory);
-        storage_file_free(directory);
-        return false;
-    }
-
-    bool files_found = false;
-    while(1) {
-        if(!storage_dir_read(directory, &file_info, name, MAX_NAME_LEN)) {
-            break;
-        }
-        if(files_found) {
-            break;
-        } else if(storage_file_get_error(directory) == FSE_OK) {
-            files_found = name[0];
-        } else {
-            return false;
-        }
-    }
-    storage_dir_close(directory);
-    storage_file_free(directory);
+    FS_Error error = storage_dir_read_page(fs_api, path, 0, 1, NULL, name, MAX_NAME_LEN, &readed);
+    bool files_found = (error == FSE_OK) && readed && name[0];
 
     furi_record_close("storage");
 
@@ -102,39 +83,27 @@ bool archive_read_dir(void* context, const char* path) {
     furi_assert(context);
 
     ArchiveBrowserView* browser = context;
-    FileInfo file_info;
     Storage* fs_api = furi_record_open("storage");
-    File* directory = storage_file_alloc(fs_api);
-    char name[MAX_NAME_LEN];
-    size_t files_cnt = 0;
-
-    if(!storage_dir_open(directory, path)) {
-        storage_dir_close(directory);
-        storage_file_free(directory);
-        return false;
-    }
-
-    while(1) {
-        if(!storage_dir_read(directory, &file_info, name, MAX_NAME_LEN)) {
-            break;
-        }
-        if(files_cnt > MAX_FILES) {
-            break;
-        } else if(storage_file_get_error(directory) == FSE_OK) {
-            archive_add_item(browser, &file_info, name);
+    FileInfo file_info[ARCHIVE_DIR_PAGE];
+    char* names = furi_alloc(ARCHIVE_DIR_PAGE * MAX_NAME_LEN);
+    uint32_t files_cnt = 0;
+    uint32_t readed = 0;
+    FS_Error error;
+
+    // Page by page, storage keeps the listing, so coming back to the folder is cheap
+    do {
+        error = storage_dir_read_page(
+            fs_api, path, files_cnt, ARCHIVE_DIR_PAGE, file_info, names, MAX_NAME_LEN, &readed);
+        for(uint32_t i = 0; i < readed && files_cnt <= MAX_FILES; i++) {
+            archive_add_item(browser, &file_info[i], &names[i * MAX_NAME_LEN]);
             ++files_cnt;
-        } else {
-            storage_dir_close(directory);
-            storage_file_free(directory);
-            return false;
         }
-    }
-    storage_dir_close(directory);
-    storage_file_free(directory);
+    } while(error == FSE_OK && readed == ARCHIVE_DIR_PAGE && files_cnt <= MAX_FILES);
 
+    free(names);
     furi_record_close("storage");
 
-    return true;
+    return error == FSE_OK;
 }
 
 void archive_file_append(const char* path, const char* format, ...) {
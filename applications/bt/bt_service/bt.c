@@ -8,6 +8,8 @@
 #define BT_RPC_EVENT_DISCONNECTED (1UL << 1)
 #define BT_RPC_EVENT_ALL (BT_RPC_EVENT_BUFF_SENT | BT_RPC_EVENT_DISCONNECTED)
 
+#define BT_RPC_TX_STREAM_SIZE 1024
+
 static void bt_draw_statusbar_callback(Canvas* canvas, void* context) {
     furi_assert(context);
 
@@ -82,6 +84,14 @@ Bt* bt_alloc() {
     // RPC
     bt->rpc = furi_record_open("rpc");
     bt->rpc_event = osEventFlagsNew(NULL);
+    bt->rpc_tx_stream = xStreamBufferCreate(BT_RPC_TX_STREAM_SIZE, 1);
+    bt->rpc_tx_mutex = osMutexNew(NULL);
+    bt->rpc_stats = furi_stats_group_alloc("bt_rpc");
+    bt->rpc_stats_messages = furi_stats_counter_alloc(bt->rpc_stats, "tx_messages");
+    bt->rpc_stats_bytes = furi_stats_counter_alloc(bt->rpc_stats, "tx_bytes");
+    bt->rpc_stats_packets = furi_stats_counter_alloc(bt->rpc_stats, "tx_packets");
+    bt->rpc_stats_packet_size = furi_stats_histogram_alloc(bt->rpc_stats, "tx_packet_size", "B");
+    bt->rpc_stats_rate = furi_stats_histogram_alloc(bt->rpc_stats, "tx_rate", "B/s");
 
     return bt;
 }
@@ -98,11 +108,49 @@ static uint16_t bt_on_data_received_callback(uint8_t* data, uint16_t size, void*
     return rpc_session_get_available_size(bt->rpc_session);
 }
 
+// Send next packet from TX queue if previous one is confirmed
+// Called with rpc_tx_mutex acquired, from RPC or GAP thread
+static void bt_rpc_tx_next(Bt* bt) {
+    if(bt->rpc_tx_busy) return;
+
+    // Queued messages are coalesced into packets of max size
+    size_t packet_size =
+        xStreamBufferReceive(bt->rpc_tx_stream, bt->rpc_tx_packet, bt->max_packet_size, 0);
+    if(packet_size == 0) {
+        // Queue is drained: burst is over
+        uint32_t ticks = osKernelGetTickCount() - bt->rpc_tx_burst_start;
+        if(bt->rpc_tx_burst_bytes && ticks) {
+            furi_stats_histogram_add(
+                bt->rpc_stats_rate,
+                (uint64_t)bt->rpc_tx_burst_bytes * osKernelGetTickFreq() / ticks);
+        }
+        bt->rpc_tx_burst_bytes = 0;
+        return;
+    }
+
+    if(bt->rpc_tx_burst_bytes == 0) {
+        bt->rpc_tx_burst_start = osKernelGetTickCount();
+    }
+    bt->rpc_tx_burst_bytes += packet_size;
+    furi_stats_counter_add(bt->rpc_stats_bytes, packet_size);
+    furi_stats_counter_add(bt->rpc_stats_packets, 1);
+    furi_stats_histogram_add(bt->rpc_stats_packet_size, packet_size);
+
+    bt->rpc_tx_busy = true;
+    furi_hal_bt_tx(bt->rpc_tx_packet, packet_size);
+}
+
 // Called from GAP thread from Serial service
 static void bt_on_data_sent_callback(void* context) {
     furi_assert(context);
     Bt* bt = context;
 
+    // Next packet goes out right away, without waiting for RPC thread
+    furi_check(osMutexAcquire(bt->rpc_tx_mutex, osWaitForever) == osOK);
+    bt->rpc_tx_busy = false;
+    bt_rpc_tx_next(bt);
+    furi_check(osMutexRelease(bt->rpc_tx_mutex) == osOK);
+
     osEventFlagsSet(bt->rpc_event, BT_RPC_EVENT_BUFF_SENT);
 }
 
@@ -111,22 +159,24 @@ static void bt_rpc_send_bytes_callback(void* context, uint8_t* bytes, size_t byt
     furi_assert(context);
     Bt* bt = context;
 
-    osEventFlagsClear(bt->rpc_event, BT_RPC_EVENT_ALL);
+    furi_stats_counter_add(bt->rpc_stats_messages, 1);
     size_t bytes_sent = 0;
     while(bytes_sent < bytes_len) {
-        size_t bytes_remain = bytes_len - bytes_sent;
-        if(bytes_remain > bt->max_packet_size) {
-            furi_hal_bt_tx(&bytes[bytes_sent], bt->max_packet_size);
-            bytes_sent += bt->max_packet_size;
-        } else {
-            furi_hal_bt_tx(&bytes[bytes_sent], bytes_remain);
-            bytes_sent += bytes_remain;
-        }
-        uint32_t event_flag =
-            osEventFlagsWait(bt->rpc_event, BT_RPC_EVENT_ALL, osFlagsWaitAny, osWaitForever);
-        if(event_flag & BT_RPC_EVENT_DISCONNECTED) {
+        osEventFlagsClear(bt->rpc_event, BT_RPC_EVENT_BUFF_SENT);
+        if(osEventFlagsGet(bt->rpc_event) & BT_RPC_EVENT_DISCONNECTED) {
             break;
         }
+        // Only RPC thread writes to TX queue
+        bytes_sent +=
+            xStreamBufferSend(bt->rpc_tx_stream, &bytes[bytes_sent], bytes_len - bytes_sent, 0);
+        furi_check(osMutexAcquire(bt->rpc_tx_mutex, osWaitForever) == osOK);
+        bt_rpc_tx_next(bt);
+        furi_check(osMutexRelease(bt->rpc_tx_mutex) == osOK);
+        if(bytes_sent < bytes_len) {
+            // Queue is full, wait for confirmation to free some space
+            osEventFlagsWait(
+                bt->rpc_event, BT_RPC_EVENT_ALL, osFlagsWaitAny | osFlagsNoClear, osWaitForever);
+        }
     }
 }
 
@@ -145,6 +195,13 @@ static void bt_on_gap_event_callback(BleEvent event, void* context) {
         bt->status = BtStatusConnected;
         BtMessage message = {.type = BtMessageTypeUpdateStatusbar};
         furi_check(osMessageQueuePut(bt->message_queue, &message, 0, osWaitForever) == osOK);
+        // Reset RPC TX queue left from previous connection
+        osEventFlagsClear(bt->rpc_event, BT_RPC_EVENT_ALL);
+        furi_check(osMutexAcquire(bt->rpc_tx_mutex, osWaitForever) == osOK);
+        xStreamBufferReset(bt->rpc_tx_stream);
+        bt->rpc_tx_busy = false;
+        bt->rpc_tx_burst_bytes = 0;
+        furi_check(osMutexRelease(bt->rpc_tx_mutex) == osOK);
         // Open RPC session
         FURI_LOG_I(TAG, "Open RPC connection");
         bt->rpc_session = rpc_session_open(bt->rpc);
@@ -4,6 +4,7 @@
 
 #include <furi.h>
 #include <furi-hal.h>
+#include <stream_buffer.h>
 
 #include <gui/gui.h>
 #include <gui/view_port.h>
@@ -53,4 +54,17 @@ struct Bt {
     Rpc* rpc;
     RpcSession* rpc_session;
     osEventFlagsId_t rpc_event;
+    // RPC TX queue, drained by indication confirmations
+    StreamBufferHandle_t rpc_tx_stream;
+    osMutexId_t rpc_tx_mutex;
+    bool rpc_tx_busy;
+    uint8_t rpc_tx_packet[FURI_HAL_BT_PACKET_SIZE_MAX];
+    uint32_t rpc_tx_burst_start;
+    uint32_t rpc_tx_burst_bytes;
+    FuriStatsGroup* rpc_stats;
+    FuriStatsCounter* rpc_stats_messages;
+    FuriStatsCounter* rpc_stats_bytes;
+    FuriStatsCounter* rpc_stats_packets;
+    FuriStatsHistogram* rpc_stats_packet_size;
+    FuriStatsHistogram* rpc_stats_rate;
 };
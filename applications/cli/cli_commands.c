@@ -6,6 +6,7 @@
 #include <time.h>
 #include <notification/notification-messages.h>
 #include <shci.h>
+#include <args.h>
 
 #define ENCLAVE_SIGNATURE_KEY_SLOTS 10
 #define ENCLAVE_SIGNATURE_SIZE 16
@@ -452,15 +453,41 @@ void cli_command_ps(Cli* cli, string_t args, void* context) {
 }
 
 void cli_command_free(Cli* cli, string_t args, void* context) {
-    printf("Free heap size: %d\r\n", memmgr_get_free_heap());
+    size_t free_heap = memmgr_get_free_heap();
+    size_t max_block = memmgr_heap_get_max_free_block();
+    printf("Free heap size: %d\r\n", free_heap);
     printf("Minimum heap size: %d\r\n", memmgr_get_minimum_free_heap());
-    printf("Maximum heap block: %d\r\n", memmgr_heap_get_max_free_block());
+    printf("Maximum heap block: %d\r\n", max_block);
+    printf("Fragmentation: %d%%\r\n", free_heap ? 100 - max_block * 100 / free_heap : 0);
+    memmgr_heap_printf_slab_stats();
 }
 
 void cli_command_free_blocks(Cli* cli, string_t args, void* context) {
     memmgr_heap_printf_free_blocks();
 }
 
+void cli_command_stats(Cli* cli, string_t args, void* context) {
+    string_t word;
+    string_init(word);
+
+    bool reset = false;
+    if(args_read_string_and_trim(args, word) && !string_cmp_str(word, "reset")) {
+        reset = true;
+        string_reset(word);
+        args_read_string_and_trim(args, word);
+    }
+    // Empty filter matches every group
+    const char* filter = string_get_cstr(word);
+
+    if(reset) {
+        furi_stats_reset(filter);
+    } else if(!furi_stats_print(filter)) {
+        printf("No stats groups matching \"%s\"\r\n", filter);
+    }
+
+    string_clear(word);
+}
+
 void cli_command_i2c(Cli* cli, string_t args, void* context) {
     furi_hal_i2c_acquire(&furi_hal_i2c_handle_external);
     uint8_t test = 0;
@@ -493,6 +520,7 @@ void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "ps", CliCommandFlagParallelSafe, cli_command_ps, NULL);
     cli_add_command(cli, "free", CliCommandFlagParallelSafe, cli_command_free, NULL);
     cli_add_command(cli, "free_blocks", CliCommandFlagParallelSafe, cli_command_free_blocks, NULL);
+    cli_add_command(cli, "stats", CliCommandFlagParallelSafe, cli_command_stats, NULL);
 
     cli_add_command(cli, "vibro", CliCommandFlagDefault, cli_command_vibro, NULL);
     cli_add_command(cli, "led", CliCommandFlagDefault, cli_command_led, NULL);
@@ -21,6 +21,7 @@ Canvas* canvas_init() {
     // Setup u8g2
     u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, u8x8_hw_spi_stm32, u8g2_gpio_and_delay_stm32);
     canvas->orientation = CanvasOrientationHorizontal;
+    canvas->sent_buffer = furi_alloc(canvas_get_buffer_size(canvas));
     // Initialize display
     u8g2_InitDisplay(&canvas->fb);
     // Wake up display
@@ -37,6 +38,10 @@ Canvas* canvas_init() {
 
 void canvas_free(Canvas* canvas) {
     furi_assert(canvas);
+    for(size_t i = 0; i < CANVAS_ICON_CACHE_ITEMS; i++) {
+        free(canvas->icon_cache.items[i].decoded);
+    }
+    free(canvas->sent_buffer);
     free(canvas);
 }
 
@@ -52,7 +57,48 @@ void canvas_reset(Canvas* canvas) {
 
 void canvas_commit(Canvas* canvas) {
     furi_assert(canvas);
-    u8g2_SendBuffer(&canvas->fb);
+    CanvasCommitStats* stats = &canvas->commit_stats;
+    uint8_t* buffer = u8g2_GetBufferPtr(&canvas->fb);
+    uint8_t tile_width = u8g2_GetBufferTileWidth(&canvas->fb);
+    uint8_t pages = u8g2_GetBufferTileHeight(&canvas->fb);
+    size_t page_size = tile_width * 8;
+
+    // Send runs of changed pages, unchanged ones are already on display
+    stats->pages_sent = 0;
+    stats->pages_total = pages;
+    uint8_t page = 0;
+    while(page < pages) {
+        uint8_t first = page;
+        while(page < pages) {
+            size_t offset = page * page_size;
+            if(canvas->sent_valid &&
+               memcmp(&buffer[offset], &canvas->sent_buffer[offset], page_size) == 0)
+                break;
+            memcpy(&canvas->sent_buffer[offset], &buffer[offset], page_size);
+            page++;
+        }
+        if(page > first) {
+            u8g2_UpdateDisplayArea(&canvas->fb, 0, first, tile_width, page - first);
+            stats->pages_sent += page - first;
+        } else {
+            page++;
+        }
+    }
+
+    if(stats->pages_sent) {
+        u8x8_RefreshDisplay(u8g2_GetU8x8(&canvas->fb));
+    } else {
+        stats->commits_skipped++;
+    }
+    canvas->sent_valid = true;
+    stats->commits++;
+    stats->pages_sent_total += stats->pages_sent;
+}
+
+void canvas_get_commit_stats(Canvas* canvas, CanvasCommitStats* stats) {
+    furi_assert(canvas);
+    furi_assert(stats);
+    *stats = canvas->commit_stats;
 }
 
 uint8_t* canvas_get_buffer(Canvas* canvas) {
@@ -202,6 +248,78 @@ uint8_t canvas_glyph_width(Canvas* canvas, char symbol) {
     return u8g2_GetGlyphWidth(&canvas->fb, symbol);
 }
 
+static void canvas_icon_cache_evict(CanvasIconCache* cache, CanvasIconCacheItem* item) {
+    cache->size -= item->size;
+    free(item->decoded);
+    memset(item, 0, sizeof(CanvasIconCacheItem));
+}
+
+/** Get decoded icon frame, decompressing it only on cache miss */
+static const uint8_t*
+    canvas_icon_decode(Canvas* canvas, const uint8_t* data, uint8_t width, uint8_t height) {
+    CanvasIconCache* cache = &canvas->icon_cache;
+    uint8_t* decoded = NULL;
+
+    // First byte is compression flag, uncompressed frame is used as is
+    if(!data[0]) {
+        furi_hal_compress_icon_decode(data, &decoded);
+        return decoded;
+    }
+
+    cache->tick++;
+    CanvasIconCacheItem* lru = &cache->items[0];
+    for(size_t i = 0; i < CANVAS_ICON_CACHE_ITEMS; i++) {
+        CanvasIconCacheItem* item = &cache->items[i];
+        if(item->data == data) {
+            item->last_used = cache->tick;
+            cache->hits++;
+            return item->decoded;
+        } else if(item->last_used < lru->last_used) {
+            lru = item;
+        }
+    }
+
+    cache->misses++;
+    furi_hal_compress_icon_decode(data, &decoded);
+
+    // XBM rows are byte aligned
+    size_t size = ((width + 7) / 8) * height;
+    if(size > CANVAS_ICON_CACHE_SIZE) return decoded;
+
+    if(lru->data) canvas_icon_cache_evict(cache, lru);
+    while(cache->size + size > CANVAS_ICON_CACHE_SIZE) {
+        CanvasIconCacheItem* oldest = NULL;
+        for(size_t i = 0; i < CANVAS_ICON_CACHE_ITEMS; i++) {
+            CanvasIconCacheItem* item = &cache->items[i];
+            if(item->data && (!oldest || item->last_used < oldest->last_used)) oldest = item;
+        }
+        canvas_icon_cache_evict(cache, oldest);
+    }
+
+    lru->data = data;
+    lru->decoded = furi_alloc(size);
+    lru->size = size;
+    lru->last_used = cache->tick;
+    memcpy(lru->decoded, decoded, size);
+    cache->size += size;
+
+    return lru->decoded;
+}
+
+void canvas_get_icon_cache_stats(Canvas* canvas, CanvasIconCacheStats* stats) {
+    furi_assert(canvas);
+    furi_assert(stats);
+    CanvasIconCache* cache = &canvas->icon_cache;
+
+    stats->items = 0;
+    for(size_t i = 0; i < CANVAS_ICON_CACHE_ITEMS; i++) {
+        if(cache->items[i].data) stats->items++;
+    }
+    stats->size = cache->size;
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+}
+
 void canvas_draw_icon_animation(
     Canvas* canvas,
     uint8_t x,
@@ -212,15 +330,11 @@ void canvas_draw_icon_animation(
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* icon_data = NULL;
-    furi_hal_compress_icon_decode(icon_animation_get_data(icon_animation), &icon_data);
-    u8g2_DrawXBM(
-        &canvas->fb,
-        x,
-        y,
-        icon_animation_get_width(icon_animation),
-        icon_animation_get_height(icon_animation),
-        icon_data);
+    uint8_t width = icon_animation_get_width(icon_animation);
+    uint8_t height = icon_animation_get_height(icon_animation);
+    const uint8_t* icon_data =
+        canvas_icon_decode(canvas, icon_animation_get_data(icon_animation), width, height);
+    u8g2_DrawXBM(&canvas->fb, x, y, width, height, icon_data);
 }
 
 void canvas_draw_icon(Canvas* canvas, uint8_t x, uint8_t y, const Icon* icon) {
@@ -229,9 +343,10 @@ void canvas_draw_icon(Canvas* canvas, uint8_t x, uint8_t y, const Icon* icon) {
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* icon_data = NULL;
-    furi_hal_compress_icon_decode(icon_get_data(icon), &icon_data);
-    u8g2_DrawXBM(&canvas->fb, x, y, icon_get_width(icon), icon_get_height(icon), icon_data);
+    uint8_t width = icon_get_width(icon);
+    uint8_t height = icon_get_height(icon);
+    const uint8_t* icon_data = canvas_icon_decode(canvas, icon_get_data(icon), width, height);
+    u8g2_DrawXBM(&canvas->fb, x, y, width, height, icon_data);
 }
 
 void canvas_draw_dot(Canvas* canvas, uint8_t x, uint8_t y) {
@@ -8,6 +8,49 @@
 #include "canvas.h"
 #include <u8g2.h>
 
+/** Decoded icon frames cache slots */
+#define CANVAS_ICON_CACHE_ITEMS 16
+/** Decoded icon frames cache memory budget, bytes. Full screen frame is 1K */
+#define CANVAS_ICON_CACHE_SIZE 4096
+
+/** Decoded icon frame. Icons are compiled in, so frame data pointer is the key
+ */
+typedef struct {
+    const uint8_t* data;
+    uint8_t* decoded;
+    uint16_t size;
+    uint32_t last_used;
+} CanvasIconCacheItem;
+
+/** Least recently used decoded icon frames
+ */
+typedef struct {
+    CanvasIconCacheItem items[CANVAS_ICON_CACHE_ITEMS];
+    size_t size;
+    uint32_t tick;
+    uint32_t hits;
+    uint32_t misses;
+} CanvasIconCache;
+
+/** Icon cache statistics
+ */
+typedef struct {
+    size_t items;
+    size_t size;
+    uint32_t hits;
+    uint32_t misses;
+} CanvasIconCacheStats;
+
+/** Display update statistics
+ */
+typedef struct {
+    uint8_t pages_sent; /**< Pages sent by the last commit */
+    uint8_t pages_total; /**< Pages in the frame */
+    uint32_t commits;
+    uint32_t commits_skipped; /**< Nothing changed, nothing sent */
+    uint32_t pages_sent_total;
+} CanvasCommitStats;
+
 /** Canvas structure
  */
 struct Canvas {
@@ -17,6 +60,10 @@ struct Canvas {
     uint8_t offset_y;
     uint8_t width;
     uint8_t height;
+    CanvasIconCache icon_cache;
+    uint8_t* sent_buffer; /**< What display shows, to find changed pages */
+    bool sent_valid;
+    CanvasCommitStats commit_stats;
 };
 
 /** Allocate memory and initialize canvas
@@ -37,12 +84,19 @@ void canvas_free(Canvas* canvas);
  */
 void canvas_reset(Canvas* canvas);
 
-/** Commit canvas. Send buffer to display
+/** Commit canvas. Send pages that changed since the last commit to display
  *
  * @param      canvas  Canvas instance
  */
 void canvas_commit(Canvas* canvas);
 
+/** Get display update statistics
+ *
+ * @param      canvas  Canvas instance
+ * @param      stats   CanvasCommitStats to fill
+ */
+void canvas_get_commit_stats(Canvas* canvas, CanvasCommitStats* stats);
+
 /** Get canvas buffer.
  *
  * @param      canvas  Canvas instance
@@ -88,3 +142,10 @@ void canvas_set_orientation(Canvas* canvas, CanvasOrientation orientation);
  * @return     CanvasOrientation
  */
 CanvasOrientation canvas_get_orientation(const Canvas* canvas);
+
+/** Get decoded icon cache statistics
+ *
+ * @param      canvas  Canvas instance
+ * @param      stats   CanvasIconCacheStats to fill
+ */
+void canvas_get_icon_cache_stats(Canvas* canvas, CanvasIconCacheStats* stats);
@@ -1,5 +1,6 @@
 #include "gui/canvas.h"
 #include "gui_i.h"
+#include "screen_stream_encoder.h"
 
 #define TAG "GuiSrv"
 
@@ -265,10 +266,39 @@ void gui_cli_screen_stream_callback(uint8_t* data, size_t size, void* context) {
     cli_write(gui->cli, data, size);
 }
 
+typedef struct {
+    Cli* cli;
+    ScreenStreamEncoder* encoder;
+} GuiCliScreenStreamDelta;
+
+void gui_cli_screen_stream_delta_callback(uint8_t* data, size_t size, void* context) {
+    furi_assert(data);
+    furi_assert(context);
+
+    GuiCliScreenStreamDelta* delta = context;
+    const uint8_t* packet;
+    size_t packet_size = screen_stream_encoder_encode(delta->encoder, data, &packet);
+    if(packet_size) {
+        const uint8_t magic[] = {0xF0, 0xE1, 0xD2, 0xC3};
+        cli_write(delta->cli, magic, sizeof(magic));
+        cli_write(delta->cli, packet, packet_size);
+    }
+}
+
 void gui_cli_screen_stream(Cli* cli, string_t args, void* context) {
     furi_assert(context);
     Gui* gui = context;
-    gui_set_framebuffer_callback(gui, gui_cli_screen_stream_callback, gui);
+    GuiCliScreenStreamDelta delta = {.cli = cli, .encoder = NULL};
+
+    if(string_empty_p(args)) {
+        gui_set_framebuffer_callback(gui, gui_cli_screen_stream_callback, gui);
+    } else if(string_cmp_str(args, "delta") == 0) {
+        delta.encoder = screen_stream_encoder_alloc(canvas_get_buffer_size(gui->canvas));
+        gui_set_framebuffer_callback(gui, gui_cli_screen_stream_delta_callback, &delta);
+    } else {
+        printf("Usage: screen_stream [delta]\r\n");
+        return;
+    }
     gui_redraw(gui);
 
     // Wait for control events
@@ -289,6 +319,40 @@ void gui_cli_screen_stream(Cli* cli, string_t args, void* context) {
     }
 
     gui_set_framebuffer_callback(gui, NULL, NULL);
+    if(delta.encoder) screen_stream_encoder_free(delta.encoder);
+}
+
+void gui_cli_icon_cache(Cli* cli, string_t args, void* context) {
+    furi_assert(context);
+    Gui* gui = context;
+    CanvasIconCacheStats stats;
+
+    gui_lock(gui);
+    canvas_get_icon_cache_stats(gui->canvas, &stats);
+    gui_unlock(gui);
+
+    uint32_t total = stats.hits + stats.misses;
+    printf("Icon cache items: %d of %d\r\n", stats.items, CANVAS_ICON_CACHE_ITEMS);
+    printf("Icon cache size: %d of %d\r\n", stats.size, CANVAS_ICON_CACHE_SIZE);
+    printf("Icon cache hits: %lu\r\n", stats.hits);
+    printf("Icon cache misses: %lu\r\n", stats.misses);
+    printf("Icon cache hit rate: %lu%%\r\n", total ? (uint32_t)(stats.hits * 100ULL / total) : 0);
+}
+
+void gui_cli_display_stats(Cli* cli, string_t args, void* context) {
+    furi_assert(context);
+    Gui* gui = context;
+    CanvasCommitStats stats;
+
+    gui_lock(gui);
+    canvas_get_commit_stats(gui->canvas, &stats);
+    gui_unlock(gui);
+
+    uint32_t pages_total = stats.commits * stats.pages_total;
+    printf("Last frame pages sent: %d of %d\r\n", stats.pages_sent, stats.pages_total);
+    printf("Frames: %lu\r\n", stats.commits);
+    printf("Frames unchanged: %lu\r\n", stats.commits_skipped);
+    printf("Pages sent: %lu of %lu\r\n", stats.pages_sent_total, pages_total);
 }
 
 void gui_add_view_port(Gui* gui, ViewPort* view_port, GuiLayer layer) {
@@ -425,6 +489,9 @@ Gui* gui_alloc() {
     gui->cli = furi_record_open("cli");
     cli_add_command(
         gui->cli, "screen_stream", CliCommandFlagParallelSafe, gui_cli_screen_stream, gui);
+    cli_add_command(gui->cli, "icon_cache", CliCommandFlagParallelSafe, gui_cli_icon_cache, gui);
+    cli_add_command(
+        gui->cli, "display_stats", CliCommandFlagParallelSafe, gui_cli_display_stats, gui);
 
     return gui;
 }
@@ -4,6 +4,8 @@
 #include <storage/storage.h>
 
 #define FILENAME_COUNT 4
+#define FILE_SELECT_PAGE 8
+#define FILE_SELECT_NAME_LENGTH 100
 
 struct FileSelect {
     // public
@@ -30,6 +32,17 @@ typedef struct {
 
 } FileSelectModel;
 
+/** Directory items a page at a time, storage keeps the listing between pages and calls */
+typedef struct {
+    FileInfo file_info[FILE_SELECT_PAGE];
+    char name[FILE_SELECT_PAGE][FILE_SELECT_NAME_LENGTH];
+    uint32_t offset; /**< Directory index of the first item in page */
+    uint32_t count;
+    uint32_t position;
+    bool end;
+    FS_Error error;
+} FileSelectReader;
+
 bool file_select_fill_strings(FileSelect* file_select);
 bool file_select_fill_count(FileSelect* file_select);
 static bool file_select_init_inner(FileSelect* file_select);
@@ -266,19 +279,53 @@ static bool filter_file(FileSelect* file_select, FileInfo* file_info, char* name
     return result;
 }
 
+static bool file_select_reader_next(
+    FileSelect* file_select,
+    FileSelectReader* reader,
+    FileInfo** file_info,
+    char** name) {
+    if(reader->position == reader->count) {
+        if(reader->end) return false;
+
+        reader->offset += reader->count;
+        reader->position = 0;
+        reader->error = storage_dir_read_page(
+            file_select->fs_api,
+            file_select->path,
+            reader->offset,
+            FILE_SELECT_PAGE,
+            reader->file_info,
+            &reader->name[0][0],
+            FILE_SELECT_NAME_LENGTH,
+            &reader->count);
+        if(reader->error != FSE_OK) reader->count = 0;
+        reader->end = (reader->count < FILE_SELECT_PAGE);
+        if(reader->count == 0) return false;
+    }
+
+    *file_info = &reader->file_info[reader->position];
+    *name = reader->name[reader->position];
+    reader->position++;
+    return true;
+}
+
+/** Directory that can't be opened is shown empty, read error in the middle is a failure */
+static bool file_select_reader_failed(FileSelectReader* reader) {
+    return reader->error != FSE_OK && reader->offset > 0;
+}
+
 bool file_select_fill_strings(FileSelect* file_select) {
     furi_assert(file_select);
     furi_assert(file_select->fs_api);
     furi_assert(file_select->path);
     furi_assert(file_select->extension);
 
-    FileInfo file_info;
-    File* directory = storage_file_alloc(file_select->fs_api);
+    FileSelectReader* reader = furi_alloc(sizeof(FileSelectReader));
+    FileInfo* file_info;
+    char* name;
 
     uint8_t string_counter = 0;
     uint16_t file_counter = 0;
-    const uint8_t name_length = 100;
-    char* name = furi_alloc(name_length);
     uint16_t first_file_index = 0;
 
     with_view_model(
@@ -287,52 +334,30 @@ bool file_select_fill_strings(FileSelect* file_select) {
             return false;
         });
 
-    if(!storage_dir_open(directory, file_select->path)) {
-        storage_dir_close(directory);
-        storage_file_free(directory);
-        free(name);
-        return true;
-    }
-
-    while(1) {
-        if(!storage_dir_read(directory, &file_info, name, name_length)) {
-            break;
-        }
-
-        if(storage_file_get_error(directory) == FSE_OK) {
-            if(filter_file(file_select, &file_info, name)) {
-                if(file_counter >= first_file_index) {
-                    with_view_model(
-                        file_select->view, (FileSelectModel * model) {
-                            string_set_str(model->filename[string_counter], name);
-
-                            if(strcmp(file_select->extension, "*") != 0) {
-                                string_replace_all_str(
-                                    model->filename[string_counter], file_select->extension, "");
-                            }
-
-                            return true;
-                        });
-                    string_counter++;
+    while(string_counter < FILENAME_COUNT &&
+          file_select_reader_next(file_select, reader, &file_info, &name)) {
+        if(filter_file(file_select, file_info, name)) {
+            if(file_counter >= first_file_index) {
+                with_view_model(
+                    file_select->view, (FileSelectModel * model) {
+                        string_set_str(model->filename[string_counter], name);
+
+                        if(strcmp(file_select->extension, "*") != 0) {
+                            string_replace_all_str(
+                                model->filename[string_counter], file_select->extension, "");
+                        }
 
-                    if(string_counter >= FILENAME_COUNT) {
-                        break;
-                    }
-                }
-                file_counter++;
+                        return true;
+                    });
+                string_counter++;
             }
-        } else {
-            storage_dir_close(directory);
-            storage_file_free(directory);
-            free(name);
-            return false;
+            file_counter++;
         }
     }
 
-    storage_dir_close(directory);
-    storage_file_free(directory);
-    free(name);
-    return true;
+    bool result = !file_select_reader_failed(reader);
+    free(reader);
+    return result;
 }
 
 bool file_select_fill_count(FileSelect* file_select) {
@@ -341,47 +366,28 @@ bool file_select_fill_count(FileSelect* file_select) {
     furi_assert(file_select->path);
     furi_assert(file_select->extension);
 
-    FileInfo file_info;
-    File* directory = storage_file_alloc(file_select->fs_api);
-
+    FileSelectReader* reader = furi_alloc(sizeof(FileSelectReader));
+    FileInfo* file_info;
+    char* name;
     uint16_t file_counter = 0;
-    const uint8_t name_length = 100;
-    char* name = furi_alloc(name_length);
 
-    if(!storage_dir_open(directory, file_select->path)) {
-        storage_dir_close(directory);
-        storage_file_free(directory);
-        free(name);
-        return true;
-    }
-
-    while(1) {
-        if(!storage_dir_read(directory, &file_info, name, name_length)) {
-            break;
-        }
-
-        if(storage_file_get_error(directory) == FSE_OK) {
-            if(filter_file(file_select, &file_info, name)) {
-                file_counter++;
-            }
-        } else {
-            storage_dir_close(directory);
-            storage_file_free(directory);
-            free(name);
-            return false;
+    while(file_select_reader_next(file_select, reader, &file_info, &name)) {
+        if(filter_file(file_select, file_info, name)) {
+            file_counter++;
         }
     }
 
-    with_view_model(
-        file_select->view, (FileSelectModel * model) {
-            model->file_count = file_counter;
-            return false;
-        });
+    bool result = !file_select_reader_failed(reader);
+    if(result) {
+        with_view_model(
+            file_select->view, (FileSelectModel * model) {
+                model->file_count = file_counter;
+                return false;
+            });
+    }
 
-    storage_dir_close(directory);
-    storage_file_free(directory);
-    free(name);
-    return true;
+    free(reader);
+    return result;
 }
 
 void file_select_set_selected_file_internal(FileSelect* file_select, const char* filename) {
@@ -393,11 +399,9 @@ void file_select_set_selected_file_internal(FileSelect* file_select, const char*
 
     if(strlen(filename) == 0) return;
 
-    FileInfo file_info;
-    File* directory = storage_file_alloc(file_select->fs_api);
-
-    const uint8_t name_length = 100;
-    char* name = furi_alloc(name_length);
+    FileSelectReader* reader = furi_alloc(sizeof(FileSelectReader));
+    FileInfo* file_info;
+    char* name;
     uint16_t file_position = 0;
     bool file_found = false;
 
@@ -407,34 +411,14 @@ void file_select_set_selected_file_internal(FileSelect* file_select, const char*
         string_cat_str(filename_str, file_select->extension);
     }
 
-    if(!storage_dir_open(directory, file_select->path)) {
-        string_clear(filename_str);
-        storage_dir_close(directory);
-        storage_file_free(directory);
-        free(name);
-        return;
-    }
-
-    while(1) {
-        if(!storage_dir_read(directory, &file_info, name, name_length)) {
-            break;
-        }
-
-        if(storage_file_get_error(directory) == FSE_OK) {
-            if(filter_file(file_select, &file_info, name)) {
-                if(strcmp(string_get_cstr(filename_str), name) == 0) {
-                    file_found = true;
-                    break;
-                }
-
-                file_position++;
+    while(file_select_reader_next(file_select, reader, &file_info, &name)) {
+        if(filter_file(file_select, file_info, name)) {
+            if(strcmp(string_get_cstr(filename_str), name) == 0) {
+                file_found = true;
+                break;
             }
-        } else {
-            string_clear(filename_str);
-            storage_dir_close(directory);
-            storage_file_free(directory);
-            free(name);
-            return;
+
+            file_position++;
         }
     }
 
@@ -461,9 +445,7 @@ void file_select_set_selected_file_internal(FileSelect* file_select, const char*
     }
 
     string_clear(filename_str);
-    storage_dir_close(directory);
-    storage_file_free(directory);
-    free(name);
+    free(reader);
 }
 
 void file_select_set_selected_file(FileSelect* file_select, const char* filename) {
@@ -0,0 +1,83 @@
+#include "screen_stream_encoder.h"
+
+#include <furi.h>
+#include <furi-hal-compress.h>
+
+#define SCREEN_STREAM_HEADER_SIZE 3
+/* heatshrink may expand data by 1/8 at worst, plus compression header */
+#define SCREEN_STREAM_PAYLOAD_SIZE(frame_size) ((frame_size) + (frame_size) / 8 + 16)
+
+struct ScreenStreamEncoder {
+    size_t frame_size;
+    uint8_t* previous;
+    uint8_t* delta;
+    uint8_t* packet;
+    FuriHalCompress* compress;
+    uint16_t since_key;
+    bool key_sent;
+};
+
+ScreenStreamEncoder* screen_stream_encoder_alloc(size_t frame_size) {
+    ScreenStreamEncoder* encoder = furi_alloc(sizeof(ScreenStreamEncoder));
+    encoder->frame_size = frame_size;
+    encoder->previous = furi_alloc(frame_size);
+    encoder->delta = furi_alloc(frame_size);
+    encoder->packet =
+        furi_alloc(SCREEN_STREAM_HEADER_SIZE + SCREEN_STREAM_PAYLOAD_SIZE(frame_size));
+    encoder->compress = furi_hal_compress_alloc(512);
+    return encoder;
+}
+
+void screen_stream_encoder_free(ScreenStreamEncoder* encoder) {
+    furi_assert(encoder);
+    furi_hal_compress_free(encoder->compress);
+    free(encoder->packet);
+    free(encoder->delta);
+    free(encoder->previous);
+    free(encoder);
+}
+
+size_t screen_stream_encoder_encode(
+    ScreenStreamEncoder* encoder,
+    const uint8_t* frame,
+    const uint8_t** packet) {
+    furi_assert(encoder);
+    furi_assert(frame);
+    furi_assert(packet);
+
+    if(encoder->key_sent && memcmp(frame, encoder->previous, encoder->frame_size) == 0) {
+        return 0;
+    }
+
+    ScreenStreamPacketType type = ScreenStreamPacketDelta;
+    uint8_t* data = encoder->delta;
+    if(!encoder->key_sent || encoder->since_key >= SCREEN_STREAM_KEY_INTERVAL) {
+        type = ScreenStreamPacketKey;
+        // Frame is copied there below
+        data = encoder->previous;
+        encoder->key_sent = true;
+        encoder->since_key = 0;
+    } else {
+        for(size_t i = 0; i < encoder->frame_size; i++) {
+            encoder->delta[i] = frame[i] ^ encoder->previous[i];
+        }
+        encoder->since_key++;
+    }
+    memcpy(encoder->previous, frame, encoder->frame_size);
+
+    size_t payload_size = 0;
+    bool result = furi_hal_compress_encode(
+        encoder->compress,
+        data,
+        encoder->frame_size,
+        &encoder->packet[SCREEN_STREAM_HEADER_SIZE],
+        SCREEN_STREAM_PAYLOAD_SIZE(encoder->frame_size),
+        &payload_size);
+    furi_check(result);
+
+    encoder->packet[0] = type;
+    encoder->packet[1] = payload_size & 0xFF;
+    encoder->packet[2] = payload_size >> 8;
+    *packet = encoder->packet;
+    return SCREEN_STREAM_HEADER_SIZE + payload_size;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file screen_stream_encoder.h
+ * GUI: delta encoder for screen streaming
+ *
+ * Packet is a type byte, payload size (uint16, little endian) and payload.
+ * Payload is furi_hal_compress_encode() output for the whole frame (key
+ * packet) or for frame XOR previous frame (delta packet).
+ * scripts/flipper/screen.py decodes it.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Send key packet after this many delta packets */
+#define SCREEN_STREAM_KEY_INTERVAL 64
+
+typedef enum {
+    ScreenStreamPacketKey = 0x00,
+    ScreenStreamPacketDelta = 0x01,
+} ScreenStreamPacketType;
+
+typedef struct ScreenStreamEncoder ScreenStreamEncoder;
+
+/** Allocate encoder, first packet is a key one
+ *
+ * @param      frame_size  frame size in bytes, canvas buffer size
+ *
+ * @return     ScreenStreamEncoder instance
+ */
+ScreenStreamEncoder* screen_stream_encoder_alloc(size_t frame_size);
+
+/** Free encoder
+ *
+ * @param      encoder  ScreenStreamEncoder instance
+ */
+void screen_stream_encoder_free(ScreenStreamEncoder* encoder);
+
+/** Encode frame
+ *
+ * @param      encoder  ScreenStreamEncoder instance
+ * @param      frame    frame, frame_size bytes
+ * @param      packet   pointer to encoded packet, valid till next call
+ *
+ * @return     packet size, 0 if frame didn't change and nothing is to be sent
+ */
+size_t screen_stream_encoder_encode(
+    ScreenStreamEncoder* encoder,
+    const uint8_t* frame,
+    const uint8_t** packet);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2,23 +2,94 @@
 #include "irda/irda-app-file-parser.h"
 
 #include <memory>
+#include <cstring>
 #include <m-string.h>
 #include <furi.h>
 #include <file-worker-cpp.h>
+#include <storage/storage.h>
+
+#define TAG "IrdaBruteForce"
 
 void IrdaAppBruteForce::add_record(int index, const char* name) {
     records[name].index = index;
     records[name].amount = 0;
+    records[name].offset = 0;
 }
 
-bool IrdaAppBruteForce::calculate_messages() {
-    bool fs_res = false;
-    furi_assert(!file_parser);
+bool IrdaAppBruteForce::get_db_size(uint64_t* db_size) {
+    Storage* storage = static_cast<Storage*>(furi_record_open("storage"));
+    FileInfo file_info;
+    bool result = (storage_common_stat(storage, universal_db_filename, &file_info) == FSE_OK);
+    furi_record_close("storage");
+
+    if(result) *db_size = file_info.size;
+    return result;
+}
+
+/* FNV-1a of database contents: catches edits which keep file size */
+bool IrdaAppBruteForce::get_db_checksum(uint32_t* db_checksum) {
+    Storage* storage = static_cast<Storage*>(furi_record_open("storage"));
+    File* file = storage_file_alloc(storage);
+    bool result = storage_file_open(file, universal_db_filename, FSAM_READ, FSOM_OPEN_EXISTING);
+
+    if(result) {
+        uint8_t buffer[256];
+        uint32_t checksum = 2166136261UL;
+        uint32_t bytes_read;
+        while((bytes_read = storage_file_read(file, buffer, sizeof(buffer))) > 0) {
+            for(uint32_t i = 0; i < bytes_read; ++i) {
+                checksum = (checksum ^ buffer[i]) * 16777619UL;
+            }
+        }
+        result = (storage_file_get_error(file) == FSE_OK);
+        *db_checksum = checksum;
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close("storage");
+    return result;
+}
+
+bool IrdaAppBruteForce::load_index(uint64_t db_size, uint32_t db_checksum) {
+    FileWorkerCpp index(true);
+    size_t records_found = 0;
+    bool result = false;
+
+    do {
+        if(!index.open(index_filename.c_str(), FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        IndexHeader header;
+        if(!index.read(&header, sizeof(header))) break;
+        if(header.magic != index_magic || header.version != index_version) break;
+        if(header.db_size != db_size || header.db_checksum != db_checksum) break;
+
+        IndexRecord index_record;
+        uint32_t i = 0;
+        for(; i < header.records_count; ++i) {
+            if(!index.read(&index_record, sizeof(index_record))) break;
+            index_record.name[sizeof(index_record.name) - 1] = '\0';
 
-    file_parser = std::make_unique<IrdaAppFileParser>();
-    fs_res = file_parser->open_irda_file_read(universal_db_filename);
-    if(!fs_res) {
-        file_parser.reset();
+            auto element = records.find(index_record.name);
+            if(element != records.end()) {
+                element->second.amount = index_record.amount;
+                element->second.offset = index_record.offset;
+                ++records_found;
+            }
+        }
+        if(i != header.records_count) break;
+
+        // Index built for other set of buttons
+        result = (records_found == records.size());
+    } while(0);
+
+    index.close();
+    return result;
+}
+
+bool IrdaAppBruteForce::count_records() {
+    auto file_parser = std::make_unique<IrdaAppFileParser>();
+    if(!file_parser->open_irda_file_read(universal_db_filename)) {
         return false;
     }
 
@@ -33,40 +104,163 @@ bool IrdaAppBruteForce::calculate_messages() {
     }
 
     file_parser->close();
-    file_parser.reset();
+    return true;
+}
+
+bool IrdaAppBruteForce::write_record_signals(FileWorkerCpp& index, const std::string& name) {
+    auto file_parser = std::make_unique<IrdaAppFileParser>();
+    if(!file_parser->open_irda_file_read(universal_db_filename)) {
+        return false;
+    }
+
+    bool result = true;
+    while(result) {
+        auto file_signal = file_parser->read_signal();
+        if(!file_signal) break;
+        if(name.compare(file_signal->name)) continue;
+
+        IndexSignal index_signal;
+        auto& signal = file_signal->signal;
+        if(signal.is_raw()) {
+            auto& raw = signal.get_raw_signal();
+            index_signal.message.protocol = IrdaProtocolUnknown;
+            index_signal.timings_cnt = raw.timings_cnt;
+            result = index.write(&index_signal, sizeof(index_signal)) &&
+                     index.write(raw.timings, raw.timings_cnt * sizeof(uint32_t));
+        } else {
+            index_signal.message = signal.get_message();
+            index_signal.timings_cnt = 0;
+            result = index.write(&index_signal, sizeof(index_signal));
+        }
+    }
+
+    file_parser->close();
+    return result;
+}
+
+bool IrdaAppBruteForce::write_index_header(FileWorkerCpp& index, const IndexHeader& header) {
+    if(!index.write(&header, sizeof(header))) return false;
+
+    IndexRecord index_record;
+    for(const auto& it : records) {
+        memset(&index_record, 0, sizeof(index_record));
+        strlcpy(index_record.name, it.first.c_str(), sizeof(index_record.name));
+        index_record.amount = it.second.amount;
+        index_record.offset = it.second.offset;
+        if(!index.write(&index_record, sizeof(index_record))) return false;
+    }
 
     return true;
 }
 
+bool IrdaAppBruteForce::build_index(uint64_t db_size, uint32_t db_checksum) {
+    if(!count_records()) return false;
+
+    FileWorkerCpp index(true);
+    IndexHeader header = {
+        .magic = index_magic,
+        .version = index_version,
+        .db_size = db_size,
+        .db_checksum = db_checksum,
+        .records_count = static_cast<uint32_t>(records.size()),
+    };
+    bool result = false;
+
+    do {
+        if(!index.open(index_filename.c_str(), FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+        // Record offsets are known only after signals are written, header is rewritten then
+        if(!write_index_header(index, header)) break;
+
+        uint64_t offset;
+        bool signals_written = index.tell(&offset);
+        for(auto& it : records) {
+            if(!signals_written) break;
+            it.second.offset = offset;
+            if(!it.second.amount) continue;
+            signals_written = write_record_signals(index, it.first) && index.tell(&offset);
+        }
+        if(!signals_written) break;
+
+        if(!index.seek(0, true)) break;
+        result = write_index_header(index, header);
+    } while(0);
+
+    index.close();
+    if(!result) {
+        FURI_LOG_E(TAG, "Can't build %s", index_filename.c_str());
+        index.remove(index_filename.c_str());
+    }
+
+    return result;
+}
+
+bool IrdaAppBruteForce::calculate_messages() {
+    uint64_t db_size;
+    uint32_t db_checksum;
+    if(!get_db_size(&db_size) || !get_db_checksum(&db_checksum)) {
+        return false;
+    }
+
+    for(auto& it : records) {
+        it.second.amount = 0;
+        it.second.offset = 0;
+    }
+
+    if(load_index(db_size, db_checksum)) {
+        return true;
+    }
+
+    for(auto& it : records) {
+        it.second.amount = 0;
+    }
+
+    FURI_LOG_I(TAG, "Building %s", index_filename.c_str());
+    return build_index(db_size, db_checksum);
+}
+
 void IrdaAppBruteForce::stop_bruteforce() {
     furi_assert((current_record.size()));
 
     if(current_record.size()) {
-        furi_assert(file_parser);
+        furi_assert(index_file);
         current_record.clear();
-        file_parser->close();
-        file_parser.reset();
+        index_file->close();
+        index_file.reset();
     }
 }
 
 bool IrdaAppBruteForce::send_next_bruteforce(void) {
     furi_assert(current_record.size());
-    furi_assert(file_parser);
+    furi_assert(index_file);
 
-    std::unique_ptr<IrdaAppFileParser::IrdaFileSignal> file_signal;
+    if(!signals_left) return false;
+    --signals_left;
 
-    do {
-        file_signal = file_parser->read_signal();
-    } while(file_signal && current_record.compare(file_signal->name));
+    IndexSignal index_signal;
+    if(!index_file->read(&index_signal, sizeof(index_signal))) return false;
 
-    if(file_signal) {
-        file_signal->signal.transmit();
+    IrdaAppSignal signal;
+    if(index_signal.message.protocol == IrdaProtocolUnknown) {
+        if(!index_signal.timings_cnt || (index_signal.timings_cnt > MAX_TIMINGS_AMOUNT)) {
+            return false;
+        }
+        uint32_t* timings = new uint32_t[index_signal.timings_cnt];
+        // signal owns timings from now on
+        signal.set_raw_signal(timings, index_signal.timings_cnt);
+        if(!index_file->read(timings, index_signal.timings_cnt * sizeof(uint32_t))) {
+            return false;
+        }
+    } else {
+        signal.set_message(&index_signal.message);
     }
-    return !!file_signal;
+
+    signal.transmit();
+    return true;
 }
 
 bool IrdaAppBruteForce::start_bruteforce(int index, int& record_amount) {
     bool result = false;
+    uint32_t offset = 0;
     record_amount = 0;
 
     for(const auto& it : records) {
@@ -74,16 +268,22 @@ bool IrdaAppBruteForce::start_bruteforce(int index, int& record_amount) {
             record_amount = it.second.amount;
             if(record_amount) {
                 current_record = it.first;
+                offset = it.second.offset;
             }
             break;
         }
     }
 
     if(record_amount) {
-        file_parser = std::make_unique<IrdaAppFileParser>();
-        result = file_parser->open_irda_file_read(universal_db_filename);
-        if(!result) {
-            file_parser.reset();
+        index_file = std::make_unique<FileWorkerCpp>();
+        result = index_file->open(index_filename.c_str(), FSAM_READ, FSOM_OPEN_EXISTING) &&
+                 index_file->seek(offset, true);
+        if(result) {
+            signals_left = record_amount;
+        } else {
+            index_file->close();
+            index_file.reset();
+            current_record.clear();
         }
     }
 
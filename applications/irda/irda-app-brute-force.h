@@ -5,14 +5,22 @@
 #include <unordered_map>
 #include <memory>
 
+/* Universal database is compiled into binary index next to it on first use:
+ * signals are pre-parsed and grouped by record name, so brute force only
+ * reads them one by one. Index is rebuilt when database size or checksum
+ * changes.
+ */
 class IrdaAppBruteForce {
     const char* universal_db_filename;
+    std::string index_filename;
     std::string current_record;
-    std::unique_ptr<IrdaAppFileParser> file_parser;
+    std::unique_ptr<FileWorkerCpp> index_file;
+    int signals_left = 0;
 
     typedef struct {
         int index;
         int amount;
+        uint32_t offset; /**< first signal of record in index file */
     } Record;
 
     // 'key' is record name, because we have to search by both, index and name,
@@ -22,6 +30,37 @@ class IrdaAppBruteForce {
     // more critical to have faster search by record name.
     std::unordered_map<std::string, Record> records;
 
+    typedef struct {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t db_size;
+        uint32_t db_checksum;
+        uint32_t records_count;
+    } IndexHeader;
+
+    typedef struct {
+        char name[32];
+        uint32_t amount;
+        uint32_t offset;
+    } IndexRecord;
+
+    /* followed by timings_cnt raw timings */
+    typedef struct {
+        IrdaMessage message; /**< protocol is IrdaProtocolUnknown for raw signal */
+        uint32_t timings_cnt;
+    } IndexSignal;
+
+    static inline const uint32_t index_magic = 0x58445249; /* "IRDX" */
+    static inline const uint32_t index_version = 2;
+
+    bool get_db_size(uint64_t* db_size);
+    bool get_db_checksum(uint32_t* db_checksum);
+    bool load_index(uint64_t db_size, uint32_t db_checksum);
+    bool build_index(uint64_t db_size, uint32_t db_checksum);
+    bool count_records();
+    bool write_record_signals(FileWorkerCpp& index, const std::string& name);
+    bool write_index_header(FileWorkerCpp& index, const IndexHeader& header);
+
 public:
     bool calculate_messages();
     void stop_bruteforce();
@@ -30,7 +69,8 @@ public:
     void add_record(int index, const char* name);
 
     IrdaAppBruteForce(const char* filename)
-        : universal_db_filename(filename) {
+        : universal_db_filename(filename)
+        , index_filename(std::string(filename) + ".idx") {
     }
     ~IrdaAppBruteForce() {
     }
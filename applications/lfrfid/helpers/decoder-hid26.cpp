@@ -1,4 +1,5 @@
 #include "decoder-hid26.h"
+#include <furi.h>
 #include <furi-hal.h>
 
 constexpr uint32_t clocks_in_us = 64;
@@ -85,6 +86,11 @@ void DecoderHID26::store_data(bool data) {
     stored_data[1] = (stored_data[1] << 1) | ((stored_data[2] >> 31) & 1);
     stored_data[2] = (stored_data[2] << 1) | data;
 
+    // Cheap rolling preamble check, full decode attempt only when preamble is in place
+    if((stored_data[0] >> 24) != 0x1D) {
+        return;
+    }
+
     if(hid.can_be_decoded(reinterpret_cast<const uint8_t*>(&stored_data), sizeof(uint32_t) * 3)) {
         ready = true;
     }
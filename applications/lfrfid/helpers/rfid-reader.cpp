@@ -6,20 +6,36 @@
 
 extern COMP_HandleTypeDef hcomp1;
 
+#define RFID_READER_DECODE_PERIOD 10
+#define RFID_READER_THREAD_EXIT (1 << 0)
+
 /**
  * @brief private violation assistant for RfidReader
  */
 struct RfidReaderAccessor {
-    static void decode(RfidReader& rfid_reader, bool polarity) {
-        rfid_reader.decode(polarity);
+    static void push_edge(RfidReader& rfid_reader, uint32_t timestamp, bool polarity) {
+        rfid_reader.push_edge(timestamp, polarity);
     }
 };
 
-void RfidReader::decode(bool polarity) {
-    uint32_t current_dwt_value = DWT->CYCCNT;
-    uint32_t period = current_dwt_value - last_dwt_value;
-    last_dwt_value = current_dwt_value;
+void RfidReader::push_edge(uint32_t timestamp, bool polarity) {
+    uint32_t head = edges_head.load(std::memory_order_relaxed);
+    uint32_t next = (head + 1) & (edges_size - 1);
+
+    if(next == edges_tail.load(std::memory_order_acquire)) {
+        furi_stats_counter_add(stats_dropped, 1);
+    } else {
+        edges[head] = (timestamp & ~1UL) | polarity;
+        edges_head.store(next, std::memory_order_release);
+    }
+
+    furi_stats_counter_add(stats_edges, 1);
+    detect_ticks++;
+
+    furi_stats_histogram_add(stats_isr, DWT->CYCCNT - timestamp);
+}
 
+void RfidReader::decode(bool polarity, uint32_t period) {
 #ifdef RFID_GPIO_DEBUG
     decoder_gpio_out.process_front(polarity, period);
 #endif
@@ -35,8 +51,40 @@ void RfidReader::decode(bool polarity) {
         decoder_indala.process_front(polarity, period);
         break;
     }
+}
 
-    detect_ticks++;
+void RfidReader::decode_edges() {
+    uint32_t tail = edges_tail.load(std::memory_order_relaxed);
+    uint32_t head = edges_head.load(std::memory_order_acquire);
+    if(tail == head) return;
+
+    uint32_t start = furi_stats_timer_start();
+    while(tail != head) {
+        uint32_t edge = edges[tail];
+        tail = (tail + 1) & (edges_size - 1);
+
+        uint32_t timestamp = edge & ~1UL;
+        decode(edge & 1, timestamp - last_dwt_value);
+        last_dwt_value = timestamp;
+    }
+    // Free the slots only now, ISR can't overwrite edges that are being decoded
+    edges_tail.store(tail, std::memory_order_release);
+
+    furi_stats_timer_stop(stats_decode, start);
+}
+
+int32_t RfidReader::decode_thread(void* context) {
+    RfidReader* _this = static_cast<RfidReader*>(context);
+
+    // Edges come at up to 125kHz, decoding them in batches is much cheaper than per edge
+    while(true) {
+        uint32_t flags = osThreadFlagsWait(
+            RFID_READER_THREAD_EXIT, osFlagsWaitAny, RFID_READER_DECODE_PERIOD);
+        _this->decode_edges();
+        if(!(flags & osFlagsError) && (flags & RFID_READER_THREAD_EXIT)) break;
+    }
+
+    return 0;
 }
 
 bool RfidReader::switch_timer_elapsed() {
@@ -68,17 +116,43 @@ static void comparator_trigger_callback(void* hcomp, void* comp_ctx) {
     RfidReader* _this = static_cast<RfidReader*>(comp_ctx);
 
     if(hcomp == &hcomp1) {
-        RfidReaderAccessor::decode(
-            *_this, (HAL_COMP_GetOutputLevel(_hcomp) == COMP_OUTPUT_LEVEL_HIGH));
+        uint32_t timestamp = DWT->CYCCNT;
+        RfidReaderAccessor::push_edge(
+            *_this, timestamp, (HAL_COMP_GetOutputLevel(_hcomp) == COMP_OUTPUT_LEVEL_HIGH));
     }
 }
 
 RfidReader::RfidReader() {
+    stats = furi_stats_group_alloc("lfrfid_reader");
+    stats_edges = furi_stats_counter_alloc(stats, "edges");
+    stats_dropped = furi_stats_counter_alloc(stats, "dropped");
+    for(uint8_t i = 0; i < COUNT_OF(stats_reads); i++) {
+        stats_reads[i] = furi_stats_counter_alloc(
+            stats, lfrfid_key_get_type_string(static_cast<LfrfidKeyType>(i)));
+    }
+    stats_isr = furi_stats_histogram_alloc(stats, "isr", "cyc");
+    stats_decode = furi_stats_histogram_alloc(stats, "decode_batch", "us");
+}
+
+RfidReader::~RfidReader() {
+    furi_stats_group_free(stats);
 }
 
 void RfidReader::start() {
     type = Type::Normal;
 
+    furi_stats_group_reset(stats);
+    edges = static_cast<uint32_t*>(furi_alloc(edges_size * sizeof(uint32_t)));
+    edges_head = 0;
+    edges_tail = 0;
+
+    thread = furi_thread_alloc();
+    furi_thread_set_name(thread, "RfidReaderWorker");
+    furi_thread_set_stack_size(thread, 1024);
+    furi_thread_set_context(thread, this);
+    furi_thread_set_callback(thread, decode_thread);
+    furi_thread_start(thread);
+
     furi_hal_rfid_pins_read();
     furi_hal_rfid_tim_read(125000, 0.5);
     furi_hal_rfid_tim_read_start();
@@ -100,6 +174,14 @@ void RfidReader::stop() {
     furi_hal_rfid_tim_read_stop();
     furi_hal_rfid_tim_reset();
     stop_comparator();
+
+    osThreadFlagsSet(furi_thread_get_thread_id(thread), RFID_READER_THREAD_EXIT);
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+    thread = nullptr;
+
+    free(edges);
+    edges = nullptr;
 }
 
 bool RfidReader::read(LfrfidKeyType* _type, uint8_t* data, uint8_t data_size, bool switch_enable) {
@@ -130,6 +212,7 @@ bool RfidReader::read(LfrfidKeyType* _type, uint8_t* data, uint8_t data_size, bo
             last_readed_count = last_readed_count + 1;
 
             if(last_readed_count > 2) {
+                furi_stats_counter_add(stats_reads[static_cast<uint8_t>(*_type)], 1);
                 result = true;
             }
         } else {
@@ -5,6 +5,8 @@
 #include "decoder-hid26.h"
 #include "decoder-indala.h"
 #include "key-info.h"
+#include <furi.h>
+#include <atomic>
 
 //#define RFID_GPIO_DEBUG 1
 
@@ -16,6 +18,7 @@ public:
     };
 
     RfidReader();
+    ~RfidReader();
     void start();
     void start_forced(RfidReader::Type type);
     void stop();
@@ -40,7 +43,26 @@ private:
     void start_comparator(void);
     void stop_comparator(void);
 
-    void decode(bool polarity);
+    // Comparator ISR only timestamps edges, bit 0 of timestamp holds polarity
+    static const uint32_t edges_size = 1024;
+    uint32_t* edges = nullptr;
+    std::atomic<uint32_t> edges_head;
+    std::atomic<uint32_t> edges_tail;
+    void push_edge(uint32_t timestamp, bool polarity);
+
+    // Decoders run in worker thread on batches of edges
+    FuriThread* thread = nullptr;
+    static int32_t decode_thread(void* context);
+    void decode_edges();
+    void decode(bool polarity, uint32_t period);
+
+    // Edge pipeline stats, "lfrfid_reader" group, reset on start
+    FuriStatsGroup* stats;
+    FuriStatsCounter* stats_edges;
+    FuriStatsCounter* stats_dropped;
+    FuriStatsCounter* stats_reads[3]; /**< Per LfrfidKeyType */
+    FuriStatsHistogram* stats_isr;
+    FuriStatsHistogram* stats_decode;
 
     uint32_t detect_ticks;
 
@@ -92,6 +92,8 @@ void lfrfid_cli_read(Cli* cli, string_t args) {
     printf("Reading stopped\r\n");
     reader.stop();
 
+    furi_stats_print("lfrfid_reader");
+
     string_clear(type_string);
 }
 
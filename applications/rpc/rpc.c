@@ -69,6 +69,8 @@ struct Rpc {
     StreamBufferHandle_t stream;
     RpcHandlerDict_t handlers;
     PB_Main* decoded_message;
+    uint8_t* encode_buffer;
+    size_t encode_buffer_size;
 };
 
 static bool content_callback(pb_istream_t* stream, const pb_field_t* field, void** arg);
@@ -370,6 +372,10 @@ static void rpc_free_session(RpcSession* session) {
     osMutexDelete(session->callbacks_mutex);
     RpcHandlerDict_reset(session->rpc->handlers);
 
+    free(session->rpc->encode_buffer);
+    session->rpc->encode_buffer = NULL;
+    session->rpc->encode_buffer_size = 0;
+
     session->context = NULL;
     session->closed_callback = NULL;
     session->send_bytes_callback = NULL;
@@ -481,36 +487,54 @@ bool rpc_pb_stream_read(pb_istream_t* istream, pb_byte_t* buf, size_t count) {
     return (count == bytes_received);
 }
 
-void rpc_send_and_release(Rpc* rpc, PB_Main* message) {
+/* Encode into session buffer, which grows to the biggest message sent so far.
+ * Encoding pass that doesn't fit is followed by sizing one, that's rare. */
+static size_t rpc_encode(Rpc* rpc, const PB_Main* message) {
+    pb_ostream_t ostream = pb_ostream_from_buffer(rpc->encode_buffer, rpc->encode_buffer_size);
+
+    if(!pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED)) {
+        pb_ostream_t sizing = PB_OSTREAM_SIZING;
+        bool result = pb_encode_ex(&sizing, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+        furi_check(result && sizing.bytes_written);
+
+        free(rpc->encode_buffer);
+        rpc->encode_buffer_size = sizing.bytes_written;
+        rpc->encode_buffer = furi_alloc(rpc->encode_buffer_size);
+
+        ostream = pb_ostream_from_buffer(rpc->encode_buffer, rpc->encode_buffer_size);
+        result = pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+        furi_check(result);
+    }
+
+    return ostream.bytes_written;
+}
+
+void rpc_send(Rpc* rpc, const PB_Main* message) {
     furi_assert(rpc);
     furi_assert(message);
     RpcSession* session = &rpc->session;
-    pb_ostream_t ostream = PB_OSTREAM_SIZING;
 
 #if SRV_RPC_DEBUG
     FURI_LOG_I(TAG, "OUTPUT:");
     rpc_print_message(message);
 #endif
 
-    bool result = pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
-    furi_check(result && ostream.bytes_written);
-
-    uint8_t* buffer = furi_alloc(ostream.bytes_written);
-    ostream = pb_ostream_from_buffer(buffer, ostream.bytes_written);
-
-    pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+    /* Also guards encode buffer: frames are sent from GUI thread */
+    osMutexAcquire(session->callbacks_mutex, osWaitForever);
+    if(session->send_bytes_callback) {
+        size_t size = rpc_encode(rpc, message);
 
 #if SRV_RPC_DEBUG
-    rpc_print_data("OUTPUT", buffer, ostream.bytes_written);
+        rpc_print_data("OUTPUT", rpc->encode_buffer, size);
 #endif
 
-    osMutexAcquire(session->callbacks_mutex, osWaitForever);
-    if(session->send_bytes_callback) {
-        session->send_bytes_callback(session->context, buffer, ostream.bytes_written);
+        session->send_bytes_callback(session->context, rpc->encode_buffer, size);
     }
     osMutexRelease(session->callbacks_mutex);
+}
 
-    free(buffer);
+void rpc_send_and_release(Rpc* rpc, PB_Main* message) {
+    rpc_send(rpc, message);
     pb_release(&PB_Main_msg, message);
 }
 
@@ -11,6 +11,7 @@ typedef struct {
     ViewPort* virtual_display_view_port;
     uint8_t* virtual_display_buffer;
     bool virtual_display_not_empty;
+    pb_bytes_array_t* screen_stream_frame;
 } RpcGuiSystem;
 
 void rpc_system_gui_screen_stream_frame_callback(uint8_t* data, size_t size, void* context) {
@@ -20,19 +21,19 @@ void rpc_system_gui_screen_stream_frame_callback(uint8_t* data, size_t size, voi
 
     RpcGuiSystem* rpc_gui = context;
 
-    PB_Main* frame = furi_alloc(sizeof(PB_Main));
+    // Frame bytes are reused, message lives on stack: no allocations per frame
+    rpc_gui->screen_stream_frame->size = size;
+    memcpy(rpc_gui->screen_stream_frame->bytes, data, size);
 
-    frame->which_content = PB_Main_gui_screen_frame_tag;
-    frame->command_status = PB_CommandStatus_OK;
-    frame->content.gui_screen_frame.data = furi_alloc(PB_BYTES_ARRAY_T_ALLOCSIZE(size));
-    uint8_t* buffer = frame->content.gui_screen_frame.data->bytes;
-    uint16_t* frame_size_msg = &frame->content.gui_screen_frame.data->size;
-    *frame_size_msg = size;
-    memcpy(buffer, data, size);
-
-    rpc_send_and_release(rpc_gui->rpc, frame);
+    PB_Main frame = {
+        .command_id = 0,
+        .command_status = PB_CommandStatus_OK,
+        .has_next = false,
+        .which_content = PB_Main_gui_screen_frame_tag,
+        .content.gui_screen_frame.data = rpc_gui->screen_stream_frame,
+    };
 
-    free(frame);
+    rpc_send(rpc_gui->rpc, &frame);
 }
 
 void rpc_system_gui_start_screen_stream_process(const PB_Main* request, void* context) {
@@ -42,6 +43,9 @@ void rpc_system_gui_start_screen_stream_process(const PB_Main* request, void* co
 
     rpc_send_and_release_empty(rpc_gui->rpc, request->command_id, PB_CommandStatus_OK);
 
+    if(!rpc_gui->screen_stream_frame) {
+        rpc_gui->screen_stream_frame = furi_alloc(PB_BYTES_ARRAY_T_ALLOCSIZE(1024));
+    }
     gui_set_framebuffer_callback(
         rpc_gui->gui, rpc_system_gui_screen_stream_frame_callback, context);
 }
@@ -52,6 +56,10 @@ void rpc_system_gui_stop_screen_stream_process(const PB_Main* request, void* con
     RpcGuiSystem* rpc_gui = context;
 
     gui_set_framebuffer_callback(rpc_gui->gui, NULL, NULL);
+    if(rpc_gui->screen_stream_frame) {
+        free(rpc_gui->screen_stream_frame);
+        rpc_gui->screen_stream_frame = NULL;
+    }
 
     rpc_send_and_release_empty(rpc_gui->rpc, request->command_id, PB_CommandStatus_OK);
 }
@@ -256,6 +264,9 @@ void rpc_system_gui_free(void* ctx) {
     }
 
     gui_set_framebuffer_callback(rpc_gui->gui, NULL, NULL);
+    if(rpc_gui->screen_stream_frame) {
+        free(rpc_gui->screen_stream_frame);
+    }
     furi_record_close("gui");
     free(rpc_gui);
 }
\ No newline at end of file
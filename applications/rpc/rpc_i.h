@@ -7,6 +7,9 @@
 #include <flipper.pb.h>
 #include <cli/cli.h>
 
+/** Storage read response payload, multiple of SD sector */
+#define RPC_STORAGE_READ_CHUNK_SIZE (2048)
+
 typedef void* (*RpcSystemAlloc)(Rpc*);
 typedef void (*RpcSystemFree)(void*);
 typedef void (*PBMessageHandler)(const PB_Main* msg_request, void* context);
@@ -17,6 +20,7 @@ typedef struct {
     void* context;
 } RpcHandler;
 
+void rpc_send(Rpc* rpc, const PB_Main* main_message);
 void rpc_send_and_release(Rpc* rpc, PB_Main* main_message);
 void rpc_send_and_release_empty(Rpc* rpc, uint32_t command_id, PB_CommandStatus status);
 void rpc_add_handler(Rpc* rpc, pb_size_t message_tag, RpcHandler* handler);
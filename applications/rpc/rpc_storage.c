@@ -2,6 +2,7 @@
 #include "furi/common_defines.h"
 #include "furi/memmgr.h"
 #include "furi/record.h"
+#include "furi/thread.h"
 #include "pb_decode.h"
 #include "rpc/rpc.h"
 #include "rpc_i.h"
@@ -13,19 +14,37 @@
 
 #define RPC_TAG "RPC_STORAGE"
 #define MAX_NAME_LENGTH 255
-#define MAX_DATA_SIZE 512
+#define RPC_STORAGE_READ_CHUNKS 2
 
 typedef enum {
     RpcStorageStateIdle = 0,
     RpcStorageStateWriting,
 } RpcStorageState;
 
+typedef enum {
+    RpcStorageReadEvtStart = (1 << 0),
+    RpcStorageReadEvtStop = (1 << 1),
+} RpcStorageReadEvt;
+
+#define RPC_STORAGE_READ_EVENTS_ALL (RpcStorageReadEvtStart | RpcStorageReadEvtStop)
+
+/** Read ahead: worker fills free chunks while RPC thread encodes and sends */
+typedef struct {
+    FuriThread* thread;
+    File* file;
+    uint32_t size_left;
+    pb_bytes_array_t* chunks[RPC_STORAGE_READ_CHUNKS];
+    osMessageQueueId_t free_queue;
+    osMessageQueueId_t read_queue;
+} RpcStorageRead;
+
 typedef struct {
     Rpc* rpc;
     Storage* api;
     File* file;
     RpcStorageState state;
     uint32_t current_command_id;
+    RpcStorageRead read;
 } RpcStorageSystem;
 
 void rpc_print_message(const PB_Main* message);
@@ -220,43 +239,91 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
     furi_record_close("storage");
 }
 
+static int32_t rpc_system_storage_read_worker(void* context) {
+    RpcStorageRead* read = context;
+
+    while(1) {
+        uint32_t events =
+            osThreadFlagsWait(RPC_STORAGE_READ_EVENTS_ALL, osFlagsWaitAny, osWaitForever);
+        if(events & RpcStorageReadEvtStop) break;
+
+        bool result = true;
+        while(result) {
+            pb_bytes_array_t* chunk;
+            furi_check(
+                osMessageQueueGet(read->free_queue, &chunk, NULL, osWaitForever) == osOK);
+
+            uint32_t read_size = MIN(read->size_left, RPC_STORAGE_READ_CHUNK_SIZE);
+            chunk->size = storage_file_read(read->file, chunk->bytes, read_size);
+            read->size_left -= read_size;
+            /* Short read is an error, RPC thread checks size too */
+            result = (chunk->size == read_size) && (read->size_left > 0);
+
+            furi_check(osMessageQueuePut(read->read_queue, &chunk, 0, osWaitForever) == osOK);
+        }
+    }
+
+    return 0;
+}
+
 static void rpc_system_storage_read_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(request->which_content == PB_Main_storage_read_request_tag);
 
     RpcStorageSystem* rpc_storage = context;
+    RpcStorageRead* read = &rpc_storage->read;
     rpc_system_storage_reset_state(rpc_storage, true);
 
-    /* use same message memory to send reponse */
-    PB_Main* response = furi_alloc(sizeof(PB_Main));
     const char* path = request->content.storage_read_request.path;
     Storage* fs_api = furi_record_open("storage");
     File* file = storage_file_alloc(fs_api);
     bool result = false;
 
     if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
-        size_t size_left = storage_file_size(file);
+        uint32_t size_left = storage_file_size(file);
+
+        read->file = file;
+        read->size_left = size_left;
+        for(size_t i = 0; i < RPC_STORAGE_READ_CHUNKS; i++) {
+            size_t chunk_size = MIN(size_left, RPC_STORAGE_READ_CHUNK_SIZE);
+            read->chunks[i] = furi_alloc(PB_BYTES_ARRAY_T_ALLOCSIZE(chunk_size));
+            osMessageQueuePut(read->free_queue, &read->chunks[i], 0, 0);
+        }
+        osThreadFlagsSet(furi_thread_get_thread_id(read->thread), RpcStorageReadEvtStart);
+
+        /* Same message for every chunk, payload isn't released after send */
+        PB_Main response = {
+            .command_id = request->command_id,
+            .command_status = PB_CommandStatus_OK,
+            .which_content = PB_Main_storage_read_response_tag,
+        };
+        response.content.storage_read_response.has_file = true;
+
         do {
-            response->command_id = request->command_id;
-            response->which_content = PB_Main_storage_read_response_tag;
-            response->command_status = PB_CommandStatus_OK;
-            response->content.storage_read_response.has_file = true;
-            response->content.storage_read_response.file.data =
-                furi_alloc(PB_BYTES_ARRAY_T_ALLOCSIZE(MIN(size_left, MAX_DATA_SIZE)));
-            uint8_t* buffer = response->content.storage_read_response.file.data->bytes;
-            uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
-
-            size_t read_size = MIN(size_left, MAX_DATA_SIZE);
-            *read_size_msg = storage_file_read(file, buffer, read_size);
+            pb_bytes_array_t* chunk;
+            furi_check(
+                osMessageQueueGet(read->read_queue, &chunk, NULL, osWaitForever) == osOK);
+
+            uint32_t read_size = MIN(size_left, RPC_STORAGE_READ_CHUNK_SIZE);
             size_left -= read_size;
-            result = (*read_size_msg == read_size);
+            result = (chunk->size == read_size);
 
             if(result) {
-                response->has_next = (size_left > 0);
-                rpc_send_and_release(rpc_storage->rpc, response);
+                response.has_next = (size_left > 0);
+                response.content.storage_read_response.file.data = chunk;
+                rpc_send(rpc_storage->rpc, &response);
             }
+
+            osMessageQueuePut(read->free_queue, &chunk, 0, 0);
         } while((size_left != 0) && result);
 
+        /* Worker is done with the last chunk it has put, take chunks back */
+        osMessageQueueReset(read->free_queue);
+        for(size_t i = 0; i < RPC_STORAGE_READ_CHUNKS; i++) {
+            free(read->chunks[i]);
+            read->chunks[i] = NULL;
+        }
+
         if(!result) {
             rpc_send_and_release_empty(
                 rpc_storage->rpc, request->command_id, rpc_system_storage_get_file_error(file));
@@ -266,7 +333,6 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
             rpc_storage->rpc, request->command_id, rpc_system_storage_get_file_error(file));
     }
 
-    free(response);
     storage_file_close(file);
     storage_file_free(file);
 
@@ -461,6 +527,16 @@ void* rpc_system_storage_alloc(Rpc* rpc) {
     rpc_storage->rpc = rpc;
     rpc_storage->state = RpcStorageStateIdle;
 
+    RpcStorageRead* read = &rpc_storage->read;
+    read->free_queue = osMessageQueueNew(RPC_STORAGE_READ_CHUNKS, sizeof(pb_bytes_array_t*), NULL);
+    read->read_queue = osMessageQueueNew(RPC_STORAGE_READ_CHUNKS, sizeof(pb_bytes_array_t*), NULL);
+    read->thread = furi_thread_alloc();
+    furi_thread_set_name(read->thread, "RpcStorageRead");
+    furi_thread_set_stack_size(read->thread, 1024);
+    furi_thread_set_context(read->thread, read);
+    furi_thread_set_callback(read->thread, rpc_system_storage_read_worker);
+    furi_thread_start(read->thread);
+
     RpcHandler rpc_handler = {
         .message_handler = NULL,
         .decode_submessage = NULL,
@@ -494,5 +570,11 @@ void* rpc_system_storage_alloc(Rpc* rpc) {
 void rpc_system_storage_free(void* ctx) {
     RpcStorageSystem* rpc_storage = ctx;
     rpc_system_storage_reset_state(rpc_storage, false);
+    osThreadFlagsSet(
+        furi_thread_get_thread_id(rpc_storage->read.thread), RpcStorageReadEvtStop);
+    furi_thread_join(rpc_storage->read.thread);
+    furi_thread_free(rpc_storage->read.thread);
+    osMessageQueueDelete(rpc_storage->read.free_queue);
+    osMessageQueueDelete(rpc_storage->read.read_queue);
     free(rpc_storage);
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <furi.h>
 #include "filesystem-api-defines.h"
+#include "storage-file-buffer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -12,6 +13,7 @@ struct File {
     FS_Error error_id; /**< Standart API error from FS_Error enum */
     int32_t internal_error_id; /**< Internal API error value */
     void* storage;
+    FileBuffer buffer; /**< Client side, storage thread doesn't use it */
 };
 
 /** File api structure
@@ -82,8 +84,8 @@ typedef struct {
         FS_AccessMode access_mode,
         FS_OpenMode open_mode);
     bool (*close)(void* context, File* file);
-    uint16_t (*read)(void* context, File* file, void* buff, uint16_t bytes_to_read);
-    uint16_t (*write)(void* context, File* file, const void* buff, uint16_t bytes_to_write);
+    uint32_t (*read)(void* context, File* file, void* buff, uint32_t bytes_to_read);
+    uint32_t (*write)(void* context, File* file, const void* buff, uint32_t bytes_to_write);
     bool (*seek)(void* context, File* file, uint32_t offset, bool from_start);
     uint64_t (*tell)(void* context, File* file);
     bool (*truncate)(void* context, File* file);
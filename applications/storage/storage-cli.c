@@ -66,6 +66,21 @@ static void storage_cli_info(Cli* cli, string_t path) {
                 sd_api_get_fs_type_text(sd_info.fs_type),
                 sd_info.kb_total,
                 sd_info.kb_free);
+
+            const SectorCacheStats* cache = &sd_info.cache;
+            uint32_t hit_rate = cache->reads ? cache->read_hits * 100ULL / cache->reads : 0;
+            printf(
+                "Cache: %lu sectors\r\n"
+                "Reads: %lu, %lu%% hits\r\n"
+                "Writes: %lu, %lu merged, %lu written back\r\n"
+                "Multi sector: %lu sectors\r\n",
+                cache->sectors,
+                cache->reads,
+                hit_rate,
+                cache->writes,
+                cache->writes_merged,
+                cache->write_backs,
+                cache->bypassed);
         }
     } else {
         storage_cli_print_usage();
@@ -0,0 +1,292 @@
+#include "storage-dir-cache.h"
+#include <m-string.h>
+#include <strings.h>
+
+#ifndef STORAGE_DIR_CACHE_DIRS
+#define STORAGE_DIR_CACHE_DIRS 2
+#endif
+
+/* Bigger directories are paged straight from the file system, see StorageDirCursor */
+#ifndef STORAGE_DIR_CACHE_ITEMS
+#define STORAGE_DIR_CACHE_ITEMS 256
+#endif
+
+/* Unused listing is freed after that many ticks, browsing is done by then */
+#define STORAGE_DIR_CACHE_LIFETIME 30000
+
+#define STORAGE_DIR_CACHE_ITEMS_INITIAL 16
+#define STORAGE_DIR_CACHE_NAMES_INITIAL 256
+
+typedef struct {
+    uint64_t size;
+    uint32_t name; /**< Offset in names */
+    uint8_t flags;
+} StorageDirCacheItem;
+
+struct StorageDirListing {
+    StorageData* storage; /**< NULL if slot is free */
+    string_t path;
+    bool complete;
+    uint32_t last_used;
+
+    StorageDirCacheItem* items;
+    size_t count;
+    size_t capacity;
+
+    char* names;
+    size_t names_size;
+    size_t names_capacity;
+};
+
+struct StorageDirCache {
+    StorageDirListing listings[STORAGE_DIR_CACHE_DIRS];
+};
+
+/** Path length without trailing slashes */
+static size_t storage_dir_cache_path_length(const char* path, size_t length) {
+    while(length > 0 && path[length - 1] == '/') length--;
+    return length;
+}
+
+/** Case insensitive, FAT doesn't care about case and key must match whatever the caller used */
+static bool storage_dir_cache_path_equal(string_t key, const char* path, size_t length) {
+    length = storage_dir_cache_path_length(path, length);
+    return string_size(key) == length && strncasecmp(string_get_cstr(key), path, length) == 0;
+}
+
+/** Key is a subdirectory of path at any depth */
+static bool storage_dir_cache_path_inside(string_t key, const char* path, size_t length) {
+    length = storage_dir_cache_path_length(path, length);
+    return string_size(key) > length && string_get_cstr(key)[length] == '/' &&
+           strncasecmp(string_get_cstr(key), path, length) == 0;
+}
+
+static StorageDirListing* storage_dir_cache_lookup(
+    StorageDirCache* cache,
+    StorageData* storage,
+    const char* path,
+    size_t length) {
+    for(size_t i = 0; i < STORAGE_DIR_CACHE_DIRS; i++) {
+        StorageDirListing* listing = &cache->listings[i];
+        if(listing->storage == storage && listing->complete &&
+           storage_dir_cache_path_equal(listing->path, path, length)) {
+            return listing;
+        }
+    }
+    return NULL;
+}
+
+static void storage_dir_cache_release(StorageDirListing* listing) {
+    free(listing->items);
+    free(listing->names);
+    listing->items = NULL;
+    listing->names = NULL;
+    listing->count = 0;
+    listing->capacity = 0;
+    listing->names_size = 0;
+    listing->names_capacity = 0;
+    listing->storage = NULL;
+    listing->complete = false;
+    string_reset(listing->path);
+}
+
+/** Parent path length, 0 for items in storage root */
+static size_t storage_dir_cache_parent_length(const char* path) {
+    size_t length = storage_dir_cache_path_length(path, strlen(path));
+    while(length > 0 && path[length - 1] != '/') length--;
+    return length > 0 ? length - 1 : 0;
+}
+
+StorageDirCache* storage_dir_cache_alloc() {
+    StorageDirCache* cache = furi_alloc(sizeof(StorageDirCache));
+    for(size_t i = 0; i < STORAGE_DIR_CACHE_DIRS; i++) {
+        string_init(cache->listings[i].path);
+    }
+    return cache;
+}
+
+void storage_dir_cache_free(StorageDirCache* cache) {
+    furi_assert(cache);
+    for(size_t i = 0; i < STORAGE_DIR_CACHE_DIRS; i++) {
+        storage_dir_cache_release(&cache->listings[i]);
+        string_clear(cache->listings[i].path);
+    }
+    free(cache);
+}
+
+StorageDirListing*
+    storage_dir_cache_find(StorageDirCache* cache, StorageData* storage, const char* path) {
+    furi_assert(cache);
+    StorageDirListing* listing = storage_dir_cache_lookup(cache, storage, path, strlen(path));
+    if(listing) listing->last_used = osKernelGetTickCount();
+    return listing;
+}
+
+StorageDirListing*
+    storage_dir_cache_begin(StorageDirCache* cache, StorageData* storage, const char* path) {
+    furi_assert(cache);
+    StorageDirListing* listing = &cache->listings[0];
+    for(size_t i = 0; i < STORAGE_DIR_CACHE_DIRS; i++) {
+        if(!cache->listings[i].storage) {
+            listing = &cache->listings[i];
+            break;
+        }
+        if(cache->listings[i].last_used - listing->last_used > INT32_MAX) {
+            listing = &cache->listings[i];
+        }
+    }
+
+    storage_dir_cache_release(listing);
+    listing->storage = storage;
+    listing->last_used = osKernelGetTickCount();
+    string_set_strn(listing->path, path, storage_dir_cache_path_length(path, strlen(path)));
+    return listing;
+}
+
+bool storage_dir_cache_push(
+    StorageDirCache* cache,
+    StorageDirListing* listing,
+    const FileInfo* fileinfo,
+    const char* name) {
+    furi_assert(cache);
+    furi_assert(listing);
+    size_t name_size = strlen(name) + 1;
+
+    if(listing->count == STORAGE_DIR_CACHE_ITEMS) {
+        storage_dir_cache_drop(cache, listing);
+        return false;
+    }
+
+    if(listing->count == listing->capacity) {
+        size_t capacity = listing->capacity ? listing->capacity * 2 :
+                                              STORAGE_DIR_CACHE_ITEMS_INITIAL;
+        capacity = MIN(capacity, (size_t)STORAGE_DIR_CACHE_ITEMS);
+        StorageDirCacheItem* items = malloc(capacity * sizeof(StorageDirCacheItem));
+        if(!items) {
+            storage_dir_cache_drop(cache, listing);
+            return false;
+        }
+        if(listing->items) memcpy(items, listing->items, listing->count * sizeof(*items));
+        free(listing->items);
+        listing->items = items;
+        listing->capacity = capacity;
+    }
+
+    if(listing->names_size + name_size > listing->names_capacity) {
+        size_t capacity = listing->names_capacity ? listing->names_capacity :
+                                                    STORAGE_DIR_CACHE_NAMES_INITIAL;
+        while(listing->names_size + name_size > capacity) capacity *= 2;
+        char* names = malloc(capacity);
+        if(!names) {
+            storage_dir_cache_drop(cache, listing);
+            return false;
+        }
+        if(listing->names) memcpy(names, listing->names, listing->names_size);
+        free(listing->names);
+        listing->names = names;
+        listing->names_capacity = capacity;
+    }
+
+    StorageDirCacheItem* item = &listing->items[listing->count++];
+    item->size = fileinfo->size;
+    item->flags = fileinfo->flags;
+    item->name = listing->names_size;
+    memcpy(&listing->names[listing->names_size], name, name_size);
+    listing->names_size += name_size;
+    return true;
+}
+
+void storage_dir_cache_commit(StorageDirCache* cache, StorageDirListing* listing) {
+    furi_assert(cache);
+    furi_assert(listing);
+    listing->complete = true;
+}
+
+void storage_dir_cache_drop(StorageDirCache* cache, StorageDirListing* listing) {
+    furi_assert(cache);
+    furi_assert(listing);
+    storage_dir_cache_release(listing);
+}
+
+size_t storage_dir_cache_count(StorageDirListing* listing) {
+    furi_assert(listing);
+    return listing->count;
+}
+
+const char* storage_dir_cache_get(StorageDirListing* listing, size_t index, FileInfo* fileinfo) {
+    furi_assert(listing);
+    furi_assert(index < listing->count);
+    StorageDirCacheItem* item = &listing->items[index];
+    if(fileinfo) {
+        fileinfo->size = item->size;
+        fileinfo->flags = item->flags;
+    }
+    return &listing->names[item->name];
+}
+
+void storage_dir_cache_invalidate(StorageDirCache* cache, StorageData* storage, const char* path) {
+    furi_assert(cache);
+    size_t length = strlen(path);
+    for(size_t i = 0; i < STORAGE_DIR_CACHE_DIRS; i++) {
+        StorageDirListing* listing = &cache->listings[i];
+        if(listing->storage == storage &&
+           (storage_dir_cache_path_equal(listing->path, path, length) ||
+            storage_dir_cache_path_inside(listing->path, path, length))) {
+            storage_dir_cache_release(listing);
+        }
+    }
+}
+
+void storage_dir_cache_invalidate_parent(
+    StorageDirCache* cache,
+    StorageData* storage,
+    const char* path) {
+    furi_assert(cache);
+    StorageDirListing* listing = storage_dir_cache_lookup(
+        cache, storage, path, storage_dir_cache_parent_length(path));
+    if(listing) storage_dir_cache_release(listing);
+}
+
+void storage_dir_cache_remove(StorageDirCache* cache, StorageData* storage, const char* path) {
+    furi_assert(cache);
+    size_t parent_length = storage_dir_cache_parent_length(path);
+    StorageDirListing* listing = storage_dir_cache_lookup(cache, storage, path, parent_length);
+    if(!listing) return;
+
+    // Rest of the listing keeps file system order, so only the item goes away
+    const char* name = path + parent_length;
+    if(*name == '/') name++;
+    size_t name_length = storage_dir_cache_path_length(name, strlen(name));
+    for(size_t i = 0; i < listing->count; i++) {
+        const char* item_name = &listing->names[listing->items[i].name];
+        if(strlen(item_name) == name_length && memcmp(item_name, name, name_length) == 0) {
+            listing->count--;
+            memmove(
+                &listing->items[i],
+                &listing->items[i + 1],
+                (listing->count - i) * sizeof(StorageDirCacheItem));
+            return;
+        }
+    }
+
+    // Name differs in case or item wasn't there, don't guess
+    storage_dir_cache_release(listing);
+}
+
+void storage_dir_cache_invalidate_storage(StorageDirCache* cache, StorageData* storage) {
+    furi_assert(cache);
+    for(size_t i = 0; i < STORAGE_DIR_CACHE_DIRS; i++) {
+        if(cache->listings[i].storage == storage) storage_dir_cache_release(&cache->listings[i]);
+    }
+}
+
+void storage_dir_cache_tick(StorageDirCache* cache) {
+    furi_assert(cache);
+    uint32_t now = osKernelGetTickCount();
+    for(size_t i = 0; i < STORAGE_DIR_CACHE_DIRS; i++) {
+        StorageDirListing* listing = &cache->listings[i];
+        if(listing->storage && now - listing->last_used > STORAGE_DIR_CACHE_LIFETIME) {
+            storage_dir_cache_release(listing);
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <furi.h>
+#include "storage-glue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Directory listings kept by the storage thread for storage_dir_read_page
+ *
+ * Listing is keyed by storage and path without vfs prefix, so /any and /ext share it.
+ * Processing drops or patches listings when it changes a directory,
+ * listings that weren't used for a while are freed on storage tick.
+ */
+typedef struct StorageDirCache StorageDirCache;
+
+typedef struct StorageDirListing StorageDirListing;
+
+StorageDirCache* storage_dir_cache_alloc();
+
+void storage_dir_cache_free(StorageDirCache* cache);
+
+/** Get complete listing
+ * @return listing or NULL if directory is not cached
+ */
+StorageDirListing*
+    storage_dir_cache_find(StorageDirCache* cache, StorageData* storage, const char* path);
+
+/** Start new listing, least recently used one is evicted if there is no free slot.
+ * Listing is not visible to find until storage_dir_cache_commit.
+ */
+StorageDirListing*
+    storage_dir_cache_begin(StorageDirCache* cache, StorageData* storage, const char* path);
+
+/** Add item to listing that was started with storage_dir_cache_begin
+ * @return false if listing is too big, listing is dropped then
+ */
+bool storage_dir_cache_push(
+    StorageDirCache* cache,
+    StorageDirListing* listing,
+    const FileInfo* fileinfo,
+    const char* name);
+
+/** Make listing visible to find */
+void storage_dir_cache_commit(StorageDirCache* cache, StorageDirListing* listing);
+
+/** Drop listing, e.g. because directory read failed */
+void storage_dir_cache_drop(StorageDirCache* cache, StorageDirListing* listing);
+
+size_t storage_dir_cache_count(StorageDirListing* listing);
+
+/** Get listing item
+ * @return item name
+ */
+const char* storage_dir_cache_get(StorageDirListing* listing, size_t index, FileInfo* fileinfo);
+
+/** Directory content changed, or directory was renamed or removed: drop its listing
+ * and listings of its subdirectories */
+void storage_dir_cache_invalidate(StorageDirCache* cache, StorageData* storage, const char* path);
+
+/** File or directory was created or modified, drop listing of its parent */
+void storage_dir_cache_invalidate_parent(
+    StorageDirCache* cache,
+    StorageData* storage,
+    const char* path);
+
+/** File or directory was removed, take it out of parent listing */
+void storage_dir_cache_remove(StorageDirCache* cache, StorageData* storage, const char* path);
+
+/** Drop all listings of the storage, for format, unmount and card change */
+void storage_dir_cache_invalidate_storage(StorageDirCache* cache, StorageData* storage);
+
+/** Free listings that weren't used for a while */
+void storage_dir_cache_tick(StorageDirCache* cache);
+
+#ifdef __cplusplus
+}
+#endif
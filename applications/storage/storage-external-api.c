@@ -3,6 +3,7 @@
 #include "storage.h"
 #include "storage-i.h"
 #include "storage-message.h"
+#include "storage-file-buffer.h"
 
 #define MAX_NAME_LENGTH 256
 
@@ -41,7 +42,7 @@
         }};
 
 #define S_RETURN_BOOL (return_data.bool_value);
-#define S_RETURN_UINT16 (return_data.uint16_value);
+#define S_RETURN_UINT32 (return_data.uint32_value);
 #define S_RETURN_UINT64 (return_data.uint64_value);
 #define S_RETURN_ERROR (return_data.error_value);
 #define S_RETURN_CSTRING (return_data.cstring_value);
@@ -51,44 +52,7 @@
 
 /****************** FILE ******************/
 
-bool storage_file_open(
-    File* file,
-    const char* path,
-    FS_AccessMode access_mode,
-    FS_OpenMode open_mode) {
-    S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
-
-    SAData data = {
-        .fopen = {
-            .file = file,
-            .path = path,
-            .access_mode = access_mode,
-            .open_mode = open_mode,
-        }};
-
-    file->file_id = FILE_OPENED;
-
-    S_API_MESSAGE(StorageCommandFileOpen);
-    S_API_EPILOGUE;
-
-    return S_RETURN_BOOL;
-}
-
-bool storage_file_close(File* file) {
-    S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
-
-    S_API_DATA_FILE;
-    S_API_MESSAGE(StorageCommandFileClose);
-    S_API_EPILOGUE;
-
-    file->file_id = FILE_CLOSED;
-
-    return S_RETURN_BOOL;
-}
-
-uint16_t storage_file_read(File* file, void* buff, uint16_t bytes_to_read) {
+uint32_t storage_file_read_internal(File* file, void* buff, uint32_t bytes_to_read) {
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
 
@@ -101,10 +65,10 @@ uint16_t storage_file_read(File* file, void* buff, uint16_t bytes_to_read) {
 
     S_API_MESSAGE(StorageCommandFileRead);
     S_API_EPILOGUE;
-    return S_RETURN_UINT16;
+    return S_RETURN_UINT32;
 }
 
-uint16_t storage_file_write(File* file, const void* buff, uint16_t bytes_to_write) {
+uint32_t storage_file_write_internal(File* file, const void* buff, uint32_t bytes_to_write) {
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
 
@@ -117,10 +81,10 @@ uint16_t storage_file_write(File* file, const void* buff, uint16_t bytes_to_writ
 
     S_API_MESSAGE(StorageCommandFileWrite);
     S_API_EPILOGUE;
-    return S_RETURN_UINT16;
+    return S_RETURN_UINT32;
 }
 
-bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+bool storage_file_seek_internal(File* file, uint32_t offset, bool from_start) {
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
 
@@ -136,7 +100,7 @@ bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
     return S_RETURN_BOOL;
 }
 
-uint64_t storage_file_tell(File* file) {
+uint64_t storage_file_tell_internal(File* file) {
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
     S_API_DATA_FILE;
@@ -145,7 +109,77 @@ uint64_t storage_file_tell(File* file) {
     return S_RETURN_UINT64;
 }
 
+bool storage_file_open(
+    File* file,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    S_FILE_API_PROLOGUE;
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .fopen = {
+            .file = file,
+            .path = path,
+            .access_mode = access_mode,
+            .open_mode = open_mode,
+        }};
+
+    file->file_id = FILE_OPENED;
+    memset(&file->buffer, 0, sizeof(FileBuffer));
+
+    S_API_MESSAGE(StorageCommandFileOpen);
+    S_API_EPILOGUE;
+
+    return S_RETURN_BOOL;
+}
+
+bool storage_file_close(File* file) {
+    // Close anyway, but report lost writes
+    bool flushed = storage_file_buffer_flush(&file->buffer, file);
+    memset(&file->buffer, 0, sizeof(FileBuffer));
+
+    S_FILE_API_PROLOGUE;
+    S_API_PROLOGUE;
+
+    S_API_DATA_FILE;
+    S_API_MESSAGE(StorageCommandFileClose);
+    S_API_EPILOGUE;
+
+    file->file_id = FILE_CLOSED;
+
+    bool result = S_RETURN_BOOL;
+    return result && flushed;
+}
+
+bool storage_file_set_buffer(File* file, void* buffer, uint32_t buffer_size) {
+    furi_assert(storage_file_is_open(file));
+    return storage_file_buffer_set(&file->buffer, file, buffer, buffer_size);
+}
+
+uint32_t storage_file_read(File* file, void* buff, uint32_t bytes_to_read) {
+    if(!file->buffer.data) return storage_file_read_internal(file, buff, bytes_to_read);
+    return storage_file_buffer_read(&file->buffer, file, buff, bytes_to_read);
+}
+
+uint32_t storage_file_write(File* file, const void* buff, uint32_t bytes_to_write) {
+    if(!file->buffer.data) return storage_file_write_internal(file, buff, bytes_to_write);
+    return storage_file_buffer_write(&file->buffer, file, buff, bytes_to_write);
+}
+
+bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+    if(!file->buffer.data) return storage_file_seek_internal(file, offset, from_start);
+    return storage_file_buffer_seek(&file->buffer, file, offset, from_start);
+}
+
+uint64_t storage_file_tell(File* file) {
+    if(!file->buffer.data) return storage_file_tell_internal(file);
+    return storage_file_buffer_tell(&file->buffer);
+}
+
 bool storage_file_truncate(File* file) {
+    if(!storage_file_buffer_release(&file->buffer, file)) return false;
+
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
     S_API_DATA_FILE;
@@ -155,6 +189,8 @@ bool storage_file_truncate(File* file) {
 }
 
 uint64_t storage_file_size(File* file) {
+    storage_file_buffer_flush(&file->buffer, file);
+
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
     S_API_DATA_FILE;
@@ -164,6 +200,8 @@ uint64_t storage_file_size(File* file) {
 }
 
 bool storage_file_sync(File* file) {
+    if(!storage_file_buffer_flush(&file->buffer, file)) return false;
+
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
     S_API_DATA_FILE;
@@ -173,6 +211,11 @@ bool storage_file_sync(File* file) {
 }
 
 bool storage_file_eof(File* file) {
+    if(file->buffer.data) {
+        if(storage_file_buffer_has_read_ahead(&file->buffer)) return false;
+        storage_file_buffer_flush(&file->buffer, file);
+    }
+
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
     S_API_DATA_FILE;
@@ -238,6 +281,126 @@ bool storage_dir_rewind(File* file) {
     return S_RETURN_BOOL;
 }
 
+FS_Error storage_dir_read_page(
+    Storage* storage,
+    const char* path,
+    uint32_t offset,
+    uint32_t count,
+    FileInfo* fileinfo,
+    char* names,
+    uint16_t name_length,
+    uint32_t* readed) {
+    furi_assert(!names || name_length);
+    furi_assert(readed);
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .dreadpage = {
+            .path = path,
+            .offset = offset,
+            .count = count,
+            .fileinfo = fileinfo,
+            .names = names,
+            .name_length = name_length,
+            .readed = readed,
+        }};
+
+    S_API_MESSAGE(StorageCommandDirReadPage);
+    S_API_EPILOGUE;
+    return S_RETURN_ERROR;
+}
+
+/****************** ASYNC ******************/
+
+static StorageAsyncRequest*
+    storage_async_request_alloc(File* file, StorageAsyncCallback callback, void* context) {
+    furi_assert(storage_file_is_open(file));
+    furi_assert(callback);
+    // Storage thread doesn't know about client side buffer
+    furi_assert(!file->buffer.data);
+
+    StorageAsyncRequest* request = furi_alloc(sizeof(StorageAsyncRequest));
+    request->file = file;
+    request->callback = callback;
+    request->context = context;
+    return request;
+}
+
+static void storage_async_request_send(StorageCommand command, StorageAsyncRequest* request) {
+    Storage* storage = request->file->storage;
+    furi_assert(storage);
+
+    StorageMessage message = {
+        .semaphore = NULL,
+        .command = command,
+        .data = &request->data,
+        .return_data = &request->return_data,
+        .async = request,
+    };
+
+    furi_check(osMessageQueuePut(storage->message_queue, &message, 0, osWaitForever) == osOK);
+}
+
+void storage_file_read_async(
+    File* file,
+    void* buff,
+    uint32_t bytes_to_read,
+    StorageAsyncCallback callback,
+    void* context) {
+    StorageAsyncRequest* request = storage_async_request_alloc(file, callback, context);
+    request->data.fread.file = file;
+    request->data.fread.buff = buff;
+    request->data.fread.bytes_to_read = bytes_to_read;
+    storage_async_request_send(StorageCommandFileRead, request);
+}
+
+void storage_file_write_async(
+    File* file,
+    const void* buff,
+    uint32_t bytes_to_write,
+    StorageAsyncCallback callback,
+    void* context) {
+    StorageAsyncRequest* request = storage_async_request_alloc(file, callback, context);
+    request->data.fwrite.file = file;
+    request->data.fwrite.buff = buff;
+    request->data.fwrite.bytes_to_write = bytes_to_write;
+    storage_async_request_send(StorageCommandFileWrite, request);
+}
+
+void storage_file_seek_async(
+    File* file,
+    uint32_t offset,
+    bool from_start,
+    StorageAsyncCallback callback,
+    void* context) {
+    StorageAsyncRequest* request = storage_async_request_alloc(file, callback, context);
+    request->data.fseek.file = file;
+    request->data.fseek.offset = offset;
+    request->data.fseek.from_start = from_start;
+    storage_async_request_send(StorageCommandFileSeek, request);
+}
+
+void storage_file_sync_async(File* file, StorageAsyncCallback callback, void* context) {
+    StorageAsyncRequest* request = storage_async_request_alloc(file, callback, context);
+    request->data.file.file = file;
+    storage_async_request_send(StorageCommandFileSync, request);
+}
+
+void storage_dir_read_async(
+    File* file,
+    FileInfo* fileinfo,
+    char* name,
+    uint16_t name_length,
+    StorageAsyncCallback callback,
+    void* context) {
+    StorageAsyncRequest* request = storage_async_request_alloc(file, callback, context);
+    request->data.dread.file = file;
+    request->data.dread.fileinfo = fileinfo;
+    request->data.dread.name = name;
+    request->data.dread.name_length = name_length;
+    storage_async_request_send(StorageCommandDirRead, request);
+}
+
 /****************** COMMON ******************/
 
 FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo) {
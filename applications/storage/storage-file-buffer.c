@@ -0,0 +1,129 @@
+#include "storage-file-buffer.h"
+
+bool storage_file_buffer_flush(FileBuffer* buffer, File* file) {
+    if(!buffer->dirty) return true;
+
+    uint32_t written = storage_file_write_internal(file, buffer->data, buffer->length);
+    bool result = (written == buffer->length);
+    buffer->offset += written;
+    buffer->length = 0;
+    buffer->position = 0;
+    buffer->dirty = false;
+    return result;
+}
+
+bool storage_file_buffer_release(FileBuffer* buffer, File* file) {
+    bool result = true;
+
+    if(buffer->dirty) {
+        result = storage_file_buffer_flush(buffer, file);
+    } else if(buffer->position != buffer->length) {
+        result = storage_file_seek_internal(file, buffer->offset + buffer->position, true);
+    }
+
+    buffer->offset += buffer->position;
+    buffer->length = 0;
+    buffer->position = 0;
+    return result;
+}
+
+bool storage_file_buffer_set(FileBuffer* buffer, File* file, void* data, uint32_t size) {
+    furi_assert(!data || size);
+
+    bool result = true;
+    if(buffer->data) {
+        result = storage_file_buffer_release(buffer, file);
+    } else {
+        buffer->offset = storage_file_tell_internal(file);
+    }
+
+    buffer->data = data;
+    buffer->size = size;
+    return result;
+}
+
+uint32_t
+    storage_file_buffer_read(FileBuffer* buffer, File* file, void* buff, uint32_t bytes_to_read) {
+    if(!storage_file_buffer_flush(buffer, file)) return 0;
+
+    uint32_t bytes_readed = 0;
+    while(bytes_readed < bytes_to_read) {
+        if(buffer->position == buffer->length) {
+            buffer->offset += buffer->length;
+            buffer->length = 0;
+            buffer->position = 0;
+
+            uint32_t bytes_left = bytes_to_read - bytes_readed;
+            if(bytes_left >= buffer->size) {
+                // Big enough to go straight into caller buffer
+                uint32_t readed =
+                    storage_file_read_internal(file, (uint8_t*)buff + bytes_readed, bytes_left);
+                buffer->offset += readed;
+                bytes_readed += readed;
+                break;
+            }
+
+            buffer->length = storage_file_read_internal(file, buffer->data, buffer->size);
+            if(buffer->length == 0) break;
+        }
+
+        uint32_t chunk = MIN(buffer->length - buffer->position, bytes_to_read - bytes_readed);
+        memcpy((uint8_t*)buff + bytes_readed, &buffer->data[buffer->position], chunk);
+        buffer->position += chunk;
+        bytes_readed += chunk;
+    }
+
+    return bytes_readed;
+}
+
+uint32_t storage_file_buffer_write(
+    FileBuffer* buffer,
+    File* file,
+    const void* buff,
+    uint32_t bytes_to_write) {
+    if(!buffer->dirty) {
+        if(!storage_file_buffer_release(buffer, file)) return 0;
+    } else if(buffer->length + bytes_to_write > buffer->size) {
+        if(!storage_file_buffer_flush(buffer, file)) return 0;
+    }
+
+    // Big enough to go straight from caller buffer
+    if(buffer->length == 0 && bytes_to_write >= buffer->size) {
+        uint32_t written = storage_file_write_internal(file, buff, bytes_to_write);
+        buffer->offset += written;
+        return written;
+    }
+
+    memcpy(&buffer->data[buffer->length], buff, bytes_to_write);
+    buffer->length += bytes_to_write;
+    buffer->position = buffer->length;
+    buffer->dirty = true;
+    return bytes_to_write;
+}
+
+bool storage_file_buffer_seek(FileBuffer* buffer, File* file, uint32_t offset, bool from_start) {
+    uint32_t position = from_start ? offset : buffer->offset + buffer->position + offset;
+    // Moving inside read ahead block
+    if(!buffer->dirty && position >= buffer->offset &&
+       position <= buffer->offset + buffer->length) {
+        buffer->position = position - buffer->offset;
+        return true;
+    }
+
+    bool result = storage_file_buffer_flush(buffer, file);
+    buffer->length = 0;
+    buffer->position = 0;
+    result = storage_file_seek_internal(file, position, true) && result;
+    // Storage may stop short of requested position, e.g. at the end of read only file
+    buffer->offset = storage_file_tell_internal(file);
+    return result;
+}
+
+uint64_t storage_file_buffer_tell(FileBuffer* buffer) {
+    return buffer->offset + buffer->position;
+}
+
+bool storage_file_buffer_has_read_ahead(FileBuffer* buffer) {
+    // Storage r/w pointer is at the end of read ahead block
+    return !buffer->dirty && buffer->position < buffer->length;
+}
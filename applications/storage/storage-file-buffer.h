@@ -0,0 +1,77 @@
+/**
+ * @file storage-file-buffer.h
+ * Client side buffering of file reads and writes, see storage_file_set_buffer
+ *
+ * Shared by storage API implementations: they keep FileBuffer in their File
+ * and provide unbuffered storage_file_*_internal operations below.
+ */
+
+#pragma once
+#include <furi.h>
+#include "filesystem-api-defines.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Caller supplied buffer for block reads and writes, see storage_file_set_buffer */
+typedef struct {
+    uint8_t* data; /**< Buffer, NULL if file is unbuffered */
+    uint32_t size; /**< Buffer capacity */
+    uint32_t offset; /**< File position of data[0] */
+    uint32_t length; /**< Valid bytes: read ahead, or written and not yet flushed */
+    uint32_t position; /**< r/w pointer inside data */
+    bool dirty; /**< data holds writes, storage r/w pointer is at offset */
+} FileBuffer;
+
+/** Unbuffered operations on storage r/w pointer, provided by storage API implementation */
+uint32_t storage_file_read_internal(File* file, void* buff, uint32_t bytes_to_read);
+uint32_t storage_file_write_internal(File* file, const void* buff, uint32_t bytes_to_write);
+bool storage_file_seek_internal(File* file, uint32_t offset, bool from_start);
+uint64_t storage_file_tell_internal(File* file);
+
+/** Sends buffered writes to storage
+ * @param buffer file buffer
+ * @param file file that owns buffer
+ * @return false if not all writes reached storage
+ */
+bool storage_file_buffer_flush(FileBuffer* buffer, File* file);
+
+/** Flushes writes or drops read ahead data, so storage r/w pointer matches file position
+ * @param buffer file buffer
+ * @param file file that owns buffer
+ * @return success flag
+ */
+bool storage_file_buffer_release(FileBuffer* buffer, File* file);
+
+/** Attaches data to buffer, releasing previous one
+ * @param buffer file buffer
+ * @param file open file that owns buffer
+ * @param data buffer memory, NULL to detach
+ * @param size buffer memory size
+ * @return success flag
+ */
+bool storage_file_buffer_set(FileBuffer* buffer, File* file, void* data, uint32_t size);
+
+/** Buffered versions of read, write, seek and tell, buffer data must be attached
+ * Semantics match storage_file_read, storage_file_write, storage_file_seek and storage_file_tell.
+ */
+uint32_t
+    storage_file_buffer_read(FileBuffer* buffer, File* file, void* buff, uint32_t bytes_to_read);
+uint32_t storage_file_buffer_write(
+    FileBuffer* buffer,
+    File* file,
+    const void* buff,
+    uint32_t bytes_to_write);
+bool storage_file_buffer_seek(FileBuffer* buffer, File* file, uint32_t offset, bool from_start);
+uint64_t storage_file_buffer_tell(FileBuffer* buffer);
+
+/** Checks that eof is decided by read ahead data, without asking storage
+ * @param buffer file buffer
+ * @return true if file position is inside read ahead data, so it is not at the end
+ */
+bool storage_file_buffer_has_read_ahead(FileBuffer* buffer);
+
+#ifdef __cplusplus
+}
+#endif
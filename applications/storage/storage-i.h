@@ -3,6 +3,7 @@
 #include <gui/gui.h>
 #include "storage-glue.h"
 #include "storage-sd-api.h"
+#include "storage-dir-cache.h"
 #include "filesystem-api-internal.h"
 
 #ifdef __cplusplus
@@ -16,12 +17,30 @@ typedef struct {
     bool enabled;
 } StorageSDGui;
 
+/* Directory cursor is closed after that many ticks without paged reads */
+#define STORAGE_DIR_CURSOR_LIFETIME 30000
+/* Cursor file id when no storage file is pushed for it */
+#define STORAGE_DIR_CURSOR_CLOSED 0
+
+/** Directory too big for cache, kept open between paged reads so next page
+ * continues where previous one ended instead of reading from the start
+ */
+typedef struct {
+    File file;
+    StorageData* storage; /**< NULL if closed */
+    string_t path;
+    uint32_t position; /**< Index of the next item */
+    uint32_t last_used;
+} StorageDirCursor;
+
 struct Storage {
     osMessageQueueId_t message_queue;
     StorageData storage[STORAGE_COUNT];
     StorageStatus prev_ext_storage_status;
     StorageSDGui sd_gui;
     FuriPubSub* pubsub;
+    StorageDirCache* dir_cache;
+    StorageDirCursor dir_cursor;
 };
 
 #ifdef __cplusplus
@@ -15,13 +15,13 @@ typedef struct {
 typedef struct {
     File* file;
     void* buff;
-    uint16_t bytes_to_read;
+    uint32_t bytes_to_read;
 } SADataFRead;
 
 typedef struct {
     File* file;
     const void* buff;
-    uint16_t bytes_to_write;
+    uint32_t bytes_to_write;
 } SADataFWrite;
 
 typedef struct {
@@ -42,6 +42,16 @@ typedef struct {
     uint16_t name_length;
 } SADataDRead;
 
+typedef struct {
+    const char* path;
+    uint32_t offset;
+    uint32_t count;
+    FileInfo* fileinfo;
+    char* names;
+    uint16_t name_length;
+    uint32_t* readed;
+} SADataDReadPage;
+
 typedef struct {
     const char* path;
     FileInfo* fileinfo;
@@ -82,6 +92,7 @@ typedef union {
 
     SADataDOpen dopen;
     SADataDRead dread;
+    SADataDReadPage dreadpage;
 
     SADataCStat cstat;
     SADataCPaths cpaths;
@@ -97,7 +108,7 @@ typedef union {
 
 typedef union {
     bool bool_value;
-    uint16_t uint16_value;
+    uint32_t uint32_value;
     uint64_t uint64_value;
     FS_Error error_value;
     const char* cstring_value;
@@ -118,6 +129,7 @@ typedef enum {
     StorageCommandDirClose,
     StorageCommandDirRead,
     StorageCommandDirRewind,
+    StorageCommandDirReadPage,
     StorageCommandCommonStat,
     StorageCommandCommonRemove,
     StorageCommandCommonRename,
@@ -130,11 +142,21 @@ typedef enum {
     StorageCommandSDStatus,
 } StorageCommand;
 
+/** Async request, owns its data until the storage thread calls back and frees it */
+typedef struct {
+    File* file;
+    SAData data;
+    SAReturn return_data;
+    StorageAsyncCallback callback;
+    void* context;
+} StorageAsyncRequest;
+
 typedef struct {
-    osSemaphoreId_t semaphore;
+    osSemaphoreId_t semaphore; /**< Released when done, NULL for async request */
     StorageCommand command;
     SAData* data;
     SAReturn* return_data;
+    StorageAsyncRequest* async; /**< NULL for blocking call */
 } StorageMessage;
 
 #ifdef __cplusplus
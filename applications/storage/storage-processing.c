@@ -46,6 +46,13 @@ const char* remove_vfs(const char* path) {
     return path + MIN(4, strlen(path));
 }
 
+/** File changed size, listing of its directory is out of date */
+static void storage_file_invalidate_parent(Storage* app, File* file, StorageData* storage) {
+    const StorageFile* storage_file = (const StorageFile*)file->file_id;
+    storage_dir_cache_invalidate_parent(
+        app->dir_cache, storage, remove_vfs(string_get_cstr(storage_file->path)));
+}
+
 /******************* File Functions *******************/
 
 bool storage_process_file_open(
@@ -68,6 +75,9 @@ bool storage_process_file_open(
         } else {
             storage_push_storage_file(file, path, type, storage);
             FS_CALL(storage, file.open(storage, file, remove_vfs(path), access_mode, open_mode));
+            if(access_mode & FSAM_WRITE) {
+                storage_dir_cache_invalidate_parent(app->dir_cache, storage, remove_vfs(path));
+            }
         }
     }
 
@@ -88,9 +98,9 @@ bool storage_process_file_close(Storage* app, File* file) {
     return ret;
 }
 
-static uint16_t
-    storage_process_file_read(Storage* app, File* file, void* buff, uint16_t const bytes_to_read) {
-    uint16_t ret = 0;
+static uint32_t
+    storage_process_file_read(Storage* app, File* file, void* buff, uint32_t const bytes_to_read) {
+    uint32_t ret = 0;
     StorageData* storage = get_storage_by_file(file, app->storage);
 
     if(storage == NULL) {
@@ -102,18 +112,19 @@ static uint16_t
     return ret;
 }
 
-static uint16_t storage_process_file_write(
+static uint32_t storage_process_file_write(
     Storage* app,
     File* file,
     const void* buff,
-    uint16_t const bytes_to_write) {
-    uint16_t ret = 0;
+    uint32_t const bytes_to_write) {
+    uint32_t ret = 0;
     StorageData* storage = get_storage_by_file(file, app->storage);
 
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
         FS_CALL(storage, file.write(storage, file, buff, bytes_to_write));
+        storage_file_invalidate_parent(app, file, storage);
     }
 
     return ret;
@@ -157,6 +168,7 @@ static bool storage_process_file_truncate(Storage* app, File* file) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
         FS_CALL(storage, file.truncate(storage, file));
+        storage_file_invalidate_parent(app, file, storage);
     }
 
     return ret;
@@ -269,6 +281,119 @@ bool storage_process_dir_rewind(Storage* app, File* file) {
     return ret;
 }
 
+/** Copies listing item to the page if it is inside the window */
+static void storage_process_dir_page_set(
+    const SADataDReadPage* page,
+    uint32_t index,
+    const FileInfo* fileinfo,
+    const char* name) {
+    if(index < page->offset || index - page->offset >= page->count) return;
+
+    uint32_t slot = index - page->offset;
+    if(page->fileinfo) page->fileinfo[slot] = *fileinfo;
+    if(page->names) strlcpy(&page->names[slot * page->name_length], name, page->name_length);
+    (*page->readed)++;
+}
+
+void storage_process_dir_cursor_close(Storage* app) {
+    StorageDirCursor* cursor = &app->dir_cursor;
+    if(cursor->storage) {
+        storage_process_dir_close(app, &cursor->file);
+        cursor->storage = NULL;
+        string_reset(cursor->path);
+    }
+    // Stale id may match storage file of another client later
+    cursor->file.file_id = STORAGE_DIR_CURSOR_CLOSED;
+}
+
+/** Reads the whole directory into cache. Directory that is too big is read
+ * up to the end of the window and left open, next page continues from there.
+ */
+static FS_Error storage_process_dir_read_fill(
+    Storage* app,
+    StorageData* storage,
+    const SADataDReadPage* page) {
+    StorageDirCursor* cursor = &app->dir_cursor;
+    FileInfo fileinfo;
+    char* name = malloc(STORAGE_DIR_NAME_LENGTH);
+    if(!name) return FSE_INTERNAL;
+
+    StorageDirListing* listing = NULL;
+    uint32_t index = 0;
+    FS_Error error = FSE_OK;
+
+    if(cursor->storage == storage && !string_cmp_str(cursor->path, page->path) &&
+       cursor->position <= page->offset) {
+        index = cursor->position;
+    } else {
+        storage_process_dir_cursor_close(app);
+        storage_process_dir_open(app, &cursor->file, page->path);
+        error = cursor->file.error_id;
+        // Handle is pushed even if file system failed to open it, then cursor closes it
+        if(cursor->file.file_id != STORAGE_DIR_CURSOR_CLOSED) {
+            cursor->storage = storage;
+            string_set_str(cursor->path, page->path);
+        }
+        if(error == FSE_OK) {
+            listing = storage_dir_cache_begin(app->dir_cache, storage, remove_vfs(page->path));
+        }
+    }
+
+    bool window_full = false;
+    if(error == FSE_OK) {
+        while(!window_full && storage_process_dir_read(
+                                  app, &cursor->file, &fileinfo, name, STORAGE_DIR_NAME_LENGTH)) {
+            if(listing && !storage_dir_cache_push(app->dir_cache, listing, &fileinfo, name)) {
+                listing = NULL;
+            }
+            storage_process_dir_page_set(page, index++, &fileinfo, name);
+            window_full = !listing && index >= page->offset + page->count;
+        }
+        // End of directory is reported as FSE_NOT_EXIST by read
+        if(!window_full && cursor->file.error_id != FSE_NOT_EXIST) {
+            error = cursor->file.error_id;
+        }
+    }
+
+    if(listing) {
+        if(error == FSE_OK) {
+            storage_dir_cache_commit(app->dir_cache, listing);
+        } else {
+            storage_dir_cache_drop(app->dir_cache, listing);
+        }
+    }
+
+    if(window_full && error == FSE_OK) {
+        cursor->position = index;
+        cursor->last_used = osKernelGetTickCount();
+    } else {
+        storage_process_dir_cursor_close(app);
+    }
+
+    free(name);
+    return error;
+}
+
+static FS_Error storage_process_dir_read_page(Storage* app, const SADataDReadPage* page) {
+    StorageType type = storage_get_type_by_path(page->path);
+    *page->readed = 0;
+    if(storage_type_is_not_valid(type)) return FSE_INVALID_NAME;
+
+    StorageData* storage = storage_get_storage_by_type(app, type);
+    StorageDirListing* listing =
+        storage_dir_cache_find(app->dir_cache, storage, remove_vfs(page->path));
+    if(!listing) return storage_process_dir_read_fill(app, storage, page);
+
+    FileInfo fileinfo;
+    size_t count = storage_dir_cache_count(listing);
+    for(uint32_t index = page->offset; index < count && *page->readed < page->count; index++) {
+        const char* name = storage_dir_cache_get(listing, index, &fileinfo);
+        storage_process_dir_page_set(page, index, &fileinfo, name);
+    }
+
+    return FSE_OK;
+}
+
 /******************* Common FS Functions *******************/
 
 static FS_Error storage_process_common_stat(Storage* app, const char* path, FileInfo* fileinfo) {
@@ -302,6 +427,10 @@ static FS_Error storage_process_common_remove(Storage* app, const char* path) {
         }
 
         FS_CALL(storage, common.remove(storage, remove_vfs(path)));
+        if(ret == FSE_OK) {
+            storage_dir_cache_invalidate(app->dir_cache, storage, remove_vfs(path));
+            storage_dir_cache_remove(app->dir_cache, storage, remove_vfs(path));
+        }
     } while(false);
 
     return ret;
@@ -316,6 +445,7 @@ static FS_Error storage_process_common_mkdir(Storage* app, const char* path) {
     } else {
         StorageData* storage = storage_get_storage_by_type(app, type);
         FS_CALL(storage, common.mkdir(storage, remove_vfs(path)));
+        storage_dir_cache_invalidate_parent(app->dir_cache, storage, remove_vfs(path));
     }
 
     return ret;
@@ -388,6 +518,11 @@ static FS_Error storage_process_common_rename(Storage* app, const char* old, con
         } else {
             StorageData* storage = storage_get_storage_by_type(app, type_old);
             FS_CALL(storage, common.rename(storage, remove_vfs(old), remove_vfs(new)));
+            if(ret == FSE_OK) {
+                storage_dir_cache_invalidate(app->dir_cache, storage, remove_vfs(old));
+                storage_dir_cache_remove(app->dir_cache, storage, remove_vfs(old));
+                storage_dir_cache_invalidate_parent(app->dir_cache, storage, remove_vfs(new));
+            }
         }
     }
 
@@ -423,6 +558,7 @@ static FS_Error storage_process_sd_format(Storage* app) {
         ret = FSE_NOT_READY;
     } else {
         ret = sd_format_card(&app->storage[ST_EXT]);
+        storage_dir_cache_invalidate_storage(app->dir_cache, &app->storage[ST_EXT]);
     }
 
     return ret;
@@ -435,6 +571,7 @@ static FS_Error storage_process_sd_unmount(Storage* app) {
         ret = FSE_NOT_READY;
     } else {
         sd_unmount_card(&app->storage[ST_EXT]);
+        storage_dir_cache_invalidate_storage(app->dir_cache, &app->storage[ST_EXT]);
     }
 
     return ret;
@@ -473,7 +610,30 @@ static FS_Error storage_process_sd_status(Storage* app) {
 
 /****************** API calls processing ******************/
 
+static void storage_process_async_complete(StorageMessage* message) {
+    StorageAsyncRequest* request = message->async;
+    uint32_t result;
+
+    switch(message->command) {
+    case StorageCommandFileRead:
+    case StorageCommandFileWrite:
+        result = request->return_data.uint32_value;
+        break;
+    default:
+        result = request->return_data.bool_value;
+        break;
+    }
+
+    request->callback(request->file, request->file->error_id, result, request->context);
+    free(request);
+}
+
 void storage_process_message(Storage* app, StorageMessage* message) {
+    // Directory kept open for paging may be changed or opened by any other command
+    if(message->command != StorageCommandDirReadPage) {
+        storage_process_dir_cursor_close(app);
+    }
+
     switch(message->command) {
     case StorageCommandFileOpen:
         message->return_data->bool_value = storage_process_file_open(
@@ -488,14 +648,14 @@ void storage_process_message(Storage* app, StorageMessage* message) {
             storage_process_file_close(app, message->data->fopen.file);
         break;
     case StorageCommandFileRead:
-        message->return_data->uint16_value = storage_process_file_read(
+        message->return_data->uint32_value = storage_process_file_read(
             app,
             message->data->fread.file,
             message->data->fread.buff,
             message->data->fread.bytes_to_read);
         break;
     case StorageCommandFileWrite:
-        message->return_data->uint16_value = storage_process_file_write(
+        message->return_data->uint32_value = storage_process_file_write(
             app,
             message->data->fwrite.file,
             message->data->fwrite.buff,
@@ -544,6 +704,10 @@ void storage_process_message(Storage* app, StorageMessage* message) {
             message->data->dread.name,
             message->data->dread.name_length);
         break;
+    case StorageCommandDirReadPage:
+        message->return_data->error_value =
+            storage_process_dir_read_page(app, &message->data->dreadpage);
+        break;
     case StorageCommandDirRewind:
         message->return_data->bool_value =
             storage_process_dir_rewind(app, message->data->file.file);
@@ -590,5 +754,9 @@ void storage_process_message(Storage* app, StorageMessage* message) {
         break;
     }
 
-    osSemaphoreRelease(message->semaphore);
+    if(message->async) {
+        storage_process_async_complete(message);
+    } else {
+        osSemaphoreRelease(message->semaphore);
+    }
 }
@@ -11,6 +11,9 @@ extern "C" {
 
 void storage_process_message(Storage* app, StorageMessage* message);
 
+/** Close directory kept open by paged reads */
+void storage_process_dir_cursor_close(Storage* app);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
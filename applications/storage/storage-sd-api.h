@@ -3,6 +3,7 @@
 #include "filesystem-api-defines.h"
 #include <fatfs.h>
 #include "storage-glue.h"
+#include <lib/toolbox/sector_cache.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -24,6 +25,7 @@ typedef struct {
     uint16_t cluster_size;
     uint16_t sector_size;
     char label[SD_LABEL_LENGTH];
+    SectorCacheStats cache;
     FS_Error error;
 } SDInfo;
 
@@ -8,6 +8,33 @@
 #define SEEK_OFFSET_FROM_START 10
 #define SEEK_OFFSET_INCREASE 12
 #define SEEK_OFFSET_SUM (SEEK_OFFSET_FROM_START + SEEK_OFFSET_INCREASE)
+#define SPEED_BUFFER_SIZE 4096
+#define SPEED_BLOCK_SIZE (16 * 1024)
+#define SPEED_ASYNC_DEPTH 4
+
+typedef struct {
+    const char* name;
+    uint32_t chunk_size;
+    bool buffered;
+    bool async;
+} SpeedTestMode;
+
+typedef struct {
+    osSemaphoreId_t done;
+    uint32_t chunk_size;
+    bool failed;
+} SpeedTestAsync;
+
+// Small chunks are what line parsers do, blocks are what file copy does.
+// Whole sector runs go to the disk driver as one multi-block transfer.
+static const SpeedTestMode speed_test_modes[] = {
+    {.name = "32 byte", .chunk_size = 32, .buffered = false},
+    {.name = "32 byte buffered", .chunk_size = 32, .buffered = true},
+    {.name = "sector", .chunk_size = 512, .buffered = false},
+    {.name = "4K block", .chunk_size = 4 * 1024, .buffered = false},
+    {.name = "block", .chunk_size = SPEED_BLOCK_SIZE, .buffered = false},
+    {.name = "4K block async", .chunk_size = 4 * 1024, .buffered = false, .async = true},
+};
 
 static void do_file_test(Storage* api, const char* path) {
     File* file = storage_file_alloc(api);
@@ -149,6 +176,128 @@ static void do_file_test(Storage* api, const char* path) {
     storage_file_free(file);
 }
 
+static uint32_t speed_test_kbps(uint32_t bytes, uint32_t ticks) {
+    if(ticks == 0) ticks = 1;
+    return (uint64_t)bytes * osKernelGetTickFreq() / 1024 / ticks;
+}
+
+static void speed_test_async_callback(File* file, FS_Error error, uint32_t result, void* context) {
+    SpeedTestAsync* async = context;
+    // Test sizes are multiples of chunk size, every request is a full chunk
+    if(error != FSE_OK || result != async->chunk_size) async->failed = true;
+    osSemaphoreRelease(async->done);
+}
+
+/* Keeps SPEED_ASYNC_DEPTH requests queued, so storage thread never waits for the caller */
+static bool speed_test_run_async(
+    File* file,
+    const SpeedTestMode* mode,
+    uint8_t* block,
+    uint32_t size,
+    bool write) {
+    SpeedTestAsync async = {
+        .done = osSemaphoreNew(SPEED_ASYNC_DEPTH, SPEED_ASYNC_DEPTH, NULL),
+        .chunk_size = mode->chunk_size,
+        .failed = false,
+    };
+    uint32_t sent = 0;
+    uint32_t slot = 0;
+
+    while(sent < size && !async.failed) {
+        osSemaphoreAcquire(async.done, osWaitForever);
+        // Reads land in their own slot, writes may share one
+        uint8_t* chunk = &block[(slot++ % SPEED_ASYNC_DEPTH) * mode->chunk_size];
+        if(write) {
+            storage_file_write_async(
+                file, chunk, mode->chunk_size, speed_test_async_callback, &async);
+        } else {
+            storage_file_read_async(
+                file, chunk, mode->chunk_size, speed_test_async_callback, &async);
+        }
+        sent += mode->chunk_size;
+    }
+
+    // Wait for outstanding requests
+    for(size_t i = 0; i < SPEED_ASYNC_DEPTH; i++) {
+        osSemaphoreAcquire(async.done, osWaitForever);
+    }
+    osSemaphoreDelete(async.done);
+    return !async.failed;
+}
+
+static bool speed_test_run(
+    File* file,
+    const SpeedTestMode* mode,
+    uint8_t* block,
+    uint8_t* buffer,
+    uint32_t size,
+    bool write) {
+    uint32_t done = 0;
+
+    if(mode->async) return speed_test_run_async(file, mode, block, size, write);
+    if(mode->buffered) storage_file_set_buffer(file, buffer, SPEED_BUFFER_SIZE);
+    while(done < size) {
+        uint32_t chunk = MIN(mode->chunk_size, size - done);
+        uint32_t result = write ? storage_file_write(file, block, chunk) :
+                                  storage_file_read(file, block, chunk);
+        if(result != chunk) break;
+        done += chunk;
+    }
+
+    return done == size;
+}
+
+static void do_speed_test(Storage* api, const char* path, uint32_t size) {
+    File* file = storage_file_alloc(api);
+    uint8_t* block = furi_alloc(SPEED_BLOCK_SIZE);
+    uint8_t* buffer = furi_alloc(SPEED_BUFFER_SIZE);
+    for(uint32_t i = 0; i < SPEED_BLOCK_SIZE; i++) block[i] = i;
+
+    FURI_LOG_I(TAG, "--------- SPEED \"%s\", %luk ---------", path, size / 1024);
+
+    for(size_t i = 0; i < COUNT_OF(speed_test_modes); i++) {
+        const SpeedTestMode* mode = &speed_test_modes[i];
+        uint32_t write_ticks = 0;
+        uint32_t read_ticks = 0;
+        uint32_t start;
+        bool result;
+
+        // write, close is included because buffered data is flushed there
+        start = osKernelGetTickCount();
+        result = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                 speed_test_run(file, mode, block, buffer, size, true);
+        result = storage_file_close(file) && result;
+        write_ticks = osKernelGetTickCount() - start;
+        if(!result) {
+            FURI_LOG_E(TAG, "%s write, %s", mode->name, storage_file_get_error_desc(file));
+            continue;
+        }
+
+        // read
+        start = osKernelGetTickCount();
+        result = storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+                 speed_test_run(file, mode, block, buffer, size, false);
+        storage_file_close(file);
+        read_ticks = osKernelGetTickCount() - start;
+        if(!result) {
+            FURI_LOG_E(TAG, "%s read, %s", mode->name, storage_file_get_error_desc(file));
+            continue;
+        }
+
+        FURI_LOG_I(
+            TAG,
+            "%s: write %lu KB/s, read %lu KB/s",
+            mode->name,
+            speed_test_kbps(size, write_ticks),
+            speed_test_kbps(size, read_ticks));
+    }
+
+    storage_common_remove(api, path);
+    free(buffer);
+    free(block);
+    storage_file_free(file);
+}
+
 static void do_dir_test(Storage* api, const char* path) {
     File* file = storage_file_alloc(api);
     bool result;
@@ -333,6 +482,12 @@ int32_t storage_test_app(void* p) {
     do_test_end(api, "/any");
     do_test_end(api, "/ext");
 
+    // Internal flash is small, SD gets a bigger file to average out card latency
+    do_speed_test(api, "/int/speed.bin", 16 * 1024);
+    do_speed_test(api, "/ext/speed.bin", 256 * 1024);
+    // Sequential, like big .sub/.ir/.nfc file copy
+    do_speed_test(api, "/ext/speed.bin", 1024 * 1024);
+
     while(true) {
         delay(1000);
     }
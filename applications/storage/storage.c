@@ -31,8 +31,13 @@ static void storage_app_sd_icon_draw_callback(Canvas* canvas, void* context) {
 
 Storage* storage_app_alloc() {
     Storage* app = malloc(sizeof(Storage));
-    app->message_queue = osMessageQueueNew(8, sizeof(StorageMessage), NULL);
+    // Async requests don't wait for each other, so queue holds several per client
+    app->message_queue = osMessageQueueNew(16, sizeof(StorageMessage), NULL);
     app->pubsub = furi_pubsub_alloc();
+    app->dir_cache = storage_dir_cache_alloc();
+    app->dir_cursor.storage = NULL;
+    app->dir_cursor.file.file_id = STORAGE_DIR_CURSOR_CLOSED;
+    string_init(app->dir_cursor.path);
 
     for(uint8_t i = 0; i < STORAGE_COUNT; i++) {
         storage_data_init(&app->storage[i]);
@@ -63,8 +68,17 @@ void storage_tick(Storage* app) {
         }
     }
 
+    storage_dir_cache_tick(app->dir_cache);
+    if(app->dir_cursor.storage &&
+       osKernelGetTickCount() - app->dir_cursor.last_used > STORAGE_DIR_CURSOR_LIFETIME) {
+        storage_process_dir_cursor_close(app);
+    }
+
     if(app->storage[ST_EXT].status != app->prev_ext_storage_status) {
         app->prev_ext_storage_status = app->storage[ST_EXT].status;
+        // Card was removed or replaced
+        storage_process_dir_cursor_close(app);
+        storage_dir_cache_invalidate_storage(app->dir_cache, &app->storage[ST_EXT]);
         furi_pubsub_publish(app->pubsub, &app->storage[ST_EXT].status);
     }
 
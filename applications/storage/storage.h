@@ -51,17 +51,29 @@ bool storage_file_is_open(File* file);
  * @param file pointer to file object.
  * @param buff pointer to a buffer, for reading
  * @param bytes_to_read how many bytes to read. Must be less than or equal to the size of the buffer.
- * @return uint16_t how many bytes were actually readed
+ * @return uint32_t how many bytes were actually readed
  */
-uint16_t storage_file_read(File* file, void* buff, uint16_t bytes_to_read);
+uint32_t storage_file_read(File* file, void* buff, uint32_t bytes_to_read);
 
 /** Writes bytes from a buffer to a file
  * @param file pointer to file object.
  * @param buff pointer to buffer, for writing
  * @param bytes_to_write how many bytes to write. Must be less than or equal to the size of the buffer.
- * @return uint16_t how many bytes were actually written
+ * @return uint32_t how many bytes were actually written
  */
-uint16_t storage_file_write(File* file, const void* buff, uint16_t bytes_to_write);
+uint32_t storage_file_write(File* file, const void* buff, uint32_t bytes_to_write);
+
+/** Attaches a buffer to the file, so small reads and writes don't go to the storage thread one by one.
+ * Reads are served from blocks read ahead into the buffer, writes are collected and sent as one block.
+ * Seek and tell inside the buffered block are handled without storage thread.
+ * Reads and writes bigger than the buffer go straight to storage.
+ * Buffer is flushed by sync, truncate, size, close and by detaching, and stays attached until the file is closed.
+ * @param file pointer to file object, must be open
+ * @param buffer pointer to buffer, NULL to flush and detach current one
+ * @param buffer_size buffer size
+ * @return bool success flag, false if pending writes couldn't be flushed
+ */
+bool storage_file_set_buffer(File* file, void* buffer, uint32_t buffer_size);
 
 /** Moves the r/w pointer 
  * @param file pointer to file object.
@@ -132,6 +144,119 @@ bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_
  */
 bool storage_dir_rewind(File* file);
 
+/** Name buffer length that fits any name storage can return, terminator included */
+#define STORAGE_DIR_NAME_LENGTH 256
+
+/** Reads a window of directory items, for browsers that show only part of a directory.
+ * Storage keeps recent listings and drops them when the directory is changed through the api,
+ * so scrolling and coming back to the directory don't go to the file system again.
+ * Directory too big to keep is read in order: request pages by increasing offset,
+ * a page behind the previous one makes storage read the directory from the start.
+ * Items come in the same order as from storage_dir_read.
+ * @param storage pointer to the api
+ * @param path directory path
+ * @param offset index of the first item to read
+ * @param count how many items to read
+ * @param fileinfo array of count FileInfo, may be NULL
+ * @param names count name buffers of name_length bytes each, one after another, may be NULL
+ * @param name_length length of one name buffer, names are truncated to fit
+ * @param readed how many items were actually readed, less than count at the end of the directory
+ * @return FS_Error operation result
+ */
+FS_Error storage_dir_read_page(
+    Storage* storage,
+    const char* path,
+    uint32_t offset,
+    uint32_t count,
+    FileInfo* fileinfo,
+    char* names,
+    uint16_t name_length,
+    uint32_t* readed);
+
+/******************* Async Functions *******************/
+
+/** Async request completion callback.
+ * Called from the storage thread, so keep it short: set an event flag or put a message into the app queue.
+ * @param file pointer to file object the request was made for
+ * @param error request result, what storage_file_get_error would return after the blocking call
+ * @param result bytes readed or written for read and write, 1 on success and 0 on failure for others
+ * @param context callback context
+ */
+typedef void (*StorageAsyncCallback)(File* file, FS_Error error, uint32_t result, void* context);
+
+/* Async functions queue the request and return without waiting for the storage thread.
+ * Requests are processed in the order they were made, blocking calls included,
+ * so several requests for the same file can be outstanding at once.
+ * Buffers must stay valid until the callback is called.
+ * File must be open and must not have a buffer attached with storage_file_set_buffer.
+ * Blocking close waits for all requests made before it.
+ */
+
+/** Reads bytes from a file into a buffer, without waiting
+ * @param file pointer to file object.
+ * @param buff pointer to a buffer, for reading
+ * @param bytes_to_read how many bytes to read
+ * @param callback completion callback
+ * @param context callback context
+ */
+void storage_file_read_async(
+    File* file,
+    void* buff,
+    uint32_t bytes_to_read,
+    StorageAsyncCallback callback,
+    void* context);
+
+/** Writes bytes from a buffer to a file, without waiting
+ * @param file pointer to file object.
+ * @param buff pointer to buffer, for writing
+ * @param bytes_to_write how many bytes to write
+ * @param callback completion callback
+ * @param context callback context
+ */
+void storage_file_write_async(
+    File* file,
+    const void* buff,
+    uint32_t bytes_to_write,
+    StorageAsyncCallback callback,
+    void* context);
+
+/** Moves the r/w pointer, without waiting
+ * @param file pointer to file object.
+ * @param offset offset to move the r/w pointer
+ * @param from_start set an offset from the start or from the current position
+ * @param callback completion callback
+ * @param context callback context
+ */
+void storage_file_seek_async(
+    File* file,
+    uint32_t offset,
+    bool from_start,
+    StorageAsyncCallback callback,
+    void* context);
+
+/** Writes file cache to storage, without waiting
+ * @param file pointer to file object.
+ * @param callback completion callback
+ * @param context callback context
+ */
+void storage_file_sync_async(File* file, StorageAsyncCallback callback, void* context);
+
+/** Reads the next object in the directory, without waiting
+ * @param file pointer to file object.
+ * @param fileinfo pointer to the readed FileInfo, may be NULL
+ * @param name pointer to name buffer, may be NULL
+ * @param name_length name buffer length
+ * @param callback completion callback, error is FSE_NOT_EXIST after the last object
+ * @param context callback context
+ */
+void storage_dir_read_async(
+    File* file,
+    FileInfo* fileinfo,
+    char* name,
+    uint16_t name_length,
+    StorageAsyncCallback callback,
+    void* context);
+
 /******************* Common Functions *******************/
 
 /** Retrieves information about a file/directory
@@ -4,6 +4,7 @@
 #include <furi-hal.h>
 #include "sd-notify.h"
 #include <furi-hal-sd.h>
+#include <lib/toolbox/sector_cache.h>
 
 typedef FIL SDFile;
 typedef DIR SDDir;
@@ -12,6 +13,12 @@ typedef FRESULT SDError;
 
 #define TAG "StorageExt"
 #define STORAGE_PATH "/ext"
+// Biggest sector aligned length that fits FatFs UINT
+#define STORAGE_EXT_CHUNK_SIZE (UINT16_MAX & ~(_MIN_SS - 1))
+// Sector cache size, FAT and directory sectors of a typical walk fit in
+#ifndef STORAGE_EXT_CACHE_SECTORS
+#define STORAGE_EXT_CACHE_SECTORS 8
+#endif
 /********************* Definitions ********************/
 
 typedef struct {
@@ -22,6 +29,55 @@ typedef struct {
 
 static FS_Error storage_ext_parse_error(SDError error);
 
+/******************* Disk Driver *******************/
+
+// FatFs driver has no context, there is only one SD card anyway
+static SectorCache* storage_ext_cache = NULL;
+
+static bool
+    storage_ext_cache_disk_read(void* context, uint8_t* data, uint32_t sector, uint32_t count) {
+    return USER_Driver.disk_read(0, data, sector, count) == RES_OK;
+}
+
+static bool storage_ext_cache_disk_write(
+    void* context,
+    const uint8_t* data,
+    uint32_t sector,
+    uint32_t count) {
+    return USER_Driver.disk_write(0, data, sector, count) == RES_OK;
+}
+
+static DSTATUS storage_ext_driver_initialize(BYTE pdrv) {
+    return USER_Driver.disk_initialize(pdrv);
+}
+
+static DSTATUS storage_ext_driver_status(BYTE pdrv) {
+    return USER_Driver.disk_status(pdrv);
+}
+
+static DRESULT storage_ext_driver_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count) {
+    return sector_cache_read(storage_ext_cache, buff, sector, count) ? RES_OK : RES_ERROR;
+}
+
+static DRESULT storage_ext_driver_write(BYTE pdrv, const BYTE* buff, DWORD sector, UINT count) {
+    return sector_cache_write(storage_ext_cache, buff, sector, count) ? RES_OK : RES_ERROR;
+}
+
+static DRESULT storage_ext_driver_ioctl(BYTE pdrv, BYTE cmd, void* buff) {
+    // FatFs syncs on f_sync, f_close and f_mkfs
+    if(cmd == CTRL_SYNC && !sector_cache_flush(storage_ext_cache)) return RES_ERROR;
+    return USER_Driver.disk_ioctl(pdrv, cmd, buff);
+}
+
+// Goes between FatFs and SD driver
+static const Diskio_drvTypeDef storage_ext_driver = {
+    storage_ext_driver_initialize,
+    storage_ext_driver_status,
+    storage_ext_driver_read,
+    storage_ext_driver_write,
+    storage_ext_driver_ioctl,
+};
+
 /******************* Core Functions *******************/
 
 static bool sd_mount_card(StorageData* storage, bool notify) {
@@ -51,6 +107,8 @@ static bool sd_mount_card(StorageData* storage, bool notify) {
             // bsp error
             storage->status = StorageStatusErrorInternal;
         } else {
+            // Could be another card
+            sector_cache_invalidate(storage_ext_cache);
             SDError status = f_mount(sd_data->fs, sd_data->path, 1);
 
             if(status == FR_OK || status == FR_NO_FILESYSTEM) {
@@ -104,6 +162,12 @@ FS_Error sd_unmount_card(StorageData* storage) {
 
     // TODO do i need to close the files?
 
+    // Fails if card is already removed, nothing to do about it
+    if(!sector_cache_flush(storage_ext_cache)) {
+        FURI_LOG_E(TAG, "cache flush failed");
+    }
+    sector_cache_invalidate(storage_ext_cache);
+
     f_mount(0, sd_data->path, 0);
     storage_data_unlock(storage);
     return storage_ext_parse_error(error);
@@ -172,6 +236,8 @@ FS_Error sd_card_info(StorageData* storage, SDInfo* sd_info) {
         sd_info->sector_size = sector_size;
     }
 
+    sector_cache_get_stats(storage_ext_cache, &sd_info->cache);
+
     return storage_ext_parse_error(error);
 }
 
@@ -294,27 +360,46 @@ static bool storage_ext_file_close(void* ctx, File* file) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
     file->internal_error_id = f_close(file_data);
+    // f_close syncs modified files only, write back whatever is left anyway
+    if(file->internal_error_id == FR_OK && !sector_cache_flush(storage_ext_cache)) {
+        file->internal_error_id = FR_DISK_ERR;
+    }
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     free(file_data);
     return (file->error_id == FSE_OK);
 }
 
-static uint16_t
-    storage_ext_file_read(void* ctx, File* file, void* buff, uint16_t const bytes_to_read) {
+static uint32_t
+    storage_ext_file_read(void* ctx, File* file, void* buff, uint32_t const bytes_to_read) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
-    uint16_t bytes_readed = 0;
-    file->internal_error_id = f_read(file_data, buff, bytes_to_read, &bytes_readed);
+    uint32_t bytes_readed = 0;
+    UINT chunk_readed = 0;
+    // FatFs length is 16 bit wide, chunks are sector aligned for direct multi sector reads
+    do {
+        UINT chunk = MIN(bytes_to_read - bytes_readed, (uint32_t)STORAGE_EXT_CHUNK_SIZE);
+        file->internal_error_id =
+            f_read(file_data, (uint8_t*)buff + bytes_readed, chunk, &chunk_readed);
+        bytes_readed += chunk_readed;
+        if(chunk_readed < chunk) break;
+    } while(file->internal_error_id == FR_OK && bytes_readed < bytes_to_read);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return bytes_readed;
 }
 
-static uint16_t
-    storage_ext_file_write(void* ctx, File* file, const void* buff, uint16_t const bytes_to_write) {
+static uint32_t
+    storage_ext_file_write(void* ctx, File* file, const void* buff, uint32_t const bytes_to_write) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
-    uint16_t bytes_written = 0;
-    file->internal_error_id = f_write(file_data, buff, bytes_to_write, &bytes_written);
+    uint32_t bytes_written = 0;
+    UINT chunk_written = 0;
+    do {
+        UINT chunk = MIN(bytes_to_write - bytes_written, (uint32_t)STORAGE_EXT_CHUNK_SIZE);
+        file->internal_error_id =
+            f_write(file_data, (const uint8_t*)buff + bytes_written, chunk, &chunk_written);
+        bytes_written += chunk_written;
+        if(chunk_written < chunk) break;
+    } while(file->internal_error_id == FR_OK && bytes_written < bytes_to_write);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return bytes_written;
 }
@@ -360,6 +445,9 @@ static bool storage_ext_file_sync(void* ctx, File* file) {
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
     file->internal_error_id = f_sync(file_data);
+    if(file->internal_error_id == FR_OK && !sector_cache_flush(storage_ext_cache)) {
+        file->internal_error_id = FR_DISK_ERR;
+    }
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return (file->error_id == FSE_OK);
 }
@@ -517,6 +605,15 @@ void storage_ext_init(StorageData* storage) {
     sd_data->path = "0:/";
     sd_data->sd_was_present = true;
 
+    storage_ext_cache = sector_cache_alloc(
+        STORAGE_EXT_CACHE_SECTORS,
+        _MAX_SS,
+        storage_ext_cache_disk_read,
+        storage_ext_cache_disk_write,
+        NULL);
+    FATFS_UnLinkDriver(USERPath);
+    FATFS_LinkDriver(&storage_ext_driver, USERPath);
+
     storage->data = sd_data;
     storage->api.tick = storage_ext_tick;
     storage->fs_api.file.open = storage_ext_file_open;
@@ -412,6 +412,157 @@ static bool test_read_multikey(const char* file_name) {
     return result;
 }
 
+static bool test_write_random_access(const char* file_name) {
+    Storage* storage = furi_record_open("storage");
+    bool result = false;
+    FlipperFile* file = flipper_file_alloc(storage);
+
+    do {
+        if(!flipper_file_open_always(file, file_name)) break;
+        if(!flipper_file_write_header_cstr(file, test_filetype, test_version)) break;
+        if(!flipper_file_write_string_cstr(file, test_string_key, test_string_data)) break;
+
+        bool error = false;
+        for(int32_t index = 0; index < 100; index++) {
+            int32_t data[] = {index, -index};
+            if(!flipper_file_write_comment_cstr(file, "Data: with delimiter")) error = true;
+            if(!flipper_file_write_int32(file, test_int_key, data, COUNT_OF(data))) error = true;
+            if(error) break;
+        }
+        if(error) break;
+
+        if(!flipper_file_write_uint32(
+               file, test_uint_key, test_uint_data, COUNT_OF(test_uint_data)))
+            break;
+
+        result = true;
+    } while(false);
+
+    flipper_file_close(file);
+    flipper_file_free(file);
+    furi_record_close("storage");
+
+    return result;
+}
+
+static bool test_read_random_access(const char* file_name) {
+    Storage* storage = furi_record_open("storage");
+    bool result = false;
+    FlipperFile* file = flipper_file_alloc(storage);
+
+    string_t string_value;
+    string_init(string_value);
+    uint32_t uint32_value;
+    uint32_t uint32_data[COUNT_OF(test_uint_data)];
+    int32_t int32_data[2];
+
+    do {
+        if(!flipper_file_open_existing(file, file_name)) break;
+
+        // Last key first, then keys before it
+        if(!flipper_file_read_uint32(file, test_uint_key, uint32_data, COUNT_OF(uint32_data)))
+            break;
+        if(memcmp(uint32_data, test_uint_data, sizeof(test_uint_data)) != 0) break;
+        if(flipper_file_read_string(file, test_string_key, string_value)) break;
+        if(!flipper_file_rewind(file)) break;
+        if(flipper_file_read_string(file, "Missing key", string_value)) break;
+        if(!flipper_file_read_string(file, test_string_key, string_value)) break;
+        if(string_cmp_str(string_value, test_string_data) != 0) break;
+
+        // Header after the key that follows it
+        if(!flipper_file_rewind(file)) break;
+        if(!flipper_file_read_header(file, string_value, &uint32_value)) break;
+        if(string_cmp_str(string_value, test_filetype) != 0) break;
+        if(uint32_value != test_version) break;
+
+        // Repeated key, one line at a time
+        bool error = false;
+        for(int32_t index = 0; index < 100; index++) {
+            if(!flipper_file_get_value_count(file, test_int_key, &uint32_value) ||
+               uint32_value != COUNT_OF(int32_data) ||
+               !flipper_file_read_int32(file, test_int_key, int32_data, uint32_value) ||
+               int32_data[0] != index || int32_data[1] != -index) {
+                error = true;
+                break;
+            }
+        }
+        if(error) break;
+        if(flipper_file_read_int32(file, test_int_key, int32_data, COUNT_OF(int32_data))) break;
+
+        if(!flipper_file_rewind(file)) break;
+        if(!flipper_file_read_int32(file, test_int_key, int32_data, COUNT_OF(int32_data))) break;
+        if(int32_data[0] != 0) break;
+
+        result = true;
+    } while(false);
+
+    string_clear(string_value);
+    flipper_file_close(file);
+    flipper_file_free(file);
+    furi_record_close("storage");
+
+    return result;
+}
+
+static bool test_int32_chunks(const char* file_name) {
+    Storage* storage = furi_record_open("storage");
+    bool result = false;
+    FlipperFile* file = flipper_file_alloc(storage);
+
+    const uint16_t line_size = 300;
+    const uint16_t chunk_size = 7;
+    int32_t* line = malloc(sizeof(int32_t) * line_size);
+    int32_t* data = malloc(sizeof(int32_t) * line_size);
+    for(uint16_t i = 0; i < line_size; i++) {
+        line[i] = (i % 2 ? -1 : 1) * (int32_t)(i * 7919);
+    }
+    line[0] = INT32_MIN;
+    line[1] = INT32_MAX;
+    uint32_t uint32_value;
+    uint16_t count;
+
+    do {
+        if(!flipper_file_open_always(file, file_name)) break;
+        if(!flipper_file_write_header_cstr(file, test_filetype, test_version)) break;
+        if(!flipper_file_write_int32(file, test_int_key, line, line_size)) break;
+        if(!flipper_file_write_int32(file, test_int_key, line, chunk_size)) break;
+
+        // Whole line
+        if(!flipper_file_rewind(file)) break;
+        if(!flipper_file_get_value_count(file, test_int_key, &uint32_value)) break;
+        if(uint32_value != line_size) break;
+        if(!flipper_file_read_int32(file, test_int_key, data, line_size)) break;
+        if(memcmp(data, line, sizeof(int32_t) * line_size) != 0) break;
+
+        // Same lines in chunks, second one is exactly one chunk
+        if(!flipper_file_rewind(file)) break;
+        bool error = false;
+        uint16_t total = 0;
+        while(!error && total < line_size + chunk_size) {
+            int32_t* chunk = &data[total % line_size];
+            if(!flipper_file_read_int32_chunk(file, test_int_key, chunk, chunk_size, &count) ||
+               count == 0) {
+                error = true;
+            } else if(memcmp(chunk, &line[total % line_size], sizeof(int32_t) * count) != 0) {
+                error = true;
+            }
+            total += count;
+        }
+        if(error || total != line_size + chunk_size) break;
+        if(flipper_file_read_int32_chunk(file, test_int_key, data, chunk_size, &count)) break;
+
+        result = true;
+    } while(false);
+
+    free(data);
+    free(line);
+    flipper_file_close(file);
+    flipper_file_free(file);
+    furi_record_close("storage");
+
+    return result;
+}
+
 MU_TEST(flipper_file_write_test) {
     mu_assert(storage_write_string(test_file_linux, test_data_nix), "Write test error [Linux]");
     mu_assert(
@@ -478,6 +629,17 @@ MU_TEST(flipper_file_multikey_test) {
     mu_assert(test_read_multikey(TEST_DIR "ff_multiline.test"), "Multikey read test error");
 }
 
+MU_TEST(flipper_file_random_access_test) {
+    mu_assert(
+        test_write_random_access(TEST_DIR "ff_random.test"), "Random access write test error");
+    mu_assert(
+        test_read_random_access(TEST_DIR "ff_random.test"), "Random access read test error");
+}
+
+MU_TEST(flipper_file_int32_chunk_test) {
+    mu_assert(test_int32_chunks(TEST_DIR "ff_int32.test"), "Int32 chunks test error");
+}
+
 MU_TEST_SUITE(flipper_file) {
     tests_setup();
     MU_RUN_TEST(flipper_file_write_test);
@@ -491,6 +653,8 @@ MU_TEST_SUITE(flipper_file) {
     MU_RUN_TEST(flipper_file_update_2_test);
     MU_RUN_TEST(flipper_file_update_2_result_test);
     MU_RUN_TEST(flipper_file_multikey_test);
+    MU_RUN_TEST(flipper_file_random_access_test);
+    MU_RUN_TEST(flipper_file_int32_chunk_test);
     tests_teardown();
 }
 
@@ -0,0 +1,137 @@
+#include <furi.h>
+#include "../minunit.h"
+
+#define TEST_THREADS 4
+#define TEST_THREAD_ADDS 20000
+
+static FuriStatsGroup* group_first = NULL;
+static FuriStatsGroup* group_second = NULL;
+static FuriStatsGroup* group_other = NULL;
+
+static void test_setup() {
+    group_first = furi_stats_group_alloc("test_stats");
+    group_second = furi_stats_group_alloc("test_stats_second");
+    group_other = furi_stats_group_alloc("other_test_stats");
+}
+
+static void test_teardown() {
+    furi_stats_group_free(group_first);
+    furi_stats_group_free(group_second);
+    furi_stats_group_free(group_other);
+}
+
+MU_TEST(furi_stats_counter_test) {
+    FuriStatsCounter* counter = furi_stats_counter_alloc(group_first, "counter");
+    FuriStatsCounter* high_water = furi_stats_counter_alloc(group_first, "high_water");
+
+    furi_stats_counter_add(counter, 1);
+    furi_stats_counter_add(counter, 41);
+    mu_assert_int_eq(42, furi_stats_counter_get(counter));
+
+    furi_stats_counter_max(high_water, 5);
+    furi_stats_counter_max(high_water, 3);
+    mu_assert_int_eq(5, furi_stats_counter_get(high_water));
+    furi_stats_counter_max(high_water, 8);
+    mu_assert_int_eq(8, furi_stats_counter_get(high_water));
+
+    furi_stats_group_reset(group_first);
+    mu_assert_int_eq(0, furi_stats_counter_get(counter));
+    mu_assert_int_eq(0, furi_stats_counter_get(high_water));
+}
+
+MU_TEST(furi_stats_histogram_test) {
+    FuriStatsHistogram* histogram = furi_stats_histogram_alloc(group_first, "histogram", "us");
+
+    // Buckets: 0, 1, 2-3, 4-7, ... and everything from 16384 in the last one
+    const uint32_t values[] = {0, 1, 2, 3, 4, 7, 8, 16383, 16384, UINT32_MAX};
+    const size_t buckets[] = {0, 1, 2, 2, 3, 3, 4, 14, 15, 15};
+    for(size_t i = 0; i < COUNT_OF(values); i++) {
+        furi_stats_histogram_add(histogram, values[i]);
+    }
+
+    mu_assert_int_eq(COUNT_OF(values), furi_stats_histogram_get_count(histogram));
+    for(size_t bucket = 0; bucket < FURI_STATS_HISTOGRAM_BUCKETS; bucket++) {
+        uint32_t expected = 0;
+        for(size_t i = 0; i < COUNT_OF(buckets); i++) {
+            if(buckets[i] == bucket) expected++;
+        }
+        mu_assert_int_eq(expected, furi_stats_histogram_get_bucket(histogram, bucket));
+    }
+
+    furi_stats_group_reset(group_first);
+    mu_assert_int_eq(0, furi_stats_histogram_get_count(histogram));
+    mu_assert_int_eq(0, furi_stats_histogram_get_bucket(histogram, 15));
+}
+
+MU_TEST(furi_stats_filter_test) {
+    FuriStatsCounter* first = furi_stats_counter_alloc(group_first, "filter");
+    FuriStatsCounter* second = furi_stats_counter_alloc(group_second, "filter");
+    FuriStatsCounter* other = furi_stats_counter_alloc(group_other, "filter");
+
+    // Filter is a group name prefix
+    mu_assert_int_eq(2, furi_stats_print("test_stats"));
+    mu_assert_int_eq(1, furi_stats_print("test_stats_second"));
+    mu_assert_int_eq(0, furi_stats_print("test_stats_third"));
+    mu_assert_int_eq(1, furi_stats_print("other_test"));
+
+    furi_stats_counter_add(first, 1);
+    furi_stats_counter_add(second, 1);
+    furi_stats_counter_add(other, 1);
+    furi_stats_reset("test_stats_");
+    mu_assert_int_eq(1, furi_stats_counter_get(first));
+    mu_assert_int_eq(0, furi_stats_counter_get(second));
+    mu_assert_int_eq(1, furi_stats_counter_get(other));
+}
+
+typedef struct {
+    FuriStatsCounter* counter;
+    FuriStatsHistogram* histogram;
+} TestStatsContext;
+
+static int32_t test_stats_thread(void* context) {
+    TestStatsContext* test = context;
+    for(size_t i = 0; i < TEST_THREAD_ADDS; i++) {
+        furi_stats_counter_add(test->counter, 1);
+        furi_stats_histogram_add(test->histogram, i);
+    }
+    return 0;
+}
+
+MU_TEST(furi_stats_concurrent_test) {
+    TestStatsContext test = {
+        .counter = furi_stats_counter_alloc(group_first, "concurrent"),
+        .histogram = furi_stats_histogram_alloc(group_first, "concurrent", NULL),
+    };
+    FuriThread* threads[TEST_THREADS];
+
+    for(size_t i = 0; i < TEST_THREADS; i++) {
+        threads[i] = furi_thread_alloc();
+        furi_thread_set_name(threads[i], "StatsTest");
+        furi_thread_set_stack_size(threads[i], 1024);
+        furi_thread_set_context(threads[i], &test);
+        furi_thread_set_callback(threads[i], test_stats_thread);
+        furi_thread_start(threads[i]);
+    }
+    for(size_t i = 0; i < TEST_THREADS; i++) {
+        furi_thread_join(threads[i]);
+        furi_thread_free(threads[i]);
+    }
+
+    // No update is lost between threads
+    mu_assert_int_eq(TEST_THREADS * TEST_THREAD_ADDS, furi_stats_counter_get(test.counter));
+    mu_assert_int_eq(
+        TEST_THREADS * TEST_THREAD_ADDS, furi_stats_histogram_get_count(test.histogram));
+}
+
+MU_TEST_SUITE(furi_stats) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+    MU_RUN_TEST(furi_stats_counter_test);
+    MU_RUN_TEST(furi_stats_histogram_test);
+    MU_RUN_TEST(furi_stats_filter_test);
+    MU_RUN_TEST(furi_stats_concurrent_test);
+}
+
+int run_minunit_test_furi_stats() {
+    MU_RUN_SUITE(furi_stats);
+    return MU_EXIT_CODE;
+}
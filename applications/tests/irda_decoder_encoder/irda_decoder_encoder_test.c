@@ -17,6 +17,19 @@
 
 #define RUN_ENCODER_DECODER(data) run_encoder_decoder((data), COUNT_OF(data))
 
+#define RUN_DECODER_BUFFER(data) run_decoder_buffer((data), COUNT_OF(data))
+#define DECODER_BUFFER_MESSAGES_SMALL 4
+
+#define RUN_WAVEFORM(data) run_waveform((data), COUNT_OF(data))
+
+#define RUN_DECODER_NOISY_PREAMBLE(data, expected) \
+    run_decoder_noisy_preamble((data), COUNT_OF(data), (expected), COUNT_OF(expected))
+#define NOISY_PREAMBLE_GLITCH_MARK 150
+#define NOISY_PREAMBLE_GLITCH_SPACE 300
+
+/* Frames compared against encoder, long enough to cover settled repeats */
+#define WAVEFORM_TEST_FRAMES 12
+
 static IrdaDecoderHandler* decoder_handler;
 static IrdaEncoderHandler* encoder_handler;
 
@@ -201,6 +214,74 @@ static void run_decoder(
     mu_assert(message_counter == message_expected_len, "decoded less than expected");
 }
 
+/* irda_decode_buffer() has to give the same messages as irda_decode() called for every timing.
+ * Input starts from Space, so it's skipped to start buffer from Mark. */
+static void run_decoder_buffer(const uint32_t* input_delays, uint32_t input_delays_len) {
+    IrdaMessage* messages_expected = furi_alloc(sizeof(IrdaMessage) * input_delays_len);
+    IrdaMessage* messages_decoded = furi_alloc(sizeof(IrdaMessage) * input_delays_len);
+    size_t messages_expected_cnt = 0;
+    size_t decoded_end_expected = 0;
+
+    irda_reset_decoder(decoder_handler);
+    for(uint32_t i = 1; i < input_delays_len; ++i) {
+        const IrdaMessage* message = irda_decode(decoder_handler, i % 2, input_delays[i]);
+        if(message) {
+            messages_expected[messages_expected_cnt++] = *message;
+            decoded_end_expected = i;
+        }
+    }
+
+    irda_reset_decoder(decoder_handler);
+    size_t decoded_end = 0;
+    size_t messages_decoded_cnt = irda_decode_buffer(
+        decoder_handler,
+        &input_delays[1],
+        input_delays_len - 1,
+        messages_decoded,
+        input_delays_len,
+        &decoded_end);
+
+    mu_assert(messages_decoded_cnt == messages_expected_cnt, "batch decoded different amount");
+    mu_assert(decoded_end == decoded_end_expected, "batch decoded message at different timing");
+    for(size_t i = 0; i < messages_decoded_cnt; ++i) {
+        compare_message_results(&messages_decoded[i], &messages_expected[i]);
+    }
+
+    // Few messages at a time: decoding stops when they are full and goes on from decoded_end
+    irda_reset_decoder(decoder_handler);
+    const uint32_t* timings = &input_delays[1];
+    size_t timings_cnt = input_delays_len - 1;
+    size_t start = 0;
+    messages_decoded_cnt = 0;
+    while(true) {
+        size_t cnt = irda_decode_buffer(
+            decoder_handler,
+            &timings[start],
+            timings_cnt - start,
+            &messages_decoded[messages_decoded_cnt],
+            DECODER_BUFFER_MESSAGES_SMALL,
+            &decoded_end);
+        mu_assert(cnt <= DECODER_BUFFER_MESSAGES_SMALL, "batch overflowed messages");
+        messages_decoded_cnt += cnt;
+        start += decoded_end;
+        if(cnt < DECODER_BUFFER_MESSAGES_SMALL || start == timings_cnt) break;
+        // Buffer has to start from Mark
+        if(start % 2) {
+            const IrdaMessage* message = irda_decode(decoder_handler, false, timings[start++]);
+            if(message) messages_decoded[messages_decoded_cnt++] = *message;
+        }
+    }
+
+    mu_assert(
+        messages_decoded_cnt == messages_expected_cnt, "small batch decoded different amount");
+    for(size_t i = 0; i < messages_decoded_cnt; ++i) {
+        compare_message_results(&messages_decoded[i], &messages_expected[i]);
+    }
+
+    free(messages_expected);
+    free(messages_decoded);
+}
+
 MU_TEST(test_decoder_samsung32) {
     RUN_DECODER(test_decoder_samsung32_input1, test_decoder_samsung32_expected1);
 }
@@ -304,6 +385,106 @@ MU_TEST(test_encoder_decoder_all) {
     RUN_ENCODER_DECODER(test_sirc);
 }
 
+MU_TEST(test_decoder_buffer) {
+    RUN_DECODER_BUFFER(test_decoder_nec_input1);
+    RUN_DECODER_BUFFER(test_decoder_nec_input2);
+    RUN_DECODER_BUFFER(test_decoder_nec_input3);
+    RUN_DECODER_BUFFER(test_decoder_necext_input1);
+    RUN_DECODER_BUFFER(test_decoder_nec42ext_input1);
+    RUN_DECODER_BUFFER(test_decoder_nec42ext_input2);
+    RUN_DECODER_BUFFER(test_decoder_samsung32_input1);
+    RUN_DECODER_BUFFER(test_decoder_rc5x_input1);
+    RUN_DECODER_BUFFER(test_decoder_rc5_input1);
+    RUN_DECODER_BUFFER(test_decoder_rc5_input_all_repeats);
+    RUN_DECODER_BUFFER(test_decoder_rc6_input1);
+    RUN_DECODER_BUFFER(test_decoder_sirc_input1);
+    RUN_DECODER_BUFFER(test_decoder_sirc_input5);
+}
+
+/* Walks waveform the same way transmitter does and compares it with encoder */
+static void run_waveform(const IrdaMessage input_messages[], uint32_t input_messages_len) {
+    for(uint32_t message_counter = 0; message_counter < input_messages_len; ++message_counter) {
+        const IrdaMessage* message = &input_messages[message_counter];
+        IrdaWaveform* waveform = irda_waveform_alloc(message);
+        mu_assert(waveform, "waveform is not rendered");
+        mu_check(waveform->frames_cnt > 0);
+        mu_check(waveform->frequency == irda_get_protocol_frequency(message->protocol));
+
+        // Fresh encoder, as toggle bit of RC5/RC6 changes on every reset
+        IrdaEncoderHandler* handler = irda_alloc_encoder();
+        irda_reset_encoder(handler, message);
+        size_t index = 0;
+        size_t frame = 0;
+        for(int frames_sent = 0; frames_sent < WAVEFORM_TEST_FRAMES; ++frames_sent) {
+            IrdaStatus status = IrdaStatusOk;
+            while(status == IrdaStatusOk) {
+                uint32_t duration;
+                bool level;
+                status = irda_encode(handler, &duration, &level);
+                mu_assert(status != IrdaStatusError, "encoder error");
+                uint32_t expected = duration | (level ? IRDA_WAVEFORM_LEVEL : 0);
+                mu_assert(waveform->timings[index] == expected, "waveform timing differs");
+                ++index;
+                bool frame_end = (index == waveform->frame_end[frame]);
+                mu_assert(frame_end == (status == IrdaStatusDone), "waveform frame end differs");
+            }
+
+            if(frame + 1 < waveform->frames_cnt) {
+                ++frame;
+            } else {
+                index = frame ? waveform->frame_end[frame - 1] : 0;
+            }
+        }
+
+        irda_free_encoder(handler);
+        irda_waveform_free(waveform);
+    }
+}
+
+MU_TEST(test_waveform_all) {
+    RUN_WAVEFORM(test_nec);
+    RUN_WAVEFORM(test_necext);
+    RUN_WAVEFORM(test_nec42);
+    RUN_WAVEFORM(test_nec42ext);
+    RUN_WAVEFORM(test_samsung32);
+    RUN_WAVEFORM(test_rc6);
+    RUN_WAVEFORM(test_rc5);
+    RUN_WAVEFORM(test_sirc);
+}
+
+/* Glitch in front of the first frame: short mark and space which is shorter than any
+ * preamble space, so decoders have to find the real preamble right behind it */
+static void run_decoder_noisy_preamble(
+    const uint32_t* input_delays,
+    uint32_t input_delays_len,
+    const IrdaMessage* message_expected,
+    uint32_t message_expected_len) {
+    uint32_t* noisy_delays = furi_alloc(sizeof(uint32_t) * (input_delays_len + 2));
+
+    // Input starts from Space
+    noisy_delays[0] = input_delays[0];
+    noisy_delays[1] = NOISY_PREAMBLE_GLITCH_MARK;
+    noisy_delays[2] = NOISY_PREAMBLE_GLITCH_SPACE;
+    memcpy(&noisy_delays[3], &input_delays[1], sizeof(uint32_t) * (input_delays_len - 1));
+
+    run_decoder(noisy_delays, input_delays_len + 2, message_expected, message_expected_len);
+    free(noisy_delays);
+}
+
+MU_TEST(test_decoder_noisy_preamble) {
+    RUN_DECODER_NOISY_PREAMBLE(test_decoder_nec_input2, test_decoder_nec_expected2);
+    RUN_DECODER_NOISY_PREAMBLE(test_decoder_samsung32_input1, test_decoder_samsung32_expected1);
+    RUN_DECODER_NOISY_PREAMBLE(test_decoder_sirc_input1, test_decoder_sirc_expected1);
+    RUN_DECODER_NOISY_PREAMBLE(test_decoder_rc6_input1, test_decoder_rc6_expected1);
+}
+
+MU_TEST(test_decoder_preamble_filter) {
+    uint32_t skipped_cnt = irda_get_decoder_skipped_count(decoder_handler);
+    // NEC frames don't start from Samsung32, RC6 or SIRC preamble
+    RUN_DECODER(test_decoder_nec_input2, test_decoder_nec_expected2);
+    mu_check(irda_get_decoder_skipped_count(decoder_handler) > skipped_cnt);
+}
+
 MU_TEST_SUITE(test_irda_decoder_encoder) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
 
@@ -321,6 +502,10 @@ MU_TEST_SUITE(test_irda_decoder_encoder) {
     MU_RUN_TEST(test_decoder_necext1);
     MU_RUN_TEST(test_mix);
     MU_RUN_TEST(test_encoder_decoder_all);
+    MU_RUN_TEST(test_decoder_buffer);
+    MU_RUN_TEST(test_decoder_preamble_filter);
+    MU_RUN_TEST(test_decoder_noisy_preamble);
+    MU_RUN_TEST(test_waveform_all);
 }
 
 int run_minunit_test_irda_decoder_encoder() {
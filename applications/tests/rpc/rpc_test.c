@@ -32,10 +32,11 @@ static uint32_t command_id = 0;
 #define TAG "UnitTestsRpc"
 #define MAX_RECEIVE_OUTPUT_TIMEOUT 3000
 #define MAX_NAME_LENGTH 255
-#define MAX_DATA_SIZE 512 // have to be exact as in rpc_storage.c
+#define MAX_DATA_SIZE RPC_STORAGE_READ_CHUNK_SIZE
 #define TEST_DIR TEST_DIR_NAME "/"
 #define TEST_DIR_NAME "/ext/unit_tests_tmp"
 #define MD5SUM_SIZE 16
+#define READ_SPEED_FILE_SIZE (256 * 1024)
 
 #define PING_REQUEST 0
 #define PING_RESPONSE 1
@@ -760,12 +761,58 @@ MU_TEST(test_storage_read) {
     test_create_file(TEST_DIR "file2.txt", MAX_DATA_SIZE);
     test_create_file(TEST_DIR "file3.txt", MAX_DATA_SIZE + 1);
     test_create_file(TEST_DIR "file4.txt", (MAX_DATA_SIZE * 2) + 1);
+    test_create_file(TEST_DIR "file5.txt", (MAX_DATA_SIZE * 5) - 1);
 
     test_storage_read_run(TEST_DIR "empty.txt", ++command_id);
     test_storage_read_run(TEST_DIR "file1.txt", ++command_id);
     test_storage_read_run(TEST_DIR "file2.txt", ++command_id);
     test_storage_read_run(TEST_DIR "file3.txt", ++command_id);
     test_storage_read_run(TEST_DIR "file4.txt", ++command_id);
+    test_storage_read_run(TEST_DIR "file5.txt", ++command_id);
+}
+
+/* Client side of a big file download: decode responses as they come */
+MU_TEST(test_storage_read_speed) {
+    test_create_file(TEST_DIR "speed.bin", READ_SPEED_FILE_SIZE);
+
+    PB_Main request;
+    test_rpc_create_simple_message(
+        &request, PB_Main_storage_read_request_tag, TEST_DIR "speed.bin", ++command_id);
+
+    pb_istream_t istream = {
+        .callback = test_rpc_pb_stream_read,
+        .state = output_stream,
+        .errmsg = NULL,
+        .bytes_left = 0x7FFFFFFF,
+    };
+    PB_Main response = {.cb_content.funcs.decode = NULL};
+    size_t received = 0;
+    bool has_next = true;
+
+    uint32_t start = osKernelGetTickCount();
+    test_rpc_encode_and_feed_one(&request);
+    while(has_next) {
+        bool decoded = pb_decode_ex(&istream, &PB_Main_msg, &response, PB_DECODE_DELIMITED);
+        mu_assert(decoded, "not all read responses decoded");
+        mu_check(response.command_status == PB_CommandStatus_OK);
+        mu_check(response.which_content == PB_Main_storage_read_response_tag);
+        if(response.content.storage_read_response.file.data) {
+            received += response.content.storage_read_response.file.data->size;
+        }
+        has_next = response.has_next;
+        pb_release(&PB_Main_msg, &response);
+    }
+    uint32_t ticks = MAX(osKernelGetTickCount() - start, 1UL);
+
+    mu_check(received == READ_SPEED_FILE_SIZE);
+    FURI_LOG_I(
+        TAG,
+        "Storage read: %zu bytes in %lu ms, %0.2f MB/s",
+        received,
+        ticks * 1000 / osKernelGetTickFreq(),
+        (float)received * osKernelGetTickFreq() / ticks / (1024 * 1024));
+
+    pb_release(&PB_Main_msg, &request);
 }
 
 static void test_storage_write_run(
@@ -1208,6 +1255,7 @@ MU_TEST_SUITE(test_rpc_storage) {
     MU_RUN_TEST(test_storage_stat);
     MU_RUN_TEST(test_storage_list);
     MU_RUN_TEST(test_storage_read);
+    MU_RUN_TEST(test_storage_read_speed);
     MU_RUN_TEST(test_storage_write_read);
     MU_RUN_TEST(test_storage_write);
     MU_RUN_TEST(test_storage_delete);
@@ -0,0 +1,219 @@
+#include <furi.h>
+#include <lib/toolbox/sector_cache.h>
+#include "../minunit.h"
+
+#define TEST_SECTOR_SIZE 16
+#define TEST_DISK_SECTORS 64
+#define TEST_CACHE_SECTORS 4
+
+typedef struct {
+    uint8_t data[TEST_DISK_SECTORS * TEST_SECTOR_SIZE];
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t last_write_sector;
+    uint32_t last_write_count;
+    bool sequential;
+} TestDisk;
+
+static TestDisk* disk = NULL;
+static SectorCache* cache = NULL;
+
+static bool test_disk_read(void* context, uint8_t* data, uint32_t sector, uint32_t count) {
+    TestDisk* disk = context;
+    memcpy(data, &disk->data[sector * TEST_SECTOR_SIZE], count * TEST_SECTOR_SIZE);
+    disk->reads++;
+    return true;
+}
+
+static bool
+    test_disk_write(void* context, const uint8_t* data, uint32_t sector, uint32_t count) {
+    TestDisk* disk = context;
+    if(disk->writes && sector < disk->last_write_sector) disk->sequential = false;
+    memcpy(&disk->data[sector * TEST_SECTOR_SIZE], data, count * TEST_SECTOR_SIZE);
+    disk->writes++;
+    disk->last_write_sector = sector;
+    disk->last_write_count = count;
+    return true;
+}
+
+static void test_sector_fill(uint8_t* data, uint32_t sector, uint8_t seed) {
+    for(size_t i = 0; i < TEST_SECTOR_SIZE; i++) data[i] = sector * 7 + i + seed;
+}
+
+static void test_setup() {
+    disk = furi_alloc(sizeof(TestDisk));
+    for(size_t sector = 0; sector < TEST_DISK_SECTORS; sector++) {
+        test_sector_fill(&disk->data[sector * TEST_SECTOR_SIZE], sector, 0);
+    }
+    disk->sequential = true;
+    cache = sector_cache_alloc(
+        TEST_CACHE_SECTORS, TEST_SECTOR_SIZE, test_disk_read, test_disk_write, disk);
+}
+
+static void test_teardown() {
+    sector_cache_free(cache);
+    free(disk);
+}
+
+MU_TEST(sector_cache_read_hit_test) {
+    uint8_t data[TEST_SECTOR_SIZE];
+    uint8_t expected[TEST_SECTOR_SIZE];
+    test_sector_fill(expected, 5, 0);
+
+    mu_check(sector_cache_read(cache, data, 5, 1));
+    mu_check(memcmp(data, expected, TEST_SECTOR_SIZE) == 0);
+    mu_check(sector_cache_read(cache, data, 5, 1));
+    mu_check(memcmp(data, expected, TEST_SECTOR_SIZE) == 0);
+
+    SectorCacheStats stats;
+    sector_cache_get_stats(cache, &stats);
+    mu_assert_int_eq(1, disk->reads);
+    mu_assert_int_eq(2, stats.reads);
+    mu_assert_int_eq(1, stats.read_hits);
+}
+
+MU_TEST(sector_cache_lru_test) {
+    uint8_t data[TEST_SECTOR_SIZE];
+
+    // 0 is used again, so 1 is the one evicted by 4
+    for(uint32_t sector = 0; sector < TEST_CACHE_SECTORS; sector++) {
+        mu_check(sector_cache_read(cache, data, sector, 1));
+    }
+    mu_check(sector_cache_read(cache, data, 0, 1));
+    mu_check(sector_cache_read(cache, data, TEST_CACHE_SECTORS, 1));
+    mu_assert_int_eq(TEST_CACHE_SECTORS + 1, disk->reads);
+
+    mu_check(sector_cache_read(cache, data, 0, 1));
+    mu_assert_int_eq(TEST_CACHE_SECTORS + 1, disk->reads);
+    mu_check(sector_cache_read(cache, data, 1, 1));
+    mu_assert_int_eq(TEST_CACHE_SECTORS + 2, disk->reads);
+}
+
+MU_TEST(sector_cache_write_back_test) {
+    uint8_t data[TEST_SECTOR_SIZE];
+    uint8_t expected[TEST_SECTOR_SIZE];
+
+    // Same sector written again and again, like FAT during file write
+    for(uint8_t seed = 1; seed <= 10; seed++) {
+        test_sector_fill(data, 3, seed);
+        mu_check(sector_cache_write(cache, data, 3, 1));
+    }
+    mu_assert_int_eq(0, disk->writes);
+
+    mu_check(sector_cache_read(cache, data, 3, 1));
+    test_sector_fill(expected, 3, 10);
+    mu_check(memcmp(data, expected, TEST_SECTOR_SIZE) == 0);
+
+    mu_check(sector_cache_flush(cache));
+    mu_assert_int_eq(1, disk->writes);
+    mu_check(memcmp(&disk->data[3 * TEST_SECTOR_SIZE], expected, TEST_SECTOR_SIZE) == 0);
+
+    // Nothing is dirty anymore
+    mu_check(sector_cache_flush(cache));
+    mu_assert_int_eq(1, disk->writes);
+
+    SectorCacheStats stats;
+    sector_cache_get_stats(cache, &stats);
+    mu_assert_int_eq(10, stats.writes);
+    mu_assert_int_eq(9, stats.writes_merged);
+    mu_assert_int_eq(1, stats.write_backs);
+}
+
+MU_TEST(sector_cache_eviction_test) {
+    uint8_t data[TEST_SECTOR_SIZE];
+    uint8_t expected[TEST_SECTOR_SIZE];
+
+    test_sector_fill(expected, 10, 1);
+    mu_check(sector_cache_write(cache, expected, 10, 1));
+    for(uint32_t sector = 20; sector < 20 + TEST_CACHE_SECTORS; sector++) {
+        mu_check(sector_cache_read(cache, data, sector, 1));
+    }
+
+    // Dirty sector had to reach the disk before its slot was reused
+    mu_assert_int_eq(1, disk->writes);
+    mu_check(memcmp(&disk->data[10 * TEST_SECTOR_SIZE], expected, TEST_SECTOR_SIZE) == 0);
+}
+
+MU_TEST(sector_cache_flush_order_test) {
+    uint8_t data[TEST_SECTOR_SIZE];
+    const uint32_t sectors[] = {40, 12, 33, 7};
+
+    for(size_t i = 0; i < COUNT_OF(sectors); i++) {
+        test_sector_fill(data, sectors[i], 1);
+        mu_check(sector_cache_write(cache, data, sectors[i], 1));
+    }
+    mu_check(sector_cache_flush(cache));
+    mu_assert_int_eq(COUNT_OF(sectors), disk->writes);
+    mu_check(disk->sequential);
+}
+
+MU_TEST(sector_cache_flush_run_test) {
+    uint8_t data[TEST_SECTOR_SIZE];
+
+    // Fresh slots are taken in order, so consecutive sectors go in one request
+    for(uint32_t sector = 8; sector < 8 + TEST_CACHE_SECTORS; sector++) {
+        test_sector_fill(data, sector, 1);
+        mu_check(sector_cache_write(cache, data, sector, 1));
+    }
+    mu_check(sector_cache_flush(cache));
+    mu_assert_int_eq(1, disk->writes);
+    mu_assert_int_eq(8, disk->last_write_sector);
+    mu_assert_int_eq(TEST_CACHE_SECTORS, disk->last_write_count);
+}
+
+MU_TEST(sector_cache_multi_sector_test) {
+    uint8_t data[TEST_SECTOR_SIZE * 8];
+    uint8_t expected[TEST_SECTOR_SIZE];
+
+    // Dirty cached sector is newer than disk, multi sector read must see it
+    test_sector_fill(expected, 18, 1);
+    mu_check(sector_cache_write(cache, expected, 18, 1));
+    mu_check(sector_cache_read(cache, data, 16, 8));
+    mu_check(memcmp(&data[2 * TEST_SECTOR_SIZE], expected, TEST_SECTOR_SIZE) == 0);
+    test_sector_fill(expected, 16, 0);
+    mu_check(memcmp(data, expected, TEST_SECTOR_SIZE) == 0);
+
+    // Multi sector write overrides cached copy, flush must not bring old data back
+    for(uint32_t i = 0; i < 8; i++) test_sector_fill(&data[i * TEST_SECTOR_SIZE], 16 + i, 2);
+    mu_check(sector_cache_write(cache, data, 16, 8));
+    mu_check(sector_cache_flush(cache));
+    mu_assert_int_eq(1, disk->writes);
+    test_sector_fill(expected, 18, 2);
+    mu_check(memcmp(&disk->data[18 * TEST_SECTOR_SIZE], expected, TEST_SECTOR_SIZE) == 0);
+
+    SectorCacheStats stats;
+    sector_cache_get_stats(cache, &stats);
+    mu_assert_int_eq(16, stats.bypassed);
+}
+
+MU_TEST(sector_cache_invalidate_test) {
+    uint8_t data[TEST_SECTOR_SIZE];
+
+    mu_check(sector_cache_read(cache, data, 1, 1));
+    test_sector_fill(data, 2, 1);
+    mu_check(sector_cache_write(cache, data, 2, 1));
+    sector_cache_invalidate(cache);
+
+    mu_check(sector_cache_flush(cache));
+    mu_assert_int_eq(0, disk->writes);
+    mu_check(sector_cache_read(cache, data, 1, 1));
+    mu_assert_int_eq(2, disk->reads);
+}
+
+MU_TEST_SUITE(sector_cache) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(sector_cache_read_hit_test);
+    MU_RUN_TEST(sector_cache_lru_test);
+    MU_RUN_TEST(sector_cache_write_back_test);
+    MU_RUN_TEST(sector_cache_eviction_test);
+    MU_RUN_TEST(sector_cache_flush_order_test);
+    MU_RUN_TEST(sector_cache_flush_run_test);
+    MU_RUN_TEST(sector_cache_multi_sector_test);
+    MU_RUN_TEST(sector_cache_invalidate_test);
+}
+
+int run_minunit_test_sector_cache() {
+    MU_RUN_SUITE(sector_cache);
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,155 @@
+#include <furi.h>
+#include <stdlib.h>
+#include <storage/storage.h>
+#include "../minunit.h"
+
+#define TEST_DIR TEST_DIR_NAME "/"
+#define TEST_DIR_NAME "/ext/unit_tests_tmp"
+
+#define TEST_BUFFERED_FILE TEST_DIR "buffered.test"
+#define TEST_REFERENCE_FILE TEST_DIR "reference.test"
+
+/* Small buffer, so chunks of up to 2 buffers hit both buffered and bypass paths */
+#define TEST_BUFFER_SIZE 16
+#define TEST_CHUNK_MAX (TEST_BUFFER_SIZE * 2)
+#define TEST_FILE_SIZE 200
+#define TEST_OPERATIONS 2000
+#define TEST_SEEDS 8
+
+typedef enum {
+    TestOpRead,
+    TestOpWrite,
+    TestOpSeek,
+    TestOpSeekForward,
+    TestOpTell,
+    TestOpEof,
+    TestOpSize,
+    TestOpSync,
+    TestOpMax,
+} TestOp;
+
+static Storage* storage = NULL;
+
+static void tests_setup() {
+    storage = furi_record_open("storage");
+    storage_simply_remove_recursive(storage, TEST_DIR_NAME);
+    storage_simply_mkdir(storage, TEST_DIR_NAME);
+}
+
+static void tests_teardown() {
+    storage_simply_remove_recursive(storage, TEST_DIR_NAME);
+    furi_record_close("storage");
+}
+
+static bool test_file_open(File* file, const char* path, const uint8_t* data) {
+    if(!storage_file_open(file, path, FSAM_READ | FSAM_WRITE, FSOM_CREATE_ALWAYS)) return false;
+    if(storage_file_write(file, data, TEST_FILE_SIZE) != TEST_FILE_SIZE) return false;
+    return storage_file_seek(file, 0, true);
+}
+
+/* Same operations on buffered and unbuffered file must give the same results */
+static bool test_file_buffer_sequence(uint32_t seed) {
+    bool result = false;
+    uint8_t* file_data = furi_alloc(TEST_FILE_SIZE);
+    uint8_t* buffered_data = furi_alloc(TEST_CHUNK_MAX);
+    uint8_t* reference_data = furi_alloc(TEST_CHUNK_MAX);
+    uint8_t* buffer = furi_alloc(TEST_BUFFER_SIZE);
+    File* buffered = storage_file_alloc(storage);
+    File* reference = storage_file_alloc(storage);
+
+    srand(seed);
+    for(size_t i = 0; i < TEST_FILE_SIZE; i++) {
+        file_data[i] = rand();
+    }
+
+    do {
+        if(!test_file_open(buffered, TEST_BUFFERED_FILE, file_data)) break;
+        if(!test_file_open(reference, TEST_REFERENCE_FILE, file_data)) break;
+        if(!storage_file_set_buffer(buffered, buffer, TEST_BUFFER_SIZE)) break;
+        result = true;
+
+        for(size_t i = 0; result && i < TEST_OPERATIONS; i++) {
+            uint32_t chunk = 1 + rand() % TEST_CHUNK_MAX;
+            uint32_t position = rand() % (TEST_FILE_SIZE + TEST_CHUNK_MAX);
+
+            switch(rand() % TestOpMax) {
+            case TestOpRead:
+                memset(buffered_data, 0, TEST_CHUNK_MAX);
+                memset(reference_data, 0, TEST_CHUNK_MAX);
+                result = storage_file_read(buffered, buffered_data, chunk) ==
+                             storage_file_read(reference, reference_data, chunk) &&
+                         memcmp(buffered_data, reference_data, TEST_CHUNK_MAX) == 0;
+                break;
+            case TestOpWrite:
+                for(size_t j = 0; j < chunk; j++) {
+                    buffered_data[j] = rand();
+                }
+                result = storage_file_write(buffered, buffered_data, chunk) ==
+                         storage_file_write(reference, buffered_data, chunk);
+                break;
+            case TestOpSeek:
+                result = storage_file_seek(buffered, position, true) ==
+                         storage_file_seek(reference, position, true);
+                break;
+            case TestOpSeekForward:
+                result = storage_file_seek(buffered, chunk, false) ==
+                         storage_file_seek(reference, chunk, false);
+                break;
+            case TestOpTell:
+                result = storage_file_tell(buffered) == storage_file_tell(reference);
+                break;
+            case TestOpEof:
+                result = storage_file_eof(buffered) == storage_file_eof(reference);
+                break;
+            case TestOpSize:
+                result = storage_file_size(buffered) == storage_file_size(reference);
+                break;
+            case TestOpSync:
+                result = storage_file_sync(buffered) == storage_file_sync(reference);
+                break;
+            default:
+                break;
+            }
+            // Every operation leaves both files at the same position
+            result = result && storage_file_tell(buffered) == storage_file_tell(reference);
+        }
+        if(!result) break;
+
+        // Contents match after last writes are flushed by close
+        result = storage_file_close(buffered) && storage_file_close(reference);
+        if(!result) break;
+        result = storage_file_open(buffered, TEST_BUFFERED_FILE, FSAM_READ, FSOM_OPEN_EXISTING) &&
+                 storage_file_open(reference, TEST_REFERENCE_FILE, FSAM_READ, FSOM_OPEN_EXISTING);
+        while(result) {
+            uint32_t readed = storage_file_read(buffered, buffered_data, TEST_CHUNK_MAX);
+            result = readed == storage_file_read(reference, reference_data, TEST_CHUNK_MAX) &&
+                     memcmp(buffered_data, reference_data, readed) == 0;
+            if(readed == 0) break;
+        }
+    } while(false);
+
+    storage_file_free(buffered);
+    storage_file_free(reference);
+    free(buffer);
+    free(reference_data);
+    free(buffered_data);
+    free(file_data);
+    return result;
+}
+
+MU_TEST(storage_file_buffer_sequence_test) {
+    for(uint32_t seed = 1; seed <= TEST_SEEDS; seed++) {
+        mu_assert(test_file_buffer_sequence(seed), "Buffered file differs from unbuffered");
+    }
+}
+
+MU_TEST_SUITE(storage_file_buffer) {
+    tests_setup();
+    MU_RUN_TEST(storage_file_buffer_sequence_test);
+    tests_teardown();
+}
+
+int run_minunit_test_storage_file_buffer() {
+    MU_RUN_SUITE(storage_file_buffer);
+    return MU_EXIT_CODE;
+}
@@ -14,6 +14,9 @@ int run_minunit();
 int run_minunit_test_irda_decoder_encoder();
 int run_minunit_test_rpc();
 int run_minunit_test_flipper_file();
+int run_minunit_test_sector_cache();
+int run_minunit_test_storage_file_buffer();
+int run_minunit_test_furi_stats();
 
 void minunit_print_progress(void) {
     static char progress[] = {'\\', '|', '/', '-'};
@@ -54,6 +57,9 @@ void unit_tests_cli(Cli* cli, string_t args, void* context) {
         test_result |= run_minunit_test_irda_decoder_encoder();
         test_result |= run_minunit_test_rpc();
         test_result |= run_minunit_test_flipper_file();
+        test_result |= run_minunit_test_sector_cache();
+        test_result |= run_minunit_test_storage_file_buffer();
+        test_result |= run_minunit_test_furi_stats();
         cycle_counter = (DWT->CYCCNT - cycle_counter);
 
         FURI_LOG_I(TAG, "Consumed: %0.2fs", (float)cycle_counter / (SystemCoreClock));
@@ -4,5 +4,6 @@ void furi_init() {
     api_interrupt_init();
     furi_log_init();
     furi_record_init();
+    furi_stats_init();
     furi_stdglue_init();
 }
@@ -12,6 +12,7 @@
 #include <furi/memmgr_heap.h>
 #include <furi/pubsub.h>
 #include <furi/record.h>
+#include <furi/stats.h>
 #include <furi/stdglue.h>
 #include <furi/thread.h>
 #include <furi/valuemutex.h>
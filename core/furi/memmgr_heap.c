@@ -37,6 +37,10 @@
 #include "memmgr_heap.h"
 #include "check.h"
 #include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
 #include <cmsis_os2.h>
 
 /* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
@@ -133,10 +137,13 @@ void memmgr_heap_enable_thread_trace(osThreadId_t thread_id) {
     vTaskSuspendAll();
     {
         memmgr_heap_thread_trace_depth++;
-        furi_check(MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id) == NULL);
+        furi_check(
+            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)(uintptr_t)thread_id) ==
+            NULL);
         MemmgrHeapAllocDict_t alloc_dict;
         MemmgrHeapAllocDict_init(alloc_dict);
-        MemmgrHeapThreadDict_set_at(memmgr_heap_thread_dict, (uint32_t)thread_id, alloc_dict);
+        MemmgrHeapThreadDict_set_at(
+            memmgr_heap_thread_dict, (uint32_t)(uintptr_t)thread_id, alloc_dict);
         MemmgrHeapAllocDict_clear(alloc_dict);
         memmgr_heap_thread_trace_depth--;
     }
@@ -147,8 +154,10 @@ void memmgr_heap_disable_thread_trace(osThreadId_t thread_id) {
     vTaskSuspendAll();
     {
         memmgr_heap_thread_trace_depth++;
-        furi_check(MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id) != NULL);
-        MemmgrHeapThreadDict_erase(memmgr_heap_thread_dict, (uint32_t)thread_id);
+        furi_check(
+            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)(uintptr_t)thread_id) !=
+            NULL);
+        MemmgrHeapThreadDict_erase(memmgr_heap_thread_dict, (uint32_t)(uintptr_t)thread_id);
         memmgr_heap_thread_trace_depth--;
     }
     (void)xTaskResumeAll();
@@ -160,7 +169,7 @@ size_t memmgr_heap_get_thread_memory(osThreadId_t thread_id) {
     {
         memmgr_heap_thread_trace_depth++;
         MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
+            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)(uintptr_t)thread_id);
         if(alloc_dict) {
             leftovers = 0;
             MemmgrHeapAllocDict_it_t alloc_dict_it;
@@ -183,9 +192,9 @@ static inline void traceMALLOC(void* pointer, size_t size) {
     if(thread_id && memmgr_heap_thread_trace_depth == 0) {
         memmgr_heap_thread_trace_depth++;
         MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
+            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)(uintptr_t)thread_id);
         if(alloc_dict) {
-            MemmgrHeapAllocDict_set_at(*alloc_dict, (uint32_t)pointer, (uint32_t)size);
+            MemmgrHeapAllocDict_set_at(*alloc_dict, (uint32_t)(uintptr_t)pointer, (uint32_t)size);
         }
         memmgr_heap_thread_trace_depth--;
     }
@@ -197,14 +206,307 @@ static inline void traceFREE(void* pointer, size_t size) {
     if(thread_id && memmgr_heap_thread_trace_depth == 0) {
         memmgr_heap_thread_trace_depth++;
         MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
+            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)(uintptr_t)thread_id);
         if(alloc_dict) {
-            MemmgrHeapAllocDict_erase(*alloc_dict, (uint32_t)pointer);
+            MemmgrHeapAllocDict_erase(*alloc_dict, (uint32_t)(uintptr_t)pointer);
         }
         memmgr_heap_thread_trace_depth--;
     }
 }
 
+/* Slab caches
+ *
+ * Blocks up to MEMMGR_HEAP_SLAB_SIZE_MAX bytes come from pages carved from
+ * the top of the heap, every page is split into blocks of one size class, so
+ * short lived small blocks don't split free blocks of the heap. Slab block has
+ * the same header as heap block, but its pxNextFreeBlock points to the page.
+ * Page headers are counted as free heap: allocating or freeing a slab block
+ * changes free heap by the block size, the same way heap block does.
+ * Empty page goes back to the heap, unless it is the topmost block: it can't
+ * split free space there, and it saves carving on the next allocation.
+ */
+
+typedef struct MemmgrHeapSlabPage {
+    struct MemmgrHeapSlabPage* next; /*<< Next page of class with free blocks. */
+    struct MemmgrHeapSlabPage* prev;
+    BlockLink_t* free_blocks;
+    uint16_t used;
+    uint16_t class_index;
+} MemmgrHeapSlabPage;
+
+typedef struct {
+    MemmgrHeapSlabPage* pages_partial; /*<< Pages with free blocks. */
+    size_t pages;
+    size_t pages_empty;
+    size_t used;
+    size_t used_max;
+    uint32_t allocs;
+    uint32_t page_allocs;
+} MemmgrHeapSlabClass;
+
+#if MEMMGR_HEAP_SLAB
+static MemmgrHeapSlabClass memmgr_heap_slab[MEMMGR_HEAP_SLAB_CLASSES] = {0};
+
+static const size_t memmgr_heap_slab_page_header =
+    (sizeof(MemmgrHeapSlabPage) + ((size_t)(portBYTE_ALIGNMENT - 1))) &
+    ~((size_t)portBYTE_ALIGNMENT_MASK);
+
+static inline size_t memmgr_heap_slab_class_index(size_t size) {
+    size_t class_index = 0;
+    while((MEMMGR_HEAP_SLAB_SIZE_MIN << class_index) < size) {
+        class_index++;
+    }
+    return class_index;
+}
+
+/* Block size with header */
+static inline size_t memmgr_heap_slab_block_size(size_t class_index) {
+    return xHeapStructSize + (MEMMGR_HEAP_SLAB_SIZE_MIN << class_index);
+}
+
+/* Page fits MEMMGR_HEAP_SLAB_PAGE_BLOCKS_MIN blocks at least */
+static inline size_t memmgr_heap_slab_page_size(size_t class_index) {
+    size_t blocks = (MEMMGR_HEAP_SLAB_PAGE_SIZE - memmgr_heap_slab_page_header) /
+                    memmgr_heap_slab_block_size(class_index);
+    return blocks < MEMMGR_HEAP_SLAB_PAGE_BLOCKS_MIN ? MEMMGR_HEAP_SLAB_PAGE_SIZE_MAX :
+                                                       MEMMGR_HEAP_SLAB_PAGE_SIZE;
+}
+
+/* Blocks in page of class */
+static inline size_t memmgr_heap_slab_page_blocks(size_t class_index) {
+    return (memmgr_heap_slab_page_size(class_index) - memmgr_heap_slab_page_header) /
+           memmgr_heap_slab_block_size(class_index);
+}
+
+/* Size of page block in the heap */
+static inline size_t memmgr_heap_slab_page_block_size(MemmgrHeapSlabPage* page) {
+    BlockLink_t* pxLink = (void*)(((uint8_t*)page) - xHeapStructSize);
+    return pxLink->xBlockSize & ~xBlockAllocatedBit;
+}
+
+/* Page is the last block before heap end */
+static inline bool memmgr_heap_slab_page_is_top(MemmgrHeapSlabPage* page) {
+    uint8_t* puc = ((uint8_t*)page) - xHeapStructSize;
+    return (puc + memmgr_heap_slab_page_block_size(page)) == (uint8_t*)pxEnd;
+}
+
+static void memmgr_heap_slab_page_link(MemmgrHeapSlabClass* slab_class, MemmgrHeapSlabPage* page) {
+    page->prev = NULL;
+    page->next = slab_class->pages_partial;
+    if(page->next) page->next->prev = page;
+    slab_class->pages_partial = page;
+}
+
+static void
+    memmgr_heap_slab_page_unlink(MemmgrHeapSlabClass* slab_class, MemmgrHeapSlabPage* page) {
+    if(page->prev) {
+        page->prev->next = page->next;
+    } else {
+        slab_class->pages_partial = page->next;
+    }
+    if(page->next) page->next->prev = page->prev;
+}
+
+/* Allocate block from the end of the highest free block that fits, so slab
+pages gather at the top of the heap and don't cut big free blocks below.
+Block is not traced: it belongs to the heap, not to the calling thread.
+Called with scheduler suspended. */
+static void* memmgr_heap_alloc_top(size_t xWantedSize) {
+    BlockLink_t *pxBlock, *pxPreviousBlock;
+    BlockLink_t *pxFoundBlock = NULL, *pxFoundPreviousBlock = NULL;
+
+    if(pxEnd == NULL) {
+        prvHeapInit();
+        memmgr_heap_init();
+    }
+
+    xWantedSize += xHeapStructSize;
+    configASSERT((xWantedSize & portBYTE_ALIGNMENT_MASK) == 0);
+
+    pxPreviousBlock = &xStart;
+    pxBlock = xStart.pxNextFreeBlock;
+    while(pxBlock != pxEnd) {
+        if(pxBlock->xBlockSize >= xWantedSize) {
+            pxFoundBlock = pxBlock;
+            pxFoundPreviousBlock = pxPreviousBlock;
+        }
+        pxPreviousBlock = pxBlock;
+        pxBlock = pxBlock->pxNextFreeBlock;
+    }
+
+    if(pxFoundBlock == NULL) return NULL;
+
+    if((pxFoundBlock->xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
+        /* Tail is split off, head stays in the free list */
+        pxFoundBlock->xBlockSize -= xWantedSize;
+        pxBlock = (void*)(((uint8_t*)pxFoundBlock) + pxFoundBlock->xBlockSize);
+        pxBlock->xBlockSize = xWantedSize;
+    } else {
+        pxFoundPreviousBlock->pxNextFreeBlock = pxFoundBlock->pxNextFreeBlock;
+        pxBlock = pxFoundBlock;
+    }
+
+    /* Page is counted as free heap again right away, so minimum ever free
+    heap is not updated */
+    xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+    pxBlock->xBlockSize |= xBlockAllocatedBit;
+    pxBlock->pxNextFreeBlock = NULL;
+    return (void*)(((uint8_t*)pxBlock) + xHeapStructSize);
+}
+
+/* Called with scheduler suspended */
+static MemmgrHeapSlabPage* memmgr_heap_slab_page_alloc(size_t class_index) {
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab[class_index];
+
+    MemmgrHeapSlabPage* page = memmgr_heap_alloc_top(memmgr_heap_slab_page_size(class_index));
+    if(page == NULL) return NULL;
+
+    xFreeBytesRemaining += memmgr_heap_slab_page_block_size(page);
+
+    page->used = 0;
+    page->class_index = class_index;
+    page->free_blocks = NULL;
+
+    /* Free list goes in address order */
+    size_t block_size = memmgr_heap_slab_block_size(class_index);
+    size_t blocks = memmgr_heap_slab_page_blocks(class_index);
+    uint8_t* puc = ((uint8_t*)page) + memmgr_heap_slab_page_header + blocks * block_size;
+    for(size_t i = 0; i < blocks; i++) {
+        puc -= block_size;
+        BlockLink_t* pxBlock = (void*)puc;
+        pxBlock->xBlockSize = block_size;
+        pxBlock->pxNextFreeBlock = page->free_blocks;
+        page->free_blocks = pxBlock;
+    }
+
+    memmgr_heap_slab_page_link(slab_class, page);
+    slab_class->pages++;
+    slab_class->pages_empty++;
+    slab_class->page_allocs++;
+
+    return page;
+}
+
+/* Called with scheduler suspended */
+static void memmgr_heap_slab_page_free(MemmgrHeapSlabPage* page) {
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab[page->class_index];
+    memmgr_heap_slab_page_unlink(slab_class, page);
+    slab_class->pages--;
+    slab_class->pages_empty--;
+
+    xFreeBytesRemaining -= memmgr_heap_slab_page_block_size(page);
+    memmgr_heap_thread_trace_depth++;
+    vPortFree(page);
+    memmgr_heap_thread_trace_depth--;
+}
+
+static void* memmgr_heap_slab_alloc(size_t size) {
+    size_t class_index = memmgr_heap_slab_class_index(size);
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab[class_index];
+    size_t block_size = memmgr_heap_slab_block_size(class_index);
+    void* pvReturn = NULL;
+
+    vTaskSuspendAll();
+    {
+        MemmgrHeapSlabPage* page = slab_class->pages_partial;
+        if(page == NULL) {
+            page = memmgr_heap_slab_page_alloc(class_index);
+        }
+
+        if(page != NULL) {
+            BlockLink_t* pxBlock = page->free_blocks;
+            page->free_blocks = pxBlock->pxNextFreeBlock;
+            if(page->free_blocks == NULL) {
+                memmgr_heap_slab_page_unlink(slab_class, page);
+            }
+            if(page->used++ == 0) {
+                slab_class->pages_empty--;
+            }
+
+            pxBlock->xBlockSize |= xBlockAllocatedBit;
+            pxBlock->pxNextFreeBlock = (void*)page;
+            pvReturn = (void*)(((uint8_t*)pxBlock) + xHeapStructSize);
+
+            xFreeBytesRemaining -= block_size;
+            if(xFreeBytesRemaining < xMinimumEverFreeBytesRemaining) {
+                xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+            }
+
+            slab_class->allocs++;
+            if(++slab_class->used > slab_class->used_max) {
+                slab_class->used_max = slab_class->used;
+            }
+
+            traceMALLOC(pvReturn, block_size);
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return pvReturn;
+}
+
+static void memmgr_heap_slab_free(BlockLink_t* pxLink) {
+    MemmgrHeapSlabPage* page = (void*)pxLink->pxNextFreeBlock;
+    size_t block_size = pxLink->xBlockSize & ~xBlockAllocatedBit;
+    configASSERT(page->class_index < MEMMGR_HEAP_SLAB_CLASSES);
+    configASSERT(block_size == memmgr_heap_slab_block_size(page->class_index));
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab[page->class_index];
+    void* pv = (void*)(((uint8_t*)pxLink) + xHeapStructSize);
+
+    vTaskSuspendAll();
+    {
+        xFreeBytesRemaining += block_size;
+        traceFREE(pv, block_size);
+        memset(pv, 0, block_size - xHeapStructSize);
+
+        pxLink->xBlockSize = block_size;
+        pxLink->pxNextFreeBlock = page->free_blocks;
+        if(page->free_blocks == NULL) {
+            memmgr_heap_slab_page_link(slab_class, page);
+        }
+        page->free_blocks = pxLink;
+        slab_class->used--;
+
+        if(--page->used == 0) {
+            slab_class->pages_empty++;
+            if(!memmgr_heap_slab_page_is_top(page)) {
+                memmgr_heap_slab_page_free(page);
+            }
+        }
+    }
+    (void)xTaskResumeAll();
+}
+#endif
+
+void memmgr_heap_printf_slab_stats() {
+#if MEMMGR_HEAP_SLAB
+    MemmgrHeapSlabClass slab[MEMMGR_HEAP_SLAB_CLASSES];
+
+    osKernelLock();
+    memcpy(slab, memmgr_heap_slab, sizeof(slab));
+    osKernelUnlock();
+
+    printf("Slab caches:\r\n");
+    for(size_t i = 0; i < MEMMGR_HEAP_SLAB_CLASSES; i++) {
+        size_t blocks = memmgr_heap_slab_page_blocks(i);
+        printf(
+            "%4zu: used %zu/%zu, max %zu, pages %zu, empty %zu, allocs %" PRIu32
+            ", page allocs %" PRIu32 "\r\n",
+            MEMMGR_HEAP_SLAB_SIZE_MIN << i,
+            slab[i].used,
+            slab[i].pages * blocks,
+            slab[i].used_max,
+            slab[i].pages,
+            slab[i].pages_empty,
+            slab[i].allocs,
+            slab[i].page_allocs);
+    }
+#else
+    printf("Slab caches: disabled\r\n");
+#endif
+}
+
 size_t memmgr_heap_get_max_free_block() {
     size_t max_free_size = 0;
     BlockLink_t* pxBlock;
@@ -224,16 +526,29 @@ size_t memmgr_heap_get_max_free_block() {
 
 void memmgr_heap_printf_free_blocks() {
     BlockLink_t* pxBlock;
+    size_t blocks = 0;
+    size_t total_size = 0;
+    size_t max_size = 0;
     //TODO enable when we can do printf with a locked scheduler
     //osKernelLock();
 
     pxBlock = xStart.pxNextFreeBlock;
     while(pxBlock->pxNextFreeBlock != NULL) {
-        printf("A %p S %lu\r\n", (void*)pxBlock, (uint32_t)pxBlock->xBlockSize);
+        printf("A %p S %zu\r\n", (void*)pxBlock, pxBlock->xBlockSize);
+        blocks++;
+        total_size += pxBlock->xBlockSize;
+        if(pxBlock->xBlockSize > max_size) max_size = pxBlock->xBlockSize;
         pxBlock = pxBlock->pxNextFreeBlock;
     }
 
     //osKernelUnlock();
+
+    printf(
+        "Free blocks: %zu, total %zu, max %zu, fragmentation %zu%%\r\n",
+        blocks,
+        total_size,
+        max_size,
+        total_size ? 100 - max_size * 100 / total_size : 0);
 }
 /*-----------------------------------------------------------*/
 
@@ -241,6 +556,16 @@ void* pvPortMalloc(size_t xWantedSize) {
     BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
     void* pvReturn = NULL;
 
+#if MEMMGR_HEAP_SLAB
+    /* Small blocks come from slab caches, heap is the fallback */
+    if((xWantedSize > 0) && (xWantedSize <= MEMMGR_HEAP_SLAB_SIZE_MAX)) {
+        pvReturn = memmgr_heap_slab_alloc(xWantedSize);
+        if(pvReturn != NULL) {
+            return pvReturn;
+        }
+    }
+#endif
+
     vTaskSuspendAll();
     {
         /* If this is the first call to malloc then the heap will require
@@ -374,6 +699,15 @@ void vPortFree(void* pv) {
 
         /* Check the block is actually allocated. */
         configASSERT((pxLink->xBlockSize & xBlockAllocatedBit) != 0);
+
+#if MEMMGR_HEAP_SLAB
+        /* Allocated slab block points to its page */
+        if(((pxLink->xBlockSize & xBlockAllocatedBit) != 0) && (pxLink->pxNextFreeBlock != NULL)) {
+            memmgr_heap_slab_free(pxLink);
+            return;
+        }
+#endif
+
         configASSERT(pxLink->pxNextFreeBlock == NULL);
 
         if((pxLink->xBlockSize & xBlockAllocatedBit) != 0) {
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include <cmsis_os2.h>
 
@@ -14,6 +15,25 @@ extern "C" {
 
 #define MEMMGR_HEAP_UNKNOWN 0xFFFFFFFF
 
+/** Slab caches for small blocks. Off: they cut churn of small blocks, but
+ * leave smaller maximum free block than plain heap under mixed load
+ */
+#ifndef MEMMGR_HEAP_SLAB
+#define MEMMGR_HEAP_SLAB 0
+#endif
+
+/** Slab cache size classes: 16, 32, 64, 128 and 256 bytes */
+#define MEMMGR_HEAP_SLAB_CLASSES 5
+#define MEMMGR_HEAP_SLAB_SIZE_MIN ((size_t)16)
+#define MEMMGR_HEAP_SLAB_SIZE_MAX (MEMMGR_HEAP_SLAB_SIZE_MIN << (MEMMGR_HEAP_SLAB_CLASSES - 1))
+
+/** Slab page size, doubled for classes that fit less than
+ * MEMMGR_HEAP_SLAB_PAGE_BLOCKS_MIN blocks in it
+ */
+#define MEMMGR_HEAP_SLAB_PAGE_SIZE ((size_t)1024)
+#define MEMMGR_HEAP_SLAB_PAGE_SIZE_MAX (MEMMGR_HEAP_SLAB_PAGE_SIZE * 2)
+#define MEMMGR_HEAP_SLAB_PAGE_BLOCKS_MIN 4
+
 /** Memmgr heap enable thread allocation tracking
  *
  * @param      thread_id  - thread id to track
@@ -40,10 +60,15 @@ size_t memmgr_heap_get_thread_memory(osThreadId_t thread_id);
  */
 size_t memmgr_heap_get_max_free_block();
 
-/** Print the address and size of all free blocks to stdout
+/** Print the address and size of all free blocks to stdout, then their count,
+ * total size and fragmentation
  */
 void memmgr_heap_printf_free_blocks();
 
+/** Print usage of slab caches per size class to stdout
+ */
+void memmgr_heap_printf_slab_stats();
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,249 @@
+#include "stats.h"
+#include <furi.h>
+#include <furi-hal.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+struct FuriStatsCounter {
+    const char* name;
+    volatile uint32_t value;
+    FuriStatsCounter* next;
+};
+
+struct FuriStatsHistogram {
+    const char* name;
+    const char* unit;
+    volatile uint32_t count;
+    volatile uint32_t max;
+    volatile uint64_t sum;
+    volatile uint32_t buckets[FURI_STATS_HISTOGRAM_BUCKETS];
+    FuriStatsHistogram* next;
+};
+
+struct FuriStatsGroup {
+    const char* name;
+    FuriStatsCounter* counters;
+    FuriStatsHistogram* histograms;
+    FuriStatsGroup* next;
+};
+
+typedef struct {
+    osMutexId_t mutex;
+    FuriStatsGroup* groups;
+} FuriStats;
+
+static FuriStats furi_stats = {0};
+
+void furi_stats_init() {
+    furi_stats.mutex = osMutexNew(NULL);
+    furi_check(furi_stats.mutex);
+}
+
+FuriStatsGroup* furi_stats_group_alloc(const char* name) {
+    furi_assert(name);
+    FuriStatsGroup* group = furi_alloc(sizeof(FuriStatsGroup));
+    group->name = name;
+
+    furi_check(osMutexAcquire(furi_stats.mutex, osWaitForever) == osOK);
+    group->next = furi_stats.groups;
+    furi_stats.groups = group;
+    furi_check(osMutexRelease(furi_stats.mutex) == osOK);
+
+    return group;
+}
+
+void furi_stats_group_free(FuriStatsGroup* group) {
+    furi_assert(group);
+
+    furi_check(osMutexAcquire(furi_stats.mutex, osWaitForever) == osOK);
+    FuriStatsGroup** link = &furi_stats.groups;
+    while(*link != group) {
+        furi_check(*link);
+        link = &(*link)->next;
+    }
+    *link = group->next;
+    furi_check(osMutexRelease(furi_stats.mutex) == osOK);
+
+    while(group->counters) {
+        FuriStatsCounter* counter = group->counters;
+        group->counters = counter->next;
+        free(counter);
+    }
+    while(group->histograms) {
+        FuriStatsHistogram* histogram = group->histograms;
+        group->histograms = histogram->next;
+        free(histogram);
+    }
+    free(group);
+}
+
+void furi_stats_group_reset(FuriStatsGroup* group) {
+    furi_assert(group);
+    for(FuriStatsCounter* counter = group->counters; counter; counter = counter->next) {
+        __atomic_store_n(&counter->value, 0, __ATOMIC_RELAXED);
+    }
+    for(FuriStatsHistogram* histogram = group->histograms; histogram;
+        histogram = histogram->next) {
+        FURI_CRITICAL_ENTER();
+        histogram->count = 0;
+        histogram->max = 0;
+        histogram->sum = 0;
+        for(size_t i = 0; i < FURI_STATS_HISTOGRAM_BUCKETS; i++) {
+            histogram->buckets[i] = 0;
+        }
+        FURI_CRITICAL_EXIT();
+    }
+}
+
+FuriStatsCounter* furi_stats_counter_alloc(FuriStatsGroup* group, const char* name) {
+    furi_assert(group);
+    furi_assert(name);
+    FuriStatsCounter* counter = furi_alloc(sizeof(FuriStatsCounter));
+    counter->name = name;
+
+    // Keep allocation order, it is the print order
+    FuriStatsCounter** link = &group->counters;
+    while(*link) link = &(*link)->next;
+    *link = counter;
+
+    return counter;
+}
+
+void furi_stats_counter_add(FuriStatsCounter* counter, uint32_t value) {
+    __atomic_fetch_add(&counter->value, value, __ATOMIC_RELAXED);
+}
+
+void furi_stats_counter_max(FuriStatsCounter* counter, uint32_t value) {
+    uint32_t current = __atomic_load_n(&counter->value, __ATOMIC_RELAXED);
+    while(value > current) {
+        // On failure current is reloaded, retry while value is still bigger
+        if(__atomic_compare_exchange_n(
+               &counter->value, &current, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+}
+
+uint32_t furi_stats_counter_get(FuriStatsCounter* counter) {
+    furi_assert(counter);
+    return __atomic_load_n(&counter->value, __ATOMIC_RELAXED);
+}
+
+FuriStatsHistogram*
+    furi_stats_histogram_alloc(FuriStatsGroup* group, const char* name, const char* unit) {
+    furi_assert(group);
+    furi_assert(name);
+    FuriStatsHistogram* histogram = furi_alloc(sizeof(FuriStatsHistogram));
+    histogram->name = name;
+    histogram->unit = unit ? unit : "";
+
+    FuriStatsHistogram** link = &group->histograms;
+    while(*link) link = &(*link)->next;
+    *link = histogram;
+
+    return histogram;
+}
+
+void furi_stats_histogram_add(FuriStatsHistogram* histogram, uint32_t value) {
+    size_t bucket = value ? 32 - __builtin_clz(value) : 0;
+    if(bucket >= FURI_STATS_HISTOGRAM_BUCKETS) bucket = FURI_STATS_HISTOGRAM_BUCKETS - 1;
+
+    // 64 bit sum can't be updated atomically on Cortex-M4
+    FURI_CRITICAL_ENTER();
+    histogram->buckets[bucket]++;
+    histogram->count++;
+    histogram->sum += value;
+    if(value > histogram->max) histogram->max = value;
+    FURI_CRITICAL_EXIT();
+}
+
+uint32_t furi_stats_histogram_get_count(FuriStatsHistogram* histogram) {
+    furi_assert(histogram);
+    return __atomic_load_n(&histogram->count, __ATOMIC_RELAXED);
+}
+
+uint32_t furi_stats_histogram_get_bucket(FuriStatsHistogram* histogram, size_t bucket) {
+    furi_assert(histogram);
+    furi_assert(bucket < FURI_STATS_HISTOGRAM_BUCKETS);
+    return __atomic_load_n(&histogram->buckets[bucket], __ATOMIC_RELAXED);
+}
+
+uint32_t furi_stats_timer_start() {
+    return furi_hal_delay_get_cycles();
+}
+
+void furi_stats_timer_stop(FuriStatsHistogram* histogram, uint32_t start) {
+    uint32_t cycles = furi_hal_delay_get_cycles() - start;
+    furi_stats_histogram_add(histogram, cycles / (SystemCoreClock / 1000000));
+}
+
+static bool furi_stats_group_match(FuriStatsGroup* group, const char* filter) {
+    return !filter || strncmp(group->name, filter, strlen(filter)) == 0;
+}
+
+static void furi_stats_histogram_print(FuriStatsHistogram* histogram) {
+    // Consistent copy, producers keep adding while it is printed
+    FuriStatsHistogram copy;
+
+    FURI_CRITICAL_ENTER();
+    copy = *histogram;
+    FURI_CRITICAL_EXIT();
+
+    uint32_t count = copy.count;
+    const char* unit = copy.unit;
+
+    printf("  %s: %" PRIu32, copy.name, count);
+    if(count) {
+        printf(
+            ", avg %" PRIu32 "%s, max %" PRIu32 "%s",
+            (uint32_t)(copy.sum / count),
+            unit,
+            copy.max,
+            unit);
+    }
+    printf("\r\n");
+
+    for(size_t i = 0; i < FURI_STATS_HISTOGRAM_BUCKETS; i++) {
+        uint32_t bucket = copy.buckets[i];
+        if(!bucket) continue;
+        if(i < 2) {
+            printf("    %zu%s", i, unit);
+        } else if(i == FURI_STATS_HISTOGRAM_BUCKETS - 1) {
+            printf("    %u%s+", 1U << (i - 1), unit);
+        } else {
+            printf("    %u-%u%s", 1U << (i - 1), (1U << i) - 1, unit);
+        }
+        printf(": %" PRIu32 "\r\n", bucket);
+    }
+}
+
+size_t furi_stats_print(const char* filter) {
+    size_t printed = 0;
+
+    furi_check(osMutexAcquire(furi_stats.mutex, osWaitForever) == osOK);
+    for(FuriStatsGroup* group = furi_stats.groups; group; group = group->next) {
+        if(!furi_stats_group_match(group, filter)) continue;
+
+        printf("%s\r\n", group->name);
+        for(FuriStatsCounter* counter = group->counters; counter; counter = counter->next) {
+            printf("  %s: %" PRIu32 "\r\n", counter->name, furi_stats_counter_get(counter));
+        }
+        for(FuriStatsHistogram* histogram = group->histograms; histogram;
+            histogram = histogram->next) {
+            furi_stats_histogram_print(histogram);
+        }
+        printed++;
+    }
+    furi_check(osMutexRelease(furi_stats.mutex) == osOK);
+
+    return printed;
+}
+
+void furi_stats_reset(const char* filter) {
+    furi_check(osMutexAcquire(furi_stats.mutex, osWaitForever) == osOK);
+    for(FuriStatsGroup* group = furi_stats.groups; group; group = group->next) {
+        if(furi_stats_group_match(group, filter)) furi_stats_group_reset(group);
+    }
+    furi_check(osMutexRelease(furi_stats.mutex) == osOK);
+}
@@ -0,0 +1,148 @@
+/**
+ * @file stats.h
+ * Furi: counters, histograms and latency timers published by workers
+ *
+ * Worker allocates a group with its counters and histograms once and updates
+ * them from its thread or ISR, `stats` CLI command prints them.
+ * Counters are updated with atomic instructions, histograms in a short
+ * critical section, so updates from several contexts and reset don't race.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Histogram buckets: 0, 1, 2-3, 4-7, ... and 16384+ */
+#define FURI_STATS_HISTOGRAM_BUCKETS 16
+
+typedef struct FuriStatsGroup FuriStatsGroup;
+
+typedef struct FuriStatsCounter FuriStatsCounter;
+
+typedef struct FuriStatsHistogram FuriStatsHistogram;
+
+/** Init stats registry, called by furi_init */
+void furi_stats_init();
+
+/** Allocate and register group
+ *
+ * @param      name  group name, must outlive the group
+ *
+ * @return     group instance
+ */
+FuriStatsGroup* furi_stats_group_alloc(const char* name);
+
+/** Unregister and free group with its counters and histograms
+ *
+ * @param      group  group instance
+ */
+void furi_stats_group_free(FuriStatsGroup* group);
+
+/** Zero all counters and histograms of the group
+ *
+ * @param      group  group instance
+ */
+void furi_stats_group_reset(FuriStatsGroup* group);
+
+/** Allocate counter in group
+ *
+ * @param      group  group instance
+ * @param      name   counter name, must outlive the group
+ *
+ * @return     counter instance, freed with group
+ */
+FuriStatsCounter* furi_stats_counter_alloc(FuriStatsGroup* group, const char* name);
+
+/** Add to counter, ISR safe
+ *
+ * @param      counter  counter instance
+ * @param      value    value to add
+ */
+void furi_stats_counter_add(FuriStatsCounter* counter, uint32_t value);
+
+/** Raise counter to value if it is bigger, for high-water marks, ISR safe
+ *
+ * @param      counter  counter instance
+ * @param      value    current value
+ */
+void furi_stats_counter_max(FuriStatsCounter* counter, uint32_t value);
+
+/** Get counter value
+ *
+ * @param      counter  counter instance
+ *
+ * @return     counter value
+ */
+uint32_t furi_stats_counter_get(FuriStatsCounter* counter);
+
+/** Allocate histogram in group
+ *
+ * @param      group  group instance
+ * @param      name   histogram name, must outlive the group
+ * @param      unit   unit of values, printed after them
+ *
+ * @return     histogram instance, freed with group
+ */
+FuriStatsHistogram*
+    furi_stats_histogram_alloc(FuriStatsGroup* group, const char* name, const char* unit);
+
+/** Add value to histogram, ISR safe
+ *
+ * @param      histogram  histogram instance
+ * @param      value      value
+ */
+void furi_stats_histogram_add(FuriStatsHistogram* histogram, uint32_t value);
+
+/** Get count of values added to histogram
+ *
+ * @param      histogram  histogram instance
+ *
+ * @return     values count
+ */
+uint32_t furi_stats_histogram_get_count(FuriStatsHistogram* histogram);
+
+/** Get count of values that fell into histogram bucket
+ *
+ * @param      histogram  histogram instance
+ * @param      bucket     bucket index, less than FURI_STATS_HISTOGRAM_BUCKETS
+ *
+ * @return     values count
+ */
+uint32_t furi_stats_histogram_get_bucket(FuriStatsHistogram* histogram, size_t bucket);
+
+/** Start latency timer, ISR safe
+ *
+ * @return     timer start, DWT cycles
+ */
+uint32_t furi_stats_timer_start();
+
+/** Add time since timer start to histogram, in us, ISR safe
+ *
+ * @param      histogram  histogram instance, unit should be "us"
+ * @param      start      value returned by furi_stats_timer_start
+ */
+void furi_stats_timer_stop(FuriStatsHistogram* histogram, uint32_t start);
+
+/** Print groups to stdout
+ *
+ * @param      filter  print groups which name starts with filter, NULL for all
+ *
+ * @return     groups printed
+ */
+size_t furi_stats_print(const char* filter);
+
+/** Zero groups
+ *
+ * @param      filter  reset groups which name starts with filter, NULL for all
+ */
+void furi_stats_reset(const char* filter);
+
+#ifdef __cplusplus
+}
+#endif
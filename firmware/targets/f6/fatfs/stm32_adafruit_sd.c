@@ -79,6 +79,8 @@
      o The micro SD card can be accessed with read/write block(s) operations once 
        it is ready for access. The access can be performed in polling 
        mode by calling the functions BSP_SD_ReadBlocks()/BSP_SD_WriteBlocks()
+     o Several blocks are transferred with one CMD18/CMD25 and block data is
+       moved by DMA
        
      o The SD erase block(s) is performed using the function BSP_SD_Erase() with 
        specifying the number of blocks to erase.
@@ -161,7 +163,7 @@ typedef enum {
 #define SD_TOKEN_START_DATA_SINGLE_BLOCK_WRITE \
     0xFE /* Data token start byte, Start Single Block Write */
 #define SD_TOKEN_START_DATA_MULTIPLE_BLOCK_WRITE \
-    0xFD /* Data token start byte, Start Multiple Block Write */
+    0xFC /* Data token start byte, Start Multiple Block Write */
 #define SD_TOKEN_STOP_DATA_MULTIPLE_BLOCK_WRITE \
     0xFD /* Data toke stop byte, Stop Multiple Block Write */
 
@@ -269,6 +271,10 @@ static uint8_t SD_GoIdleState(void);
 static SD_CmdAnswer_typedef SD_SendCmd(uint8_t Cmd, uint32_t Arg, uint8_t Crc, uint8_t Answer);
 static uint8_t SD_WaitData(uint8_t data);
 static uint8_t SD_ReadData(void);
+static uint8_t SD_StopTransmission(void);
+static uint8_t SD_ReadBlocksMultiple(uint8_t* pData, uint32_t ReadAddr, uint32_t NumOfBlocks);
+static uint8_t
+    SD_WriteBlocksMultiple(const uint8_t* pData, uint32_t WriteAddr, uint32_t NumOfBlocks);
 /** @defgroup STM32_ADAFRUIT_SD_Private_Function_Prototypes
   * @{
   */
@@ -405,6 +411,11 @@ BSP_SD_ReadBlocks(uint32_t* pData, uint32_t ReadAddr, uint32_t NumOfBlocks, uint
         goto error;
     }
 
+    if(NumOfBlocks > 1) {
+        retr = SD_ReadBlocksMultiple((uint8_t*)pData, ReadAddr, NumOfBlocks);
+        goto error;
+    }
+
     ptr = malloc(sizeof(uint8_t) * BlockSize);
     if(ptr == NULL) {
         goto error;
@@ -483,6 +494,11 @@ BSP_SD_WriteBlocks(uint32_t* pData, uint32_t WriteAddr, uint32_t NumOfBlocks, ui
         goto error;
     }
 
+    if(NumOfBlocks > 1) {
+        retr = SD_WriteBlocksMultiple((uint8_t*)pData, WriteAddr, NumOfBlocks);
+        goto error;
+    }
+
     ptr = malloc(sizeof(uint8_t) * BlockSize);
     if(ptr == NULL) {
         goto error;
@@ -545,6 +561,98 @@ error:
   * @param  EndAddr: End address in Blocks (Size of a block is 512bytes)
   * @retval SD status
   */
+/**
+  * @brief  Reads consecutive blocks with one CMD18, block data is moved by DMA
+  * @param  pData: Pointer to the buffer that will contain the data to transmit
+  * @param  ReadAddr: Address from where data is to be read
+  * @param  NumOfBlocks: Number of SD blocks to read
+  * @retval SD status
+  */
+static uint8_t SD_ReadBlocksMultiple(uint8_t* pData, uint32_t ReadAddr, uint32_t NumOfBlocks) {
+    uint8_t retr = BSP_SD_OK;
+    SD_CmdAnswer_typedef response;
+    uint16_t BlockSize = 512;
+    uint32_t addr = (ReadAddr * ((flag_SDHC == 1) ? 1 : BlockSize));
+
+    /* Send CMD18 (SD_CMD_READ_MULT_BLOCK), card sends blocks until CMD12 */
+    response = SD_SendCmd(SD_CMD_READ_MULT_BLOCK, addr, 0xFF, SD_ANSWER_R1_EXPECTED);
+    if(response.r1 != SD_R1_NO_ERROR) {
+        return BSP_SD_ERROR;
+    }
+
+    while(NumOfBlocks--) {
+        if(SD_WaitData(SD_TOKEN_START_DATA_MULTIPLE_BLOCK_READ) != BSP_SD_OK) {
+            retr = BSP_SD_ERROR;
+            break;
+        }
+
+        SD_IO_ReadDataDma(pData, BlockSize);
+        pData += BlockSize;
+
+        /* get CRC bytes (not really needed by us, but required by SD) */
+        SD_IO_WriteByte(SD_DUMMY_BYTE);
+        SD_IO_WriteByte(SD_DUMMY_BYTE);
+    }
+
+    /* Transfer must be stopped even if it failed */
+    if(SD_StopTransmission() != BSP_SD_OK) {
+        retr = BSP_SD_ERROR;
+    }
+
+    return retr;
+}
+
+/**
+  * @brief  Writes consecutive blocks with one CMD25, block data is moved by DMA
+  * @param  pData: Pointer to the buffer that will contain the data to transmit
+  * @param  WriteAddr: Address from where data is to be written
+  * @param  NumOfBlocks: Number of SD blocks to write
+  * @retval SD status
+  */
+static uint8_t
+    SD_WriteBlocksMultiple(const uint8_t* pData, uint32_t WriteAddr, uint32_t NumOfBlocks) {
+    uint8_t retr = BSP_SD_OK;
+    SD_CmdAnswer_typedef response;
+    uint16_t BlockSize = 512;
+    uint32_t addr = (WriteAddr * ((flag_SDHC == 1) ? 1 : BlockSize));
+
+    /* Send CMD25 (SD_CMD_WRITE_MULT_BLOCK), card takes blocks until stop token */
+    response = SD_SendCmd(SD_CMD_WRITE_MULT_BLOCK, addr, 0xFF, SD_ANSWER_R1_EXPECTED);
+    if(response.r1 != SD_R1_NO_ERROR) {
+        return BSP_SD_ERROR;
+    }
+
+    /* Send dummy byte for NWR timing : one byte between CMDWRITE and TOKEN */
+    SD_IO_WriteByte(SD_DUMMY_BYTE);
+    SD_IO_WriteByte(SD_DUMMY_BYTE);
+
+    while(NumOfBlocks--) {
+        SD_IO_WriteByte(SD_TOKEN_START_DATA_MULTIPLE_BLOCK_WRITE);
+        SD_IO_WriteDataDma(pData, BlockSize);
+        pData += BlockSize;
+
+        /* Put CRC bytes (not really needed by us, but required by SD) */
+        SD_IO_WriteByte(SD_DUMMY_BYTE);
+        SD_IO_WriteByte(SD_DUMMY_BYTE);
+
+        /* Data response, then card holds line low while block is programmed */
+        if((SD_IO_WriteByte(SD_DUMMY_BYTE) & 0x1F) != SD_DATA_OK) {
+            retr = BSP_SD_ERROR;
+            break;
+        }
+        while(SD_IO_WriteByte(SD_DUMMY_BYTE) != 0xFF)
+            ;
+    }
+
+    /* Stop token ends the transfer, even if it failed */
+    SD_IO_WriteByte(SD_TOKEN_STOP_DATA_MULTIPLE_BLOCK_WRITE);
+    SD_IO_WriteByte(SD_DUMMY_BYTE);
+    while(SD_IO_WriteByte(SD_DUMMY_BYTE) != 0xFF)
+        ;
+
+    return retr;
+}
+
 uint8_t BSP_SD_Erase(uint32_t StartAddr, uint32_t EndAddr) {
     uint8_t retr = BSP_SD_ERROR;
     SD_CmdAnswer_typedef response;
@@ -909,6 +1017,31 @@ uint8_t SD_GetDataResponse(void) {
   * @param  None
   * @retval SD status
   */
+/**
+  * @brief  Sends CMD12 to end multiple block read and waits until card is ready
+  * @retval SD status
+  */
+uint8_t SD_StopTransmission(void) {
+    uint8_t frame[SD_CMD_LENGTH] = {(SD_CMD_STOP_TRANSMISSION | 0x40), 0, 0, 0, 0, 0xFF};
+    uint8_t frameout[SD_CMD_LENGTH];
+    uint8_t timeout = 0x08;
+    uint8_t r1;
+
+    SD_IO_WriteReadData(frame, frameout, SD_CMD_LENGTH);
+    /* Skip stuff byte, then data that card may still be sending: R1 has MSB cleared */
+    SD_IO_WriteByte(SD_DUMMY_BYTE);
+    do {
+        r1 = SD_IO_WriteByte(SD_DUMMY_BYTE);
+        timeout--;
+    } while((r1 & 0x80) && timeout);
+
+    /* Wait IO line return 0xFF */
+    while(SD_IO_WriteByte(SD_DUMMY_BYTE) != 0xFF)
+        ;
+
+    return (r1 == SD_R1_NO_ERROR) ? BSP_SD_OK : BSP_SD_ERROR;
+}
+
 uint8_t SD_GoIdleState(void) {
     SD_CmdAnswer_typedef response;
     __IO uint8_t counter;
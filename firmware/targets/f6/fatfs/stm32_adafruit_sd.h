@@ -223,6 +223,8 @@ void    SD_IO_Init(void);
 void    SD_IO_CSState(uint8_t state);
 void    SD_IO_WriteReadData(const uint8_t *DataIn, uint8_t *DataOut, uint16_t DataLength);
 uint8_t SD_IO_WriteByte(uint8_t Data);
+void    SD_IO_ReadDataDma(uint8_t *DataOut, uint16_t DataLength);
+void    SD_IO_WriteDataDma(const uint8_t *DataIn, uint16_t DataLength);
 
 /* Link function for HAL delay */
 void HAL_Delay(__IO uint32_t Delay);
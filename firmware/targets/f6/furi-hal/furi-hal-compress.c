@@ -80,7 +80,8 @@ void furi_hal_compress_icon_decode(const uint8_t* icon_data, uint8_t** decoded_b
 
 FuriHalCompress* furi_hal_compress_alloc(uint16_t compress_buff_size) {
     FuriHalCompress* compress = furi_alloc(sizeof(FuriHalCompress));
-    compress->compress_buff = furi_alloc(compress_buff_size + FURI_HAL_COMPRESS_EXP_BUFF_SIZE);
+    compress->compress_buff_size = compress_buff_size + FURI_HAL_COMPRESS_EXP_BUFF_SIZE;
+    compress->compress_buff = furi_alloc(compress->compress_buff_size);
     compress->encoder = heatshrink_encoder_alloc(compress->compress_buff, FURI_HAL_COMPRESS_EXP_BUFF_SIZE_LOG, FURI_HAL_COMPRESS_LOOKAHEAD_BUFF_SIZE_LOG);
     compress->decoder = heatshrink_decoder_alloc(compress->compress_buff, compress_buff_size, FURI_HAL_COMPRESS_EXP_BUFF_SIZE_LOG, FURI_HAL_COMPRESS_LOOKAHEAD_BUFF_SIZE_LOG);
 
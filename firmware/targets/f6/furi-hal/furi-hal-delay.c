@@ -34,3 +34,7 @@ void delay(float milliseconds) {
 uint32_t millis(void){
     return HAL_GetTick();
 }
+
+uint32_t furi_hal_delay_get_cycles(void) {
+    return DWT->CYCCNT;
+}
@@ -24,6 +24,9 @@ void furi_hal_interrupt_init() {
     NVIC_SetPriority(DMA1_Channel1_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 5, 0));
     NVIC_EnableIRQ(DMA1_Channel1_IRQn);
 
+    NVIC_SetPriority(DMA2_Channel3_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 5, 0));
+    NVIC_EnableIRQ(DMA2_Channel3_IRQn);
+
     FURI_LOG_I(TAG, "Init OK");
 }
 
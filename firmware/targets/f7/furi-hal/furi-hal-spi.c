@@ -1,16 +1,33 @@
 #include "furi-hal-spi.h"
 #include "furi-hal-resources.h"
+#include "furi-hal-interrupt.h"
 
 #include <stdbool.h>
 #include <string.h>
 #include <furi.h>
 
 #include <stm32wbxx_ll_spi.h>
+#include <stm32wbxx_ll_dma.h>
 #include <stm32wbxx_ll_utils.h>
 #include <stm32wbxx_ll_cortex.h>
 
 #define TAG "FuriHalSpi"
 
+/* One channel pair is shared by all buses, transfers are serialized with mutex */
+#define FURI_HAL_SPI_DMA DMA2
+#define FURI_HAL_SPI_DMA_RX_CHANNEL LL_DMA_CHANNEL_3
+#define FURI_HAL_SPI_DMA_TX_CHANNEL LL_DMA_CHANNEL_4
+
+static osMutexId_t furi_hal_spi_dma_mutex = NULL;
+static osSemaphoreId_t furi_hal_spi_dma_completed = NULL;
+
+static void furi_hal_spi_dma_isr() {
+    if(LL_DMA_IsActiveFlag_TC3(FURI_HAL_SPI_DMA)) {
+        LL_DMA_ClearFlag_TC3(FURI_HAL_SPI_DMA);
+        osSemaphoreRelease(furi_hal_spi_dma_completed);
+    }
+}
+
 void furi_hal_spi_init() {
     furi_hal_spi_bus_init(&furi_hal_spi_bus_r);
     furi_hal_spi_bus_init(&furi_hal_spi_bus_d);
@@ -21,6 +38,11 @@ void furi_hal_spi_init() {
     furi_hal_spi_bus_handle_init(&furi_hal_spi_bus_handle_sd_fast);
     furi_hal_spi_bus_handle_init(&furi_hal_spi_bus_handle_sd_slow);
 
+    furi_hal_spi_dma_mutex = osMutexNew(NULL);
+    furi_hal_spi_dma_completed = osSemaphoreNew(1, 0, NULL);
+    furi_hal_interrupt_set_dma_channel_isr(
+        FURI_HAL_SPI_DMA, FURI_HAL_SPI_DMA_RX_CHANNEL, furi_hal_spi_dma_isr);
+
     FURI_LOG_I(TAG, "Init OK");
 }
 
@@ -138,3 +160,68 @@ bool furi_hal_spi_bus_trx(FuriHalSpiBusHandle* handle, uint8_t* tx_buffer, uint8
 
     return ret;
 }
+
+bool furi_hal_spi_bus_trx_dma(FuriHalSpiBusHandle* handle, uint8_t* tx_buffer, uint8_t* rx_buffer, size_t size, uint32_t timeout) {
+    furi_assert(handle);
+    furi_assert(handle->bus->current_handle == handle);
+    furi_assert(size > 0 && size <= UINT16_MAX);
+
+    // Single byte without memory increment stands in for missing buffer
+    static uint8_t dma_dummy_tx = 0xFF;
+    static uint8_t dma_dummy_rx;
+    SPI_TypeDef* spi = handle->bus->spi;
+    bool ret = true;
+
+    furi_check(osMutexAcquire(furi_hal_spi_dma_mutex, osWaitForever) == osOK);
+
+    LL_DMA_InitTypeDef dma_config = {0};
+    dma_config.PeriphOrM2MSrcAddress = LL_SPI_DMA_GetRegAddr(spi);
+    dma_config.Mode = LL_DMA_MODE_NORMAL;
+    dma_config.PeriphOrM2MSrcIncMode = LL_DMA_PERIPH_NOINCREMENT;
+    dma_config.PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_BYTE;
+    dma_config.MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_BYTE;
+    dma_config.NbData = size;
+
+    // RX goes first and has higher priority, so received data never overruns
+    dma_config.MemoryOrM2MDstAddress = (uint32_t)(rx_buffer ? rx_buffer : &dma_dummy_rx);
+    dma_config.Direction = LL_DMA_DIRECTION_PERIPH_TO_MEMORY;
+    dma_config.MemoryOrM2MDstIncMode = rx_buffer ? LL_DMA_MEMORY_INCREMENT :
+                                                   LL_DMA_MEMORY_NOINCREMENT;
+    dma_config.PeriphRequest = (spi == SPI1) ? LL_DMAMUX_REQ_SPI1_RX : LL_DMAMUX_REQ_SPI2_RX;
+    dma_config.Priority = LL_DMA_PRIORITY_HIGH;
+    LL_DMA_Init(FURI_HAL_SPI_DMA, FURI_HAL_SPI_DMA_RX_CHANNEL, &dma_config);
+
+    dma_config.MemoryOrM2MDstAddress = (uint32_t)(tx_buffer ? tx_buffer : &dma_dummy_tx);
+    dma_config.Direction = LL_DMA_DIRECTION_MEMORY_TO_PERIPH;
+    dma_config.MemoryOrM2MDstIncMode = tx_buffer ? LL_DMA_MEMORY_INCREMENT :
+                                                   LL_DMA_MEMORY_NOINCREMENT;
+    dma_config.PeriphRequest = (spi == SPI1) ? LL_DMAMUX_REQ_SPI1_TX : LL_DMAMUX_REQ_SPI2_TX;
+    dma_config.Priority = LL_DMA_PRIORITY_MEDIUM;
+    LL_DMA_Init(FURI_HAL_SPI_DMA, FURI_HAL_SPI_DMA_TX_CHANNEL, &dma_config);
+
+    LL_SPI_SetRxFIFOThreshold(spi, LL_SPI_RX_FIFO_TH_QUARTER);
+    LL_DMA_EnableIT_TC(FURI_HAL_SPI_DMA, FURI_HAL_SPI_DMA_RX_CHANNEL);
+    LL_SPI_EnableDMAReq_RX(spi);
+    LL_DMA_EnableChannel(FURI_HAL_SPI_DMA, FURI_HAL_SPI_DMA_RX_CHANNEL);
+    LL_DMA_EnableChannel(FURI_HAL_SPI_DMA, FURI_HAL_SPI_DMA_TX_CHANNEL);
+    LL_SPI_EnableDMAReq_TX(spi);
+
+    // Last received byte means that the whole transfer is done
+    if(osSemaphoreAcquire(furi_hal_spi_dma_completed, timeout) != osOK) {
+        ret = false;
+    }
+
+    LL_SPI_DisableDMAReq_TX(spi);
+    LL_SPI_DisableDMAReq_RX(spi);
+    LL_DMA_DisableIT_TC(FURI_HAL_SPI_DMA, FURI_HAL_SPI_DMA_RX_CHANNEL);
+    LL_DMA_DisableChannel(FURI_HAL_SPI_DMA, FURI_HAL_SPI_DMA_TX_CHANNEL);
+    LL_DMA_DisableChannel(FURI_HAL_SPI_DMA, FURI_HAL_SPI_DMA_RX_CHANNEL);
+    // Completion that raced with timeout must not leak into next transfer
+    osSemaphoreAcquire(furi_hal_spi_dma_completed, 0);
+
+    furi_hal_spi_bus_end_txrx(handle, timeout);
+
+    furi_check(osMutexRelease(furi_hal_spi_dma_mutex) == osOK);
+
+    return ret;
+}
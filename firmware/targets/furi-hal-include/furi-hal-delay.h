@@ -36,6 +36,15 @@ void delay_us(float microseconds);
  */
 uint32_t millis(void);
 
+/** Get DWT cycle counter
+ *
+ * Runs at SystemCoreClock and wraps around, use difference of two values.
+ * Can be used in ISR.
+ *
+ * @return     Current cycle count
+ */
+uint32_t furi_hal_delay_get_cycles(void);
+
 #ifdef __cplusplus
 }
 #endif
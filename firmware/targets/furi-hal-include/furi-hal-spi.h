@@ -84,6 +84,20 @@ bool furi_hal_spi_bus_tx(FuriHalSpiBusHandle* handle, uint8_t* buffer, size_t si
  */
 bool furi_hal_spi_bus_trx(FuriHalSpiBusHandle* handle, uint8_t* tx_buffer, uint8_t* rx_buffer, size_t size, uint32_t timeout);
 
+/** SPI Transmit and Receive with DMA
+ *
+ * Calling thread sleeps while DMA moves data, so CPU is free for other threads
+ *
+ * @param      handle     pointer to FuriHalSpiBusHandle instance
+ * @param      tx_buffer  pointer to tx buffer, NULL to transmit 0xFF
+ * @param      rx_buffer  pointer to rx buffer, NULL to discard received data
+ * @param      size       transaction size (buffer size), up to 65535
+ * @param      timeout    operation timeout in ms
+ *
+ * @return     true on success
+ */
+bool furi_hal_spi_bus_trx_dma(FuriHalSpiBusHandle* handle, uint8_t* tx_buffer, uint8_t* rx_buffer, size_t size, uint32_t timeout);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <furi.h>
+#include <storage/storage.h>
+#include <edge-replay.h>
+
+#define BENCHMARK_ROUNDS 20
+#define BENCHMARK_PACKETS 8
+#define BENCHMARK_SEEDS 4
+#define BENCHMARK_CAPTURES_MAX 256
+
+/* Edge shift of generated captures, us */
+static const uint32_t benchmark_jitters[] = {0, 2, 4, 8, 16, 32};
+
+static const uint8_t benchmark_keys[EdgeProtocolMax][EDGE_CAPTURE_KEY_SIZE] = {
+    [EdgeProtocolEM4100] = {0x01, 0x23, 0x45, 0x67, 0x89},
+    [EdgeProtocolH10301] = {0x71, 0x12, 0x34},
+    [EdgeProtocolI40134] = {0x55, 0x01, 0x02},
+    [EdgeProtocolCyfral] = {0x5A, 0xC3},
+    [EdgeProtocolMetakom] = {0x03, 0x05, 0x06, 0x0F},
+};
+
+typedef struct {
+    EdgeCapture* captures[BENCHMARK_CAPTURES_MAX];
+    uint32_t jitters[BENCHMARK_CAPTURES_MAX]; /**< UINT32_MAX for loaded captures */
+    size_t count;
+} BenchmarkCorpus;
+
+typedef struct {
+    size_t captures; /**< Captures of decoder protocol */
+    size_t decoded; /**< ...with the key read at least once */
+    size_t false_reads; /**< Wrong keys and keys read from other protocols */
+    size_t edges;
+    uint64_t time_ns;
+} BenchmarkStats;
+
+static void benchmark_corpus_generate(BenchmarkCorpus* corpus) {
+    for(size_t protocol = 0; protocol < EdgeProtocolMax; protocol++) {
+        for(size_t j = 0; j < COUNT_OF(benchmark_jitters); j++) {
+            for(uint32_t seed = 1; seed <= BENCHMARK_SEEDS; seed++) {
+                furi_check(corpus->count < BENCHMARK_CAPTURES_MAX);
+                EdgeCapture* capture = edge_capture_alloc();
+                edge_capture_generate(
+                    capture,
+                    protocol,
+                    benchmark_keys[protocol],
+                    BENCHMARK_PACKETS,
+                    benchmark_jitters[j],
+                    seed);
+                corpus->jitters[corpus->count] = benchmark_jitters[j];
+                corpus->captures[corpus->count++] = capture;
+            }
+        }
+    }
+}
+
+static bool benchmark_corpus_load(BenchmarkCorpus* corpus, int argc, char* argv[]) {
+    Storage* storage = furi_record_open("storage");
+    bool result = true;
+
+    for(int i = 1; i < argc && corpus->count < BENCHMARK_CAPTURES_MAX; i++) {
+        EdgeCapture* capture = edge_capture_alloc();
+        if(!edge_capture_load(capture, storage, argv[i])) {
+            printf("Can't load %s\n", argv[i]);
+            edge_capture_free(capture);
+            result = false;
+            break;
+        }
+        corpus->jitters[corpus->count] = UINT32_MAX;
+        corpus->captures[corpus->count++] = capture;
+    }
+
+    furi_record_close("storage");
+    return result;
+}
+
+/* Every decoder sees every capture, as reader runs all of them on the same edges */
+static void
+    benchmark_run(BenchmarkCorpus* corpus, size_t from, size_t to, BenchmarkStats* stats) {
+    for(size_t i = from; i < to; i++) {
+        EdgeCapture* capture = corpus->captures[i];
+        EdgeProtocol expected = edge_capture_get_protocol(capture);
+
+        for(size_t decoder = 0; decoder < EdgeProtocolMax; decoder++) {
+            EdgeReplayResult result = {0};
+            edge_replay_run(capture, decoder, &result);
+            for(size_t round = 1; round < BENCHMARK_ROUNDS; round++) {
+                EdgeReplayResult timing = {0};
+                edge_replay_run(capture, decoder, &timing);
+                result.time_ns += timing.time_ns;
+                result.edges += timing.edges;
+            }
+
+            if(decoder == expected) {
+                stats[decoder].captures++;
+                if(result.matches) stats[decoder].decoded++;
+            }
+            stats[decoder].false_reads += result.reads - result.matches;
+            stats[decoder].edges += result.edges;
+            stats[decoder].time_ns += result.time_ns;
+        }
+    }
+}
+
+static void benchmark_print(const char* title, BenchmarkStats* stats) {
+    printf("%s\n", title);
+    printf(
+        "%-10s %8s %8s %8s %12s %14s\n",
+        "decoder",
+        "captures",
+        "decoded",
+        "false",
+        "ns/edge",
+        "Medges/s");
+    for(size_t decoder = 0; decoder < EdgeProtocolMax; decoder++) {
+        BenchmarkStats* s = &stats[decoder];
+        printf(
+            "%-10s %8zu %7.0f%% %8zu %12.1f %14.2f\n",
+            edge_protocol_get_name(decoder),
+            s->captures,
+            s->captures ? 100.0 * s->decoded / s->captures : 0.0,
+            s->false_reads,
+            (double)s->time_ns / s->edges,
+            s->edges * 1000.0 / s->time_ns);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    furi_init();
+    BenchmarkCorpus* corpus = furi_alloc(sizeof(BenchmarkCorpus));
+    int result = 0;
+
+    if(argc > 1) {
+        if(!benchmark_corpus_load(corpus, argc, argv)) result = 1;
+        if(corpus->count) {
+            BenchmarkStats stats[EdgeProtocolMax] = {0};
+            benchmark_run(corpus, 0, corpus->count, stats);
+            benchmark_print("captures", stats);
+        }
+    } else {
+        benchmark_corpus_generate(corpus);
+
+        // Corpus is ordered by protocol, then jitter: report each jitter separately
+        for(size_t j = 0; j < COUNT_OF(benchmark_jitters); j++) {
+            BenchmarkStats stats[EdgeProtocolMax] = {0};
+            for(size_t i = 0; i < corpus->count; i += BENCHMARK_SEEDS) {
+                if(corpus->jitters[i] == benchmark_jitters[j]) {
+                    benchmark_run(corpus, i, i + BENCHMARK_SEEDS, stats);
+                }
+            }
+            char title[32];
+            snprintf(title, sizeof(title), "edge jitter %uus", benchmark_jitters[j]);
+            benchmark_print(title, stats);
+
+            // Clean captures must decode, jitter tolerance is up to decoders
+            for(size_t decoder = 0; benchmark_jitters[j] == 0 && decoder < EdgeProtocolMax;
+                decoder++) {
+                if(stats[decoder].decoded != stats[decoder].captures) {
+                    printf("FAILED: %s clean captures\n", edge_protocol_get_name(decoder));
+                    result = 1;
+                }
+            }
+        }
+    }
+
+    for(size_t i = 0; i < corpus->count; i++) {
+        edge_capture_free(corpus->captures[i]);
+    }
+    free(corpus);
+    return result;
+}
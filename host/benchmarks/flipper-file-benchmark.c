@@ -0,0 +1,187 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <furi.h>
+#include <furi-hal.h>
+#include <storage/storage.h>
+#include <lib/flipper_file/flipper_file.h>
+
+#define BENCHMARK_LINES 2000
+#define BENCHMARK_LINE_VALUES 64
+#define BENCHMARK_LOOKUPS 20
+#define BENCHMARK_CHUNK 512
+#define BENCHMARK_GENERATED_FILE "/ext/flipper-file-benchmark.sub"
+
+/* Same layout as RAW .sub recording */
+static bool benchmark_generate(const char* file_name) {
+    Storage* storage = furi_record_open("storage");
+    FlipperFile* flipper_file = flipper_file_alloc(storage);
+    int32_t data[BENCHMARK_LINE_VALUES];
+    uint32_t frequency = 433920000;
+    bool result = false;
+
+    srand(42);
+    do {
+        if(!flipper_file_open_always(flipper_file, file_name)) break;
+        if(!flipper_file_write_header_cstr(flipper_file, "Flipper SubGhz RAW File", 1)) break;
+        if(!flipper_file_write_uint32(flipper_file, "Frequency", &frequency, 1)) break;
+        if(!flipper_file_write_string_cstr(
+               flipper_file, "Preset", "FuriHalSubGhzPresetOok650Async"))
+            break;
+        if(!flipper_file_write_string_cstr(flipper_file, "Protocol", "RAW")) break;
+        result = true;
+        for(size_t line = 0; result && (line < BENCHMARK_LINES); line++) {
+            for(size_t i = 0; i < BENCHMARK_LINE_VALUES; i++) {
+                int32_t duration = 100 + rand() % 2000;
+                data[i] = (i % 2) ? -duration : duration;
+            }
+            result =
+                flipper_file_write_int32(flipper_file, "RAW_Data", data, BENCHMARK_LINE_VALUES);
+        }
+    } while(false);
+
+    flipper_file_close(flipper_file);
+    flipper_file_free(flipper_file);
+    furi_record_close("storage");
+    return result;
+}
+
+/* What SubGhz does on load: header, then every RAW_Data line */
+static bool benchmark_read_sequential(FlipperFile* flipper_file, size_t* lines) {
+    string_t value;
+    string_init(value);
+    uint32_t version;
+    uint32_t frequency;
+    uint32_t count;
+    int32_t* data = furi_alloc(sizeof(int32_t) * UINT16_MAX);
+    bool result = false;
+
+    *lines = 0;
+    do {
+        if(!flipper_file_rewind(flipper_file)) break;
+        if(!flipper_file_read_header(flipper_file, value, &version)) break;
+        if(!flipper_file_read_uint32(flipper_file, "Frequency", &frequency, 1)) break;
+        if(!flipper_file_read_string(flipper_file, "Preset", value)) break;
+        if(!flipper_file_read_string(flipper_file, "Protocol", value)) break;
+        while(flipper_file_get_value_count(flipper_file, "RAW_Data", &count)) {
+            if(count > UINT16_MAX) break;
+            if(!flipper_file_read_int32(flipper_file, "RAW_Data", data, count)) break;
+            (*lines)++;
+        }
+        result = *lines > 0;
+    } while(false);
+
+    free(data);
+    string_clear(value);
+    return result;
+}
+
+/* What SubGhz file encoder worker does on TX: RAW_Data values in chunks */
+static bool benchmark_read_chunks(FlipperFile* flipper_file, size_t* lines) {
+    string_t value;
+    string_init(value);
+    int32_t data[BENCHMARK_CHUNK];
+    uint16_t count;
+    bool result = flipper_file_rewind(flipper_file) &&
+                  flipper_file_read_string(flipper_file, "Protocol", value);
+
+    *lines = 0;
+    while(result && flipper_file_read_int32_chunk(
+                        flipper_file, "RAW_Data", data, BENCHMARK_CHUNK, &count)) {
+        if(count < BENCHMARK_CHUNK) (*lines)++;
+    }
+
+    string_clear(value);
+    return result && *lines > 0;
+}
+
+/* Rewind and look up a key that isn't there, e.g. optional field */
+static bool benchmark_read_missing(FlipperFile* flipper_file, size_t* lines) {
+    string_t value;
+    string_init(value);
+    bool result = flipper_file_rewind(flipper_file) &&
+                  !flipper_file_read_string(flipper_file, "Comment", value);
+    string_clear(value);
+    *lines = 0;
+    return result;
+}
+
+/* Header keys out of order, each needs rewind */
+static bool benchmark_read_header(FlipperFile* flipper_file, size_t* lines) {
+    string_t value;
+    string_init(value);
+    bool result = flipper_file_rewind(flipper_file) &&
+                  flipper_file_read_string(flipper_file, "Protocol", value) &&
+                  flipper_file_rewind(flipper_file) &&
+                  flipper_file_read_string(flipper_file, "Preset", value);
+    string_clear(value);
+    *lines = 0;
+    return result;
+}
+
+typedef struct {
+    const char* name;
+    bool (*read)(FlipperFile* flipper_file, size_t* lines);
+    size_t rounds;
+} BenchmarkCase;
+
+static const BenchmarkCase benchmark_cases[] = {
+    {.name = "sequential", .read = benchmark_read_sequential, .rounds = 1},
+    {.name = "chunked", .read = benchmark_read_chunks, .rounds = 1},
+    {.name = "missing key", .read = benchmark_read_missing, .rounds = BENCHMARK_LOOKUPS},
+    {.name = "rewind header", .read = benchmark_read_header, .rounds = BENCHMARK_LOOKUPS},
+};
+
+int main(int argc, char* argv[]) {
+    furi_init();
+
+    const char* file_name = argc > 1 ? argv[1] : NULL;
+    char storage_root[] = "/tmp/flipper-host-benchmark-XXXXXX";
+    bool generated = !file_name;
+    if(generated) {
+        furi_check(mkdtemp(storage_root));
+        storage_host_set_root(storage_root);
+        file_name = BENCHMARK_GENERATED_FILE;
+        uint64_t start = furi_hal_host_get_time_ns();
+        furi_check(benchmark_generate(file_name));
+        uint64_t time = furi_hal_host_get_time_ns() - start;
+        printf("%s: %d lines written in %.1f us\r\n", file_name, BENCHMARK_LINES, time / 1000.0);
+    }
+
+    Storage* storage = furi_record_open("storage");
+    FlipperFile* flipper_file = flipper_file_alloc(storage);
+    if(!flipper_file_open_existing(flipper_file, file_name)) {
+        printf("Unable to open %s\r\n", file_name);
+        return 1;
+    }
+
+    // First pass is the one that scans, later ones can use what was learned
+    printf("%-16s %12s %12s %8s\r\n", "read", "first, us", "next, us", "lines");
+    for(size_t c = 0; c < COUNT_OF(benchmark_cases); c++) {
+        const BenchmarkCase* benchmark = &benchmark_cases[c];
+        size_t lines = 0;
+
+        uint64_t start = furi_hal_host_get_time_ns();
+        furi_check(benchmark->read(flipper_file, &lines));
+        uint64_t first = furi_hal_host_get_time_ns() - start;
+
+        start = furi_hal_host_get_time_ns();
+        for(size_t round = 0; round < benchmark->rounds; round++) {
+            furi_check(benchmark->read(flipper_file, &lines));
+        }
+        uint64_t next = (furi_hal_host_get_time_ns() - start) / benchmark->rounds;
+
+        printf(
+            "%-16s %12.1f %12.1f %8zu\r\n", benchmark->name, first / 1000.0, next / 1000.0, lines);
+    }
+
+    flipper_file_close(flipper_file);
+    flipper_file_free(flipper_file);
+
+    if(generated) {
+        storage_simply_remove(storage, file_name);
+        rmdir(storage_root);
+    }
+    furi_record_close("storage");
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <furi.h>
+#include <furi-hal.h>
+#include <irda.h>
+
+#include "tests/irda_decoder_encoder/test_data/irda_nec_test_data.srcdata"
+#include "tests/irda_decoder_encoder/test_data/irda_necext_test_data.srcdata"
+#include "tests/irda_decoder_encoder/test_data/irda_samsung_test_data.srcdata"
+#include "tests/irda_decoder_encoder/test_data/irda_rc6_test_data.srcdata"
+#include "tests/irda_decoder_encoder/test_data/irda_rc5_test_data.srcdata"
+#include "tests/irda_decoder_encoder/test_data/irda_sirc_test_data.srcdata"
+
+#define BENCHMARK_ROUNDS 2000
+#define BENCHMARK_MESSAGES_MAX 256
+/* NEC, Samsung32, RC5, RC6, SIRC */
+#define BENCHMARK_DECODERS 5
+
+#define BENCHMARK_INPUT(data) \
+    { .name = #data, .timings = (data), .timings_cnt = COUNT_OF(data) }
+
+typedef struct {
+    const char* name;
+    const uint32_t* timings;
+    size_t timings_cnt;
+} BenchmarkInput;
+
+static const BenchmarkInput benchmark_inputs[] = {
+    BENCHMARK_INPUT(test_decoder_nec_input2),
+    BENCHMARK_INPUT(test_decoder_necext_input1),
+    BENCHMARK_INPUT(test_decoder_samsung32_input1),
+    BENCHMARK_INPUT(test_decoder_rc5_input_all_repeats),
+    BENCHMARK_INPUT(test_decoder_rc6_input1),
+    BENCHMARK_INPUT(test_decoder_sirc_input1),
+    BENCHMARK_INPUT(test_decoder_sirc_input5),
+};
+
+/* Inputs start from Space, which is skipped to start from Mark */
+static size_t benchmark_per_sample(IrdaDecoderHandler* decoder, const BenchmarkInput* input) {
+    size_t messages_cnt = 0;
+    for(size_t i = 1; i < input->timings_cnt; ++i) {
+        if(irda_decode(decoder, i % 2, input->timings[i])) {
+            ++messages_cnt;
+        }
+    }
+    return messages_cnt;
+}
+
+static size_t benchmark_batch(IrdaDecoderHandler* decoder, const BenchmarkInput* input) {
+    static IrdaMessage messages[BENCHMARK_MESSAGES_MAX];
+    return irda_decode_buffer(
+        decoder, &input->timings[1], input->timings_cnt - 1, messages, COUNT_OF(messages), NULL);
+}
+
+static uint64_t benchmark_run(
+    IrdaDecoderHandler* decoder,
+    const BenchmarkInput* input,
+    size_t (*decode)(IrdaDecoderHandler*, const BenchmarkInput*),
+    size_t* messages_cnt) {
+    uint64_t start = furi_hal_host_get_time_ns();
+    for(size_t round = 0; round < BENCHMARK_ROUNDS; ++round) {
+        irda_reset_decoder(decoder);
+        *messages_cnt = decode(decoder, input);
+    }
+    return furi_hal_host_get_time_ns() - start;
+}
+
+int main(int argc, char* argv[]) {
+    furi_init();
+    IrdaDecoderHandler* decoder = irda_alloc_decoder();
+    uint64_t per_sample_total = 0;
+    uint64_t batch_total = 0;
+    size_t timings_total = 0;
+    int result = 0;
+
+    printf("%-36s %8s %8s %14s %14s\n", "input", "timings", "messages", "sample ns/t", "batch ns/t");
+    for(size_t i = 0; i < COUNT_OF(benchmark_inputs); ++i) {
+        const BenchmarkInput* input = &benchmark_inputs[i];
+        size_t per_sample_messages = 0;
+        size_t batch_messages = 0;
+        uint64_t per_sample = benchmark_run(decoder, input, benchmark_per_sample, &per_sample_messages);
+        uint64_t batch = benchmark_run(decoder, input, benchmark_batch, &batch_messages);
+        size_t timings = (input->timings_cnt - 1) * BENCHMARK_ROUNDS;
+
+        printf(
+            "%-36s %8zu %8zu %14.1f %14.1f\n",
+            input->name,
+            input->timings_cnt - 1,
+            batch_messages,
+            (double)per_sample / timings,
+            (double)batch / timings);
+        if(per_sample_messages != batch_messages) {
+            printf("  MISMATCH: per sample decoded %zu messages\n", per_sample_messages);
+            result = 1;
+        }
+
+        per_sample_total += per_sample;
+        batch_total += batch;
+        timings_total += timings;
+    }
+    printf(
+        "%-36s %8s %8s %14.1f %14.1f\n",
+        "total",
+        "",
+        "",
+        (double)per_sample_total / timings_total,
+        (double)batch_total / timings_total);
+    /* both runs go through the same preamble filter */
+    printf(
+        "decoder invocations skipped by preamble filter: %u of %zu\n",
+        irda_get_decoder_skipped_count(decoder) / 2,
+        timings_total * BENCHMARK_DECODERS);
+
+    irda_free_decoder(decoder);
+    return result;
+}
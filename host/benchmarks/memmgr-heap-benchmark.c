@@ -0,0 +1,214 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <furi.h>
+#include <furi-hal.h>
+#include <FreeRTOS.h>
+#include <furi/memmgr_heap.h>
+
+/* Arena for core/furi/memmgr_heap.c, about the size of firmware heap */
+#define BENCHMARK_HEAP_SIZE (190 * 1024)
+#define BENCHMARK_STR_(x) #x
+#define BENCHMARK_STR(x) BENCHMARK_STR_(x)
+
+/* Linker script provides heap bounds in firmware */
+uint8_t __heap_start__[BENCHMARK_HEAP_SIZE] __attribute__((aligned(8)));
+__asm__(".globl __heap_end__\n"
+        ".set __heap_end__, __heap_start__ + " BENCHMARK_STR(BENCHMARK_HEAP_SIZE));
+
+/* Long lived blocks of apps and services, short lived blocks of hot paths */
+#define BENCHMARK_LONG_SLOTS 256
+#define BENCHMARK_SHORT_SLOTS 64
+#define BENCHMARK_LONG_PERCENT 5
+#define BENCHMARK_SLOTS (BENCHMARK_LONG_SLOTS + BENCHMARK_SHORT_SLOTS)
+#define BENCHMARK_OPS 2000000
+#define BENCHMARK_REPORT_OPS 200000
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    uint8_t pattern;
+} BenchmarkSlot;
+
+typedef struct {
+    uint64_t malloc_ns;
+    uint64_t malloc_ns_max;
+    size_t mallocs;
+    uint64_t free_ns;
+    size_t frees;
+    size_t failed;
+} BenchmarkInterval;
+
+static BenchmarkSlot benchmark_slots[BENCHMARK_SLOTS];
+
+static const size_t benchmark_small_sizes[] = {8, 16, 24, 32, 48, 64, 100, 128, 200, 256};
+
+/* Long lived: objects, buffers and rare big blocks */
+static size_t benchmark_long_size() {
+    int dice = rand() % 100;
+    if(dice < 60) {
+        return benchmark_small_sizes[rand() % COUNT_OF(benchmark_small_sizes)];
+    } else if(dice < 92) {
+        return 257 + rand() % 768;
+    } else {
+        return 1024 + rand() % 7168;
+    }
+}
+
+/* Short lived: strings and RPC messages, some encode buffers */
+static size_t benchmark_short_size() {
+    if(rand() % 100 < 90) {
+        return benchmark_small_sizes[rand() % COUNT_OF(benchmark_small_sizes)];
+    } else {
+        return 257 + rand() % 768;
+    }
+}
+
+static bool benchmark_slot_check(const BenchmarkSlot* slot) {
+    for(size_t i = 0; i < slot->size; i++) {
+        if(slot->data[i] != (uint8_t)(slot->pattern + i)) return false;
+    }
+    return true;
+}
+
+static bool benchmark_slot_free(BenchmarkSlot* slot, BenchmarkInterval* interval) {
+    bool result = benchmark_slot_check(slot);
+    uint64_t start = furi_hal_host_get_time_ns();
+    vPortFree(slot->data);
+    interval->free_ns += furi_hal_host_get_time_ns() - start;
+    interval->frees++;
+    slot->data = NULL;
+    return result;
+}
+
+static void benchmark_slot_alloc(BenchmarkSlot* slot, size_t size, BenchmarkInterval* interval) {
+    uint64_t start = furi_hal_host_get_time_ns();
+    uint8_t* data = pvPortMalloc(size);
+    uint64_t ns = furi_hal_host_get_time_ns() - start;
+
+    if(!data) {
+        interval->failed++;
+        return;
+    }
+    interval->malloc_ns += ns;
+    if(ns > interval->malloc_ns_max) interval->malloc_ns_max = ns;
+    interval->mallocs++;
+
+    slot->data = data;
+    slot->size = size;
+    slot->pattern = rand();
+    for(size_t i = 0; i < size; i++) {
+        data[i] = slot->pattern + i;
+    }
+}
+
+static void benchmark_report(size_t ops, const BenchmarkInterval* interval) {
+    size_t free_heap = xPortGetFreeHeapSize();
+    size_t max_block = memmgr_heap_get_max_free_block();
+    printf(
+        "%8zu %8zu %10zu %6zu%% %10.1f %10lu %9.1f %7zu\n",
+        ops,
+        free_heap,
+        max_block,
+        free_heap ? 100 - max_block * 100 / free_heap : 0,
+        interval->mallocs ? (double)interval->malloc_ns / interval->mallocs : 0.0,
+        (unsigned long)interval->malloc_ns_max,
+        interval->frees ? (double)interval->free_ns / interval->frees : 0.0,
+        interval->failed);
+}
+
+int main(int argc, char* argv[]) {
+    furi_init();
+    /* Optional seed to try other workloads */
+    srand(argc > 1 ? atoi(argv[1]) : 1);
+    int result = 0;
+
+    /* First allocation sets heap up */
+    vPortFree(pvPortMalloc(1));
+    size_t free_heap_start = xPortGetFreeHeapSize();
+    size_t max_block_start = memmgr_heap_get_max_free_block();
+
+    printf("slab caches: %s\n", MEMMGR_HEAP_SLAB ? "on" : "off");
+    printf(
+        "%8s %8s %10s %7s %10s %10s %9s %7s\n",
+        "ops",
+        "free",
+        "max block",
+        "frag",
+        "malloc ns",
+        "max ns",
+        "free ns",
+        "failed");
+
+    BenchmarkInterval interval = {0};
+    BenchmarkInterval total = {0};
+    for(size_t op = 1; op <= BENCHMARK_OPS; op++) {
+        bool long_lived = (rand() % 100) < BENCHMARK_LONG_PERCENT;
+        size_t slot_index = long_lived ? rand() % BENCHMARK_LONG_SLOTS :
+                                         BENCHMARK_LONG_SLOTS + rand() % BENCHMARK_SHORT_SLOTS;
+        BenchmarkSlot* slot = &benchmark_slots[slot_index];
+        if(slot->data) {
+            if(!benchmark_slot_free(slot, &interval)) {
+                printf("CORRUPTED: block of %zu bytes at op %zu\n", slot->size, op);
+                result = 1;
+            }
+        } else {
+            size_t size = long_lived ? benchmark_long_size() : benchmark_short_size();
+            benchmark_slot_alloc(slot, size, &interval);
+        }
+
+        if(op % BENCHMARK_REPORT_OPS == 0) {
+            benchmark_report(op, &interval);
+            total.malloc_ns += interval.malloc_ns;
+            total.mallocs += interval.mallocs;
+            total.free_ns += interval.free_ns;
+            total.frees += interval.frees;
+            total.failed += interval.failed;
+            if(interval.malloc_ns_max > total.malloc_ns_max) {
+                total.malloc_ns_max = interval.malloc_ns_max;
+            }
+            memset(&interval, 0, sizeof(interval));
+        }
+    }
+    printf("%8s ", "total");
+    printf("%8s %10s %7s ", "", "", "");
+    printf(
+        "%10.1f %10lu %9.1f %7zu\n",
+        (double)total.malloc_ns / total.mallocs,
+        (unsigned long)total.malloc_ns_max,
+        (double)total.free_ns / total.frees,
+        total.failed);
+
+    memmgr_heap_printf_slab_stats();
+
+    for(size_t i = 0; i < BENCHMARK_SLOTS; i++) {
+        if(benchmark_slots[i].data && !benchmark_slot_free(&benchmark_slots[i], &interval)) {
+            printf("CORRUPTED: block of %zu bytes\n", benchmark_slots[i].size);
+            result = 1;
+        }
+    }
+
+    /* Everything is freed: heap must be whole again, except kept slab pages */
+    size_t free_heap_end = xPortGetFreeHeapSize();
+    size_t max_block_end = memmgr_heap_get_max_free_block();
+    printf(
+        "all freed: free %zu (start %zu), max block %zu (start %zu)\n",
+        free_heap_end,
+        free_heap_start,
+        max_block_end,
+        max_block_start);
+    if(free_heap_end != free_heap_start) {
+        printf("LEAKED: %zd bytes\n", (ssize_t)(free_heap_start - free_heap_end));
+        result = 1;
+    }
+#if MEMMGR_HEAP_SLAB
+    size_t slab_pages_max = MEMMGR_HEAP_SLAB_CLASSES * MEMMGR_HEAP_SLAB_PAGE_SIZE_MAX;
+#else
+    size_t slab_pages_max = 0;
+#endif
+    if(max_block_end + slab_pages_max < max_block_start) {
+        printf("FRAGMENTED: max block is %zu bytes smaller\n", max_block_start - max_block_end);
+        result = 1;
+    }
+
+    return result;
+}
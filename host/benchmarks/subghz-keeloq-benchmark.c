@@ -0,0 +1,183 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <furi.h>
+#include <furi-hal.h>
+#include <storage/storage.h>
+#include <lib/flipper_file/flipper_file.h>
+#include <lib/subghz/subghz_keystore.h>
+#include <lib/subghz/protocols/subghz_protocol_keeloq.h>
+#include <lib/subghz/protocols/subghz_protocol_keeloq_common.h>
+
+#define BENCHMARK_KEYSTORE_FILE "/ext/keeloq_mfcodes_benchmark"
+#define BENCHMARK_REMOTES 16
+#define BENCHMARK_REMOTES_REPEAT 4
+#define BENCHMARK_TIME_NS 1000000000ULL
+#define BENCHMARK_PACKETS_MAX 100000
+
+static const size_t benchmark_keystore_sizes[] = {100, 1000, 10000};
+
+typedef struct {
+    uint64_t key;
+    uint16_t type;
+    char name[32];
+} BenchmarkKey;
+
+typedef struct {
+    const BenchmarkKey* manufacture;
+    uint32_t serial;
+    uint8_t btn;
+    uint16_t cnt;
+} BenchmarkRemote;
+
+static uint64_t benchmark_rand64() {
+    return ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand();
+}
+
+static bool benchmark_keystore_write(const char* file_name, BenchmarkKey* keys, size_t count) {
+    Storage* storage = furi_record_open("storage");
+    FlipperFile* flipper_file = flipper_file_alloc(storage);
+    uint32_t encryption = 0;
+    char line[64];
+    bool result = false;
+
+    do {
+        if(!flipper_file_open_always(flipper_file, file_name)) break;
+        if(!flipper_file_write_header_cstr(flipper_file, "Flipper SubGhz Keystore File", 0))
+            break;
+        if(!flipper_file_write_uint32(flipper_file, "Encryption", &encryption, 1)) break;
+
+        File* file = flipper_file_get_file(flipper_file);
+        result = true;
+        for(size_t i = 0; result && (i < count); i++) {
+            int len = snprintf(
+                line,
+                sizeof(line),
+                "%08" PRIX32 "%08" PRIX32 ":%hu:%s\n",
+                (uint32_t)(keys[i].key >> 32),
+                (uint32_t)keys[i].key,
+                keys[i].type,
+                keys[i].name);
+            result = storage_file_write(file, line, len) == (uint16_t)len;
+        }
+    } while(false);
+
+    flipper_file_close(flipper_file);
+    flipper_file_free(flipper_file);
+    furi_record_close("storage");
+    return result;
+}
+
+static uint64_t benchmark_remote_press(BenchmarkRemote* remote) {
+    uint32_t fix = (uint32_t)remote->btn << 28 | remote->serial;
+    uint32_t decrypt = (uint32_t)remote->btn << 28 | (remote->serial & 0x3FF) << 16 |
+                       remote->cnt++;
+    uint64_t man = remote->manufacture->key;
+
+    switch(remote->manufacture->type) {
+    case KEELOQ_LEARNING_NORMAL:
+        man = subghz_protocol_keeloq_common_normal_learning(fix, man);
+        break;
+    case KEELOQ_LEARNING_SECURE:
+        man = subghz_protocol_keeloq_common_secure_learning(fix, 0, man);
+        break;
+    }
+
+    uint32_t hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+    return subghz_protocol_common_reverse_key((uint64_t)fix << 32 | hop, 64);
+}
+
+/** Feed packets, either from new remotes every time or repeated presses of a few
+ * 
+ * Match check is only 12 bits wide, so with big keystores some packets are
+ * attributed to wrong manufacture. That's counted as mismatch.
+ */
+static void benchmark_run(
+    const char* name,
+    SubGhzProtocolKeeloq* keeloq,
+    BenchmarkRemote* remotes,
+    bool new_serials) {
+    SubGhzProtocolCommon* common = (SubGhzProtocolCommon*)keeloq;
+    size_t packets = 0;
+    size_t mismatch = 0;
+
+    uint64_t start = furi_hal_host_get_time_ns();
+    uint64_t time = 0;
+    while(time < BENCHMARK_TIME_NS && packets < BENCHMARK_PACKETS_MAX) {
+        BenchmarkRemote* remote;
+        if(new_serials) {
+            remote = &remotes[packets % BENCHMARK_REMOTES];
+            remote->serial = rand() & 0x0FFFFFFF;
+        } else {
+            remote = &remotes[packets % BENCHMARK_REMOTES_REPEAT];
+        }
+
+        common->code_last_found = benchmark_remote_press(remote);
+        common->code_last_count_bit = 64;
+        const char* manufacture_name =
+            subghz_protocol_keeloq_find_and_get_manufacture_name(keeloq);
+        if(strcmp(manufacture_name, remote->manufacture->name) != 0) mismatch++;
+
+        packets++;
+        time = furi_hal_host_get_time_ns() - start;
+    }
+
+    printf(
+        "%-14s %12.1f %10zu %10zu\r\n",
+        name,
+        (double)packets * 1000000000.0 / time,
+        packets,
+        mismatch);
+}
+
+int main() {
+    furi_init();
+
+    char storage_root[] = "/tmp/flipper-host-benchmark-XXXXXX";
+    furi_check(mkdtemp(storage_root));
+    storage_host_set_root(storage_root);
+
+    srand(42);
+    printf("%-6s %-14s %12s %10s %10s\r\n", "keys", "packets", "packets/s", "count", "mismatch");
+    for(size_t s = 0; s < COUNT_OF(benchmark_keystore_sizes); s++) {
+        size_t count = benchmark_keystore_sizes[s];
+        BenchmarkKey* keys = furi_alloc(sizeof(BenchmarkKey) * count);
+        for(size_t i = 0; i < count; i++) {
+            keys[i].key = benchmark_rand64();
+            keys[i].type = rand() % 4;
+            snprintf(keys[i].name, sizeof(keys[i].name), "Maker_%zu", i);
+        }
+        furi_check(benchmark_keystore_write(BENCHMARK_KEYSTORE_FILE, keys, count));
+
+        SubGhzKeystore* keystore = subghz_keystore_alloc();
+        furi_check(subghz_keystore_load(keystore, BENCHMARK_KEYSTORE_FILE));
+        SubGhzProtocolKeeloq* keeloq = subghz_protocol_keeloq_alloc(keystore);
+
+        // Remotes of manufactures with known learning type spread over the keystore
+        BenchmarkRemote remotes[BENCHMARK_REMOTES];
+        for(size_t i = 0; i < BENCHMARK_REMOTES; i++) {
+            size_t index = rand() % count;
+            while(keys[index].type == KEELOQ_LEARNING_UNKNOWN) index = (index + 1) % count;
+            remotes[i].manufacture = &keys[index];
+            remotes[i].serial = rand() & 0x0FFFFFFF;
+            remotes[i].btn = 1 + rand() % 4;
+            remotes[i].cnt = rand();
+        }
+
+        printf("%-6zu ", count);
+        benchmark_run("first press", keeloq, remotes, true);
+        printf("%-6zu ", count);
+        benchmark_run("repeat press", keeloq, remotes, false);
+
+        subghz_protocol_keeloq_free(keeloq);
+        subghz_keystore_free(keystore);
+        free(keys);
+    }
+
+    Storage* storage = furi_record_open("storage");
+    storage_simply_remove(storage, BENCHMARK_KEYSTORE_FILE);
+    furi_record_close("storage");
+    rmdir(storage_root);
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <furi.h>
+#include <furi-hal.h>
+#include <lib/subghz/protocols/subghz_protocol_keeloq_common.h>
+
+#define BENCHMARK_VECTORS 10000
+#define BENCHMARK_BATCH 1024
+#define BENCHMARK_ROUNDS 50
+
+static const char* benchmark_cipher_names[] = {
+    [KEELOQ_CIPHER_REFERENCE] = "reference",
+    [KEELOQ_CIPHER_UNROLLED] = "unrolled",
+    [KEELOQ_CIPHER_BITSLICE] = "bitslice",
+};
+
+/* Cipher as it is in datasheet, results must match it bit for bit */
+static uint32_t benchmark_reference_encrypt(const uint32_t data, const uint64_t key) {
+    uint32_t x = data, r;
+    for(r = 0; r < 528; r++)
+        x = (x >> 1) ^ ((bit(x, 0) ^ bit(x, 16) ^ (uint32_t)bit(key, r & 63) ^
+                         bit(KEELOQ_NLF, g5(x, 1, 9, 20, 26, 31)))
+                        << 31);
+    return x;
+}
+
+static uint32_t benchmark_reference_decrypt(const uint32_t data, const uint64_t key) {
+    uint32_t x = data, r;
+    for(r = 0; r < 528; r++)
+        x = (x << 1) ^ bit(x, 31) ^ bit(x, 15) ^ (uint32_t)bit(key, (15 - r) & 63) ^
+            bit(KEELOQ_NLF, g5(x, 0, 8, 19, 25, 30));
+    return x;
+}
+
+static uint64_t benchmark_rand64() {
+    return ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand();
+}
+
+static size_t benchmark_verify() {
+    uint64_t keys[BENCHMARK_BATCH];
+    uint32_t result[BENCHMARK_BATCH];
+    size_t errors = 0;
+
+    for(size_t i = 0; i < BENCHMARK_VECTORS; i++) {
+        uint32_t data = rand();
+        uint64_t key = benchmark_rand64();
+        if(subghz_protocol_keeloq_common_encrypt(data, key) !=
+           benchmark_reference_encrypt(data, key))
+            errors++;
+        if(subghz_protocol_keeloq_common_decrypt(data, key) !=
+           benchmark_reference_decrypt(data, key))
+            errors++;
+    }
+
+    // Odd count to cover partial batches
+    size_t count = BENCHMARK_BATCH - 1;
+    for(size_t i = 0; i < count; i++) keys[i] = benchmark_rand64();
+    uint32_t data = rand();
+    subghz_protocol_keeloq_common_decrypt_batch(data, keys, count, result);
+    for(size_t i = 0; i < count; i++) {
+        if(result[i] != benchmark_reference_decrypt(data, keys[i])) errors++;
+    }
+
+    return errors;
+}
+
+int main() {
+    furi_init();
+    srand(42);
+
+    size_t errors = benchmark_verify();
+    printf(
+        "KEELOQ_CIPHER %d (%s): %zu mismatches against reference\r\n",
+        KEELOQ_CIPHER,
+        benchmark_cipher_names[KEELOQ_CIPHER],
+        errors);
+
+    uint64_t keys[BENCHMARK_BATCH];
+    uint32_t result[BENCHMARK_BATCH];
+    for(size_t i = 0; i < BENCHMARK_BATCH; i++) keys[i] = benchmark_rand64();
+    uint32_t data = rand();
+    volatile uint32_t sink = 0;
+
+    printf("%-16s %14s\r\n", "operation", "operations/s");
+
+    uint64_t start = furi_hal_host_get_time_ns();
+    for(size_t round = 0; round < BENCHMARK_ROUNDS; round++) {
+        for(size_t i = 0; i < BENCHMARK_BATCH; i++) {
+            sink = benchmark_reference_decrypt(data + round, keys[i]);
+        }
+    }
+    uint64_t time = furi_hal_host_get_time_ns() - start;
+    printf("%-16s %14.0f\r\n", "reference", BENCHMARK_ROUNDS * BENCHMARK_BATCH * 1e9 / time);
+
+    start = furi_hal_host_get_time_ns();
+    for(size_t round = 0; round < BENCHMARK_ROUNDS; round++) {
+        for(size_t i = 0; i < BENCHMARK_BATCH; i++) {
+            sink = subghz_protocol_keeloq_common_encrypt(data + round, keys[i]);
+        }
+    }
+    time = furi_hal_host_get_time_ns() - start;
+    printf("%-16s %14.0f\r\n", "encrypt", BENCHMARK_ROUNDS * BENCHMARK_BATCH * 1e9 / time);
+
+    start = furi_hal_host_get_time_ns();
+    for(size_t round = 0; round < BENCHMARK_ROUNDS; round++) {
+        for(size_t i = 0; i < BENCHMARK_BATCH; i++) {
+            sink = subghz_protocol_keeloq_common_decrypt(data + round, keys[i]);
+        }
+    }
+    time = furi_hal_host_get_time_ns() - start;
+    printf("%-16s %14.0f\r\n", "decrypt", BENCHMARK_ROUNDS * BENCHMARK_BATCH * 1e9 / time);
+
+    start = furi_hal_host_get_time_ns();
+    for(size_t round = 0; round < BENCHMARK_ROUNDS; round++) {
+        subghz_protocol_keeloq_common_decrypt_batch(data + round, keys, BENCHMARK_BATCH, result);
+        sink = result[0];
+    }
+    time = furi_hal_host_get_time_ns() - start;
+    printf("%-16s %14.0f\r\n", "decrypt batch", BENCHMARK_ROUNDS * BENCHMARK_BATCH * 1e9 / time);
+
+    (void)sink;
+    return errors ? 1 : 0;
+}
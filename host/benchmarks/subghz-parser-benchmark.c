@@ -0,0 +1,214 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <furi.h>
+#include <furi-hal.h>
+#include <storage/storage.h>
+#include <lib/flipper_file/flipper_file.h>
+#include <lib/subghz/subghz_parser.h>
+
+#define BENCHMARK_EDGES_MIN 2000000
+#define BENCHMARK_RAW_LINE 512
+#define BENCHMARK_RAW_MAX (1024 * 1024)
+#define BENCHMARK_GENERATED_FILE "/ext/subghz-parser-benchmark.sub"
+
+typedef struct {
+    const char* name;
+    uint32_t mask;
+} BenchmarkMask;
+
+static const BenchmarkMask benchmark_masks[] = {
+    {.name = "all", .mask = SUBGHZ_PARSER_PROTOCOL_MASK_ALL},
+    {.name = "Princeton+CAME",
+     .mask = SUBGHZ_PARSER_PROTOCOL_MASK(SubGhzProtocolTypePrinceton) |
+             SUBGHZ_PARSER_PROTOCOL_MASK(SubGhzProtocolTypeCame)},
+    {.name = "Princeton", .mask = SUBGHZ_PARSER_PROTOCOL_MASK(SubGhzProtocolTypePrinceton)},
+    {.name = "static codes",
+     .mask = SUBGHZ_PARSER_PROTOCOL_MASK(SubGhzProtocolTypePrinceton) |
+             SUBGHZ_PARSER_PROTOCOL_MASK(SubGhzProtocolTypeCame) |
+             SUBGHZ_PARSER_PROTOCOL_MASK(SubGhzProtocolTypeNiceFlo) |
+             SUBGHZ_PARSER_PROTOCOL_MASK(SubGhzProtocolTypeGateTX)},
+};
+
+typedef struct {
+    int32_t* data;
+    size_t count;
+} BenchmarkRaw;
+
+static void benchmark_raw_add(BenchmarkRaw* raw, bool level, uint32_t duration) {
+    int32_t value = level ? (int32_t)duration : -(int32_t)duration;
+    if(raw->count && ((raw->data[raw->count - 1] > 0) == level)) {
+        raw->data[raw->count - 1] += value;
+    } else if(raw->count < BENCHMARK_RAW_MAX) {
+        raw->data[raw->count++] = value;
+    }
+}
+
+static void benchmark_raw_add_noise(BenchmarkRaw* raw, size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        benchmark_raw_add(raw, i % 2, 30 + rand() % 2000);
+    }
+}
+
+static void benchmark_raw_add_key(
+    BenchmarkRaw* raw,
+    SubGhzParser* parser,
+    SubGhzProtocolCommonEncoder* encoder,
+    const char* name,
+    uint64_t key,
+    uint8_t bit_count) {
+    SubGhzProtocolCommon* protocol = subghz_parser_get_by_name(parser, name);
+    furi_check(protocol);
+    protocol->code_last_found = key;
+    protocol->code_last_count_bit = bit_count;
+    furi_check(protocol->get_upload_protocol(protocol, encoder));
+
+    for(size_t repeat = 0; repeat < 5; repeat++) {
+        for(size_t i = 0; i < encoder->size_upload; i++) {
+            benchmark_raw_add(
+                raw,
+                level_duration_get_level(encoder->upload[i]),
+                level_duration_get_duration(encoder->upload[i]));
+        }
+    }
+}
+
+/* No recording given: make one from static code transmissions between bursts of noise */
+static bool benchmark_generate(const char* file_name) {
+    BenchmarkRaw raw = {.data = furi_alloc(sizeof(int32_t) * BENCHMARK_RAW_MAX)};
+    SubGhzParser* parser = subghz_parser_alloc();
+    SubGhzProtocolCommonEncoder* encoder = subghz_protocol_encoder_common_alloc();
+
+    srand(42);
+    for(size_t i = 0; i < 50; i++) {
+        benchmark_raw_add_noise(&raw, 2000);
+        benchmark_raw_add(&raw, false, 20000);
+        benchmark_raw_add_key(&raw, parser, encoder, "Princeton", 0x0074BADE + i, 24);
+        benchmark_raw_add_noise(&raw, 500);
+        benchmark_raw_add(&raw, false, 20000);
+        benchmark_raw_add_key(&raw, parser, encoder, "CAME", 0x0AB + i, 12);
+        benchmark_raw_add_noise(&raw, 500);
+        benchmark_raw_add(&raw, false, 20000);
+        benchmark_raw_add_key(&raw, parser, encoder, "Nice FLO", 0x123 + i, 12);
+        benchmark_raw_add_noise(&raw, 500);
+        benchmark_raw_add(&raw, false, 20000);
+        benchmark_raw_add_key(&raw, parser, encoder, "GateTX", 0x00A5A5 + i, 24);
+    }
+
+    subghz_protocol_encoder_common_free(encoder);
+    subghz_parser_free(parser);
+
+    Storage* storage = furi_record_open("storage");
+    FlipperFile* flipper_file = flipper_file_alloc(storage);
+    uint32_t frequency = 433920000;
+    bool result = false;
+    do {
+        if(!flipper_file_open_always(flipper_file, file_name)) break;
+        if(!flipper_file_write_header_cstr(
+               flipper_file, SUBGHZ_RAW_FILE_TYPE, SUBGHZ_RAW_FILE_VERSION))
+            break;
+        if(!flipper_file_write_uint32(flipper_file, "Frequency", &frequency, 1)) break;
+        if(!flipper_file_write_string_cstr(flipper_file, "Preset", "FuriHalSubGhzPresetOok650Async"))
+            break;
+        if(!flipper_file_write_string_cstr(flipper_file, "Protocol", "RAW")) break;
+        result = true;
+        for(size_t i = 0; result && (i < raw.count); i += BENCHMARK_RAW_LINE) {
+            result = flipper_file_write_int32(
+                flipper_file, "RAW_Data", &raw.data[i], MIN(BENCHMARK_RAW_LINE, raw.count - i));
+        }
+    } while(false);
+    flipper_file_close(flipper_file);
+    flipper_file_free(flipper_file);
+    furi_record_close("storage");
+
+    free(raw.data);
+    return result;
+}
+
+static bool benchmark_load(const char* file_name, BenchmarkRaw* raw) {
+    Storage* storage = furi_record_open("storage");
+    FlipperFile* flipper_file = flipper_file_alloc(storage);
+    bool result = false;
+    uint32_t count = 0;
+
+    raw->data = furi_alloc(sizeof(int32_t) * BENCHMARK_RAW_MAX);
+    raw->count = 0;
+    if(flipper_file_open_existing(flipper_file, file_name)) {
+        while(flipper_file_get_value_count(flipper_file, "RAW_Data", &count)) {
+            if(raw->count + count > BENCHMARK_RAW_MAX) break;
+            if(!flipper_file_read_int32(flipper_file, "RAW_Data", &raw->data[raw->count], count))
+                break;
+            raw->count += count;
+        }
+        result = raw->count > 0;
+    }
+
+    flipper_file_close(flipper_file);
+    flipper_file_free(flipper_file);
+    furi_record_close("storage");
+    return result;
+}
+
+static void benchmark_count_callback(SubGhzProtocolCommon* parser, void* context) {
+    size_t* found = context;
+    (*found)++;
+}
+
+int main(int argc, char* argv[]) {
+    furi_init();
+
+    const char* file_name = argc > 1 ? argv[1] : NULL;
+    char storage_root[] = "/tmp/flipper-host-benchmark-XXXXXX";
+    bool generated = !file_name;
+    if(generated) {
+        furi_check(mkdtemp(storage_root));
+        storage_host_set_root(storage_root);
+        file_name = BENCHMARK_GENERATED_FILE;
+        furi_check(benchmark_generate(file_name));
+    }
+
+    BenchmarkRaw raw;
+    if(!benchmark_load(file_name, &raw)) {
+        printf("Unable to load RAW_Data from %s\r\n", file_name);
+        return 1;
+    }
+    size_t rounds = BENCHMARK_EDGES_MIN / raw.count + 1;
+    printf("%s: %zu edges, %zu rounds\r\n", file_name, raw.count, rounds);
+
+    SubGhzParser* parser = subghz_parser_alloc();
+    size_t found = 0;
+    subghz_parser_enable_dump(parser, benchmark_count_callback, &found);
+
+    printf("%-16s %10s %10s\r\n", "mask", "ns/edge", "found");
+    for(size_t m = 0; m < COUNT_OF(benchmark_masks); m++) {
+        subghz_parser_set_protocol_mask(parser, benchmark_masks[m].mask);
+        subghz_parser_reset(parser);
+        found = 0;
+
+        uint64_t start = furi_hal_host_get_time_ns();
+        for(size_t round = 0; round < rounds; round++) {
+            for(size_t i = 0; i < raw.count; i++) {
+                int32_t value = raw.data[i];
+                subghz_parser_parse(parser, value > 0, value > 0 ? value : -value);
+            }
+        }
+        uint64_t time = furi_hal_host_get_time_ns() - start;
+
+        printf(
+            "%-16s %10.1f %10zu\r\n",
+            benchmark_masks[m].name,
+            (double)time / (rounds * raw.count),
+            found / rounds);
+    }
+
+    subghz_parser_free(parser);
+    free(raw.data);
+
+    if(generated) {
+        Storage* storage = furi_record_open("storage");
+        storage_simply_remove(storage, file_name);
+        furi_record_close("storage");
+        rmdir(storage_root);
+    }
+    return 0;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file FreeRTOS.h
+ * Host furi shim: FreeRTOS types and port definitions used by core/furi
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <furi/check.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef long BaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFU)
+#define portYIELD_FROM_ISR(x) ((void)(x))
+
+#define portBYTE_ALIGNMENT 8
+#define portBYTE_ALIGNMENT_MASK 0x0007
+
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define configASSERT(x) furi_assert(x)
+#define mtCOVERAGE_TEST_MARKER()
+
+void* pvPortMalloc(size_t xWantedSize);
+
+void vPortFree(void* pv);
+
+size_t xPortGetFreeHeapSize(void);
+
+size_t xPortGetMinimumEverFreeHeapSize(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,103 @@
+/**
+ * @file cmsis_os2.h
+ * Host furi shim: minimal CMSIS-RTOS2 types and calls used by lib/
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define osWaitForever 0xFFFFFFFFU
+
+typedef enum {
+    osOK = 0,
+    osError = -1,
+    osErrorTimeout = -2,
+    osErrorResource = -3,
+    osErrorParameter = -4,
+    osErrorNoMemory = -5,
+    osErrorISR = -6,
+} osStatus_t;
+
+typedef void* osThreadId_t;
+
+typedef void* osMutexId_t;
+
+/** Sleep calling thread
+ *
+ * @param      ticks  ticks to sleep, 1 tick is 1 ms
+ *
+ * @return     osOK
+ */
+osStatus_t osDelay(uint32_t ticks);
+
+/** Get monotonic tick count, 1 tick is 1 ms
+ *
+ * @return     tick count
+ */
+uint32_t osKernelGetTickCount(void);
+
+/** Get tick frequency
+ *
+ * @return     1000
+ */
+uint32_t osKernelGetTickFreq(void);
+
+/** Lock scheduler: same lock as vTaskSuspendAll, nests
+ *
+ * @return     previous lock state
+ */
+int32_t osKernelLock(void);
+
+/** Unlock scheduler
+ *
+ * @return     previous lock state
+ */
+int32_t osKernelUnlock(void);
+
+/** Get calling thread id
+ *
+ * @return     thread id
+ */
+osThreadId_t osThreadGetId(void);
+
+/** Create recursive mutex
+ *
+ * @param      attr  ignored
+ *
+ * @return     mutex id or NULL
+ */
+osMutexId_t osMutexNew(const void* attr);
+
+/** Lock mutex
+ *
+ * @param      mutex_id  mutex id
+ * @param      timeout   only osWaitForever is supported
+ *
+ * @return     osOK
+ */
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout);
+
+/** Unlock mutex
+ *
+ * @param      mutex_id  mutex id
+ *
+ * @return     osOK
+ */
+osStatus_t osMutexRelease(osMutexId_t mutex_id);
+
+/** Delete mutex
+ *
+ * @param      mutex_id  mutex id
+ *
+ * @return     osOK
+ */
+osStatus_t osMutexDelete(osMutexId_t mutex_id);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,38 @@
+/**
+ * @file furi-hal.h
+ * Host furi shim: HAL calls used by lib/ protocol code
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <furi-hal-crypto.h>
+#include <toolbox/level_duration.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Sleep for milliseconds */
+void delay(float milliseconds);
+
+/** Sleep for microseconds */
+void delay_us(float microseconds);
+
+/** Get monotonic time in milliseconds */
+uint32_t millis(void);
+
+/** Get cycle counter, SystemCoreClock cycles per second, wraps around */
+uint32_t furi_hal_delay_get_cycles(void);
+
+/** Get monotonic time in nanoseconds, host only
+ *
+ * Use it to measure throughput in host benchmarks.
+ */
+uint64_t furi_hal_host_get_time_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,366 @@
+#include <storage/storage.h>
+#include <storage/storage-file-buffer.h>
+
+#include <dirent.h>
+#include <errno.h>
+#include <ftw.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define TAG "StorageHost"
+#define STORAGE_HOST_PATH_MAX 512
+
+struct Storage {
+    string_t root;
+};
+
+struct File {
+    Storage* storage;
+    FILE* stream;
+    DIR* dir;
+    FS_Error error_id;
+    int32_t internal_error_id;
+    FileBuffer buffer;
+};
+
+static Storage storage_host;
+
+__attribute__((constructor)) static void storage_host_init(void) {
+    string_init(storage_host.root);
+    storage_host_set_root(getenv("FLIPPER_HOST_STORAGE"));
+    furi_record_create("storage", &storage_host);
+}
+
+void storage_host_set_root(const char* root) {
+    string_set_str(storage_host.root, root ? root : ".");
+}
+
+/** Map flipper path to host path: /int, /ext and /any are rooted in storage root */
+static const char* storage_host_path(Storage* storage, const char* path, char* buffer) {
+    if(!strncmp(path, "/int", 4) || !strncmp(path, "/ext", 4) || !strncmp(path, "/any", 4)) {
+        if(path[4] == '/' || path[4] == '\0') {
+            snprintf(
+                buffer, STORAGE_HOST_PATH_MAX, "%s%s", string_get_cstr(storage->root), path + 4);
+            return buffer;
+        }
+    }
+    return path;
+}
+
+static FS_Error storage_host_error(int error) {
+    switch(error) {
+    case 0:
+        return FSE_OK;
+    case ENOENT:
+    case ENOTDIR:
+        return FSE_NOT_EXIST;
+    case EEXIST:
+    case ENOTEMPTY:
+        return FSE_EXIST;
+    case EACCES:
+    case EPERM:
+    case EROFS:
+        return FSE_DENIED;
+    case EINVAL:
+        return FSE_INVALID_PARAMETER;
+    case ENAMETOOLONG:
+        return FSE_INVALID_NAME;
+    default:
+        return FSE_INTERNAL;
+    }
+}
+
+static bool storage_file_set_error(File* file, int error) {
+    file->internal_error_id = error;
+    file->error_id = storage_host_error(error);
+    return error == 0;
+}
+
+/****************** FILE ******************/
+
+File* storage_file_alloc(Storage* storage) {
+    File* file = furi_alloc(sizeof(File));
+    file->storage = storage;
+    return file;
+}
+
+void storage_file_free(File* file) {
+    if(file->stream) storage_file_close(file);
+    if(file->dir) storage_dir_close(file);
+    free(file);
+}
+
+bool storage_file_open(
+    File* file,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    furi_assert(!file->stream);
+    char buffer[STORAGE_HOST_PATH_MAX];
+    const char* host_path = storage_host_path(file->storage, path, buffer);
+
+    struct stat st;
+    bool exists = (stat(host_path, &st) == 0);
+    if(exists && S_ISDIR(st.st_mode)) return storage_file_set_error(file, EISDIR);
+    if(open_mode == FSOM_OPEN_EXISTING && !exists) return storage_file_set_error(file, ENOENT);
+    if(open_mode == FSOM_CREATE_NEW && exists) return storage_file_set_error(file, EEXIST);
+
+    const char* mode = "rb";
+    if(open_mode == FSOM_CREATE_ALWAYS || open_mode == FSOM_CREATE_NEW || !exists) {
+        mode = (access_mode & FSAM_READ) ? "w+b" : "wb";
+    } else if(access_mode & FSAM_WRITE) {
+        mode = "r+b";
+    }
+
+    memset(&file->buffer, 0, sizeof(FileBuffer));
+    file->stream = fopen(host_path, mode);
+    if(!file->stream) return storage_file_set_error(file, errno);
+    if(open_mode == FSOM_OPEN_APPEND) fseek(file->stream, 0, SEEK_END);
+
+    return storage_file_set_error(file, 0);
+}
+
+bool storage_file_close(File* file) {
+    if(!file->stream) return storage_file_set_error(file, EBADF);
+    // Close anyway, but report lost writes
+    bool flushed = storage_file_buffer_flush(&file->buffer, file);
+    memset(&file->buffer, 0, sizeof(FileBuffer));
+    int ret = fclose(file->stream);
+    file->stream = NULL;
+    return storage_file_set_error(file, ret ? errno : 0) && flushed;
+}
+
+bool storage_file_is_open(File* file) {
+    return file->stream != NULL;
+}
+
+uint32_t storage_file_read_internal(File* file, void* buff, uint32_t bytes_to_read) {
+    if(!file->stream) {
+        storage_file_set_error(file, EBADF);
+        return 0;
+    }
+    size_t ret = fread(buff, 1, bytes_to_read, file->stream);
+    storage_file_set_error(file, ferror(file->stream) ? EIO : 0);
+    return ret;
+}
+
+uint32_t storage_file_write_internal(File* file, const void* buff, uint32_t bytes_to_write) {
+    if(!file->stream) {
+        storage_file_set_error(file, EBADF);
+        return 0;
+    }
+    size_t ret = fwrite(buff, 1, bytes_to_write, file->stream);
+    storage_file_set_error(file, ferror(file->stream) ? EIO : 0);
+    return ret;
+}
+
+bool storage_file_seek_internal(File* file, uint32_t offset, bool from_start) {
+    if(!file->stream) return storage_file_set_error(file, EBADF);
+    int ret = fseek(file->stream, offset, from_start ? SEEK_SET : SEEK_CUR);
+    return storage_file_set_error(file, ret ? errno : 0);
+}
+
+uint64_t storage_file_tell_internal(File* file) {
+    if(!file->stream) {
+        storage_file_set_error(file, EBADF);
+        return 0;
+    }
+    long ret = ftell(file->stream);
+    storage_file_set_error(file, ret < 0 ? errno : 0);
+    return ret < 0 ? 0 : ret;
+}
+
+/* Buffering is the same code as in firmware, on top of stdio */
+
+bool storage_file_set_buffer(File* file, void* buffer, uint32_t buffer_size) {
+    furi_assert(file->stream);
+    return storage_file_buffer_set(&file->buffer, file, buffer, buffer_size);
+}
+
+uint32_t storage_file_read(File* file, void* buff, uint32_t bytes_to_read) {
+    if(!file->buffer.data) return storage_file_read_internal(file, buff, bytes_to_read);
+    return storage_file_buffer_read(&file->buffer, file, buff, bytes_to_read);
+}
+
+uint32_t storage_file_write(File* file, const void* buff, uint32_t bytes_to_write) {
+    if(!file->buffer.data) return storage_file_write_internal(file, buff, bytes_to_write);
+    return storage_file_buffer_write(&file->buffer, file, buff, bytes_to_write);
+}
+
+bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+    if(!file->buffer.data) return storage_file_seek_internal(file, offset, from_start);
+    return storage_file_buffer_seek(&file->buffer, file, offset, from_start);
+}
+
+uint64_t storage_file_tell(File* file) {
+    if(!file->buffer.data) return storage_file_tell_internal(file);
+    return storage_file_buffer_tell(&file->buffer);
+}
+
+bool storage_file_truncate(File* file) {
+    if(!file->stream) return storage_file_set_error(file, EBADF);
+    if(!storage_file_buffer_release(&file->buffer, file)) return false;
+    fflush(file->stream);
+    int ret = ftruncate(fileno(file->stream), ftell(file->stream));
+    return storage_file_set_error(file, ret ? errno : 0);
+}
+
+uint64_t storage_file_size(File* file) {
+    if(!file->stream) {
+        storage_file_set_error(file, EBADF);
+        return 0;
+    }
+    storage_file_buffer_flush(&file->buffer, file);
+    fflush(file->stream);
+    struct stat st;
+    int ret = fstat(fileno(file->stream), &st);
+    storage_file_set_error(file, ret ? errno : 0);
+    return ret ? 0 : st.st_size;
+}
+
+bool storage_file_sync(File* file) {
+    if(!file->stream) return storage_file_set_error(file, EBADF);
+    if(!storage_file_buffer_flush(&file->buffer, file)) return false;
+    int ret = fflush(file->stream);
+    return storage_file_set_error(file, ret ? errno : 0);
+}
+
+bool storage_file_eof(File* file) {
+    if(!file->stream) return true;
+    if(storage_file_buffer_has_read_ahead(&file->buffer)) return false;
+    // Flushes buffered writes, so stdio position is file position
+    uint64_t size = storage_file_size(file);
+    return (uint64_t)ftell(file->stream) >= size;
+}
+
+/****************** DIR ******************/
+
+bool storage_dir_open(File* file, const char* path) {
+    furi_assert(!file->dir);
+    char buffer[STORAGE_HOST_PATH_MAX];
+    file->dir = opendir(storage_host_path(file->storage, path, buffer));
+    return storage_file_set_error(file, file->dir ? 0 : errno);
+}
+
+bool storage_dir_close(File* file) {
+    if(!file->dir) return storage_file_set_error(file, EBADF);
+    closedir(file->dir);
+    file->dir = NULL;
+    return storage_file_set_error(file, 0);
+}
+
+bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_length) {
+    if(!file->dir) return storage_file_set_error(file, EBADF);
+
+    struct dirent* entry;
+    do {
+        entry = readdir(file->dir);
+    } while(entry && (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, "..")));
+
+    if(!entry) return storage_file_set_error(file, ENOENT);
+
+    if(fileinfo) {
+        struct stat st;
+        memset(fileinfo, 0, sizeof(FileInfo));
+        if(fstatat(dirfd(file->dir), entry->d_name, &st, 0) == 0) {
+            fileinfo->flags = S_ISDIR(st.st_mode) ? FSF_DIRECTORY : 0;
+            fileinfo->size = st.st_size;
+        }
+    }
+    if(name && name_length) {
+        strncpy(name, entry->d_name, name_length - 1);
+        name[name_length - 1] = '\0';
+    }
+
+    return storage_file_set_error(file, 0);
+}
+
+bool storage_dir_rewind(File* file) {
+    if(!file->dir) return storage_file_set_error(file, EBADF);
+    rewinddir(file->dir);
+    return storage_file_set_error(file, 0);
+}
+
+/****************** COMMON ******************/
+
+FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo) {
+    char buffer[STORAGE_HOST_PATH_MAX];
+    struct stat st;
+    if(stat(storage_host_path(storage, path, buffer), &st)) return storage_host_error(errno);
+    if(fileinfo) {
+        fileinfo->flags = S_ISDIR(st.st_mode) ? FSF_DIRECTORY : 0;
+        fileinfo->size = st.st_size;
+    }
+    return FSE_OK;
+}
+
+FS_Error storage_common_remove(Storage* storage, const char* path) {
+    char buffer[STORAGE_HOST_PATH_MAX];
+    return storage_host_error(remove(storage_host_path(storage, path, buffer)) ? errno : 0);
+}
+
+FS_Error storage_common_rename(Storage* storage, const char* old_path, const char* new_path) {
+    char old_buffer[STORAGE_HOST_PATH_MAX];
+    char new_buffer[STORAGE_HOST_PATH_MAX];
+    int ret = rename(
+        storage_host_path(storage, old_path, old_buffer),
+        storage_host_path(storage, new_path, new_buffer));
+    return storage_host_error(ret ? errno : 0);
+}
+
+FS_Error storage_common_mkdir(Storage* storage, const char* path) {
+    char buffer[STORAGE_HOST_PATH_MAX];
+    return storage_host_error(mkdir(storage_host_path(storage, path, buffer), 0777) ? errno : 0);
+}
+
+/****************** ERROR ******************/
+
+const char* storage_error_get_desc(FS_Error error_id) {
+    return filesystem_api_error_get_desc(error_id);
+}
+
+FS_Error storage_file_get_error(File* file) {
+    furi_check(file != NULL);
+    return file->error_id;
+}
+
+int32_t storage_file_get_internal_error(File* file) {
+    furi_check(file != NULL);
+    return file->internal_error_id;
+}
+
+const char* storage_file_get_error_desc(File* file) {
+    furi_check(file != NULL);
+    return filesystem_api_error_get_desc(file->error_id);
+}
+
+/****************** SIMPLE ******************/
+
+bool storage_simply_remove(Storage* storage, const char* path) {
+    FS_Error result = storage_common_remove(storage, path);
+    return result == FSE_OK || result == FSE_NOT_EXIST;
+}
+
+static int storage_host_remove_entry(
+    const char* path,
+    const struct stat* stat,
+    int type,
+    struct FTW* ftw) {
+    return remove(path);
+}
+
+bool storage_simply_remove_recursive(Storage* storage, const char* path) {
+    char buffer[STORAGE_HOST_PATH_MAX];
+    const char* host_path = storage_host_path(storage, path, buffer);
+    if(nftw(host_path, storage_host_remove_entry, 16, FTW_DEPTH | FTW_PHYS)) {
+        return errno == ENOENT;
+    }
+    return true;
+}
+
+bool storage_simply_mkdir(Storage* storage, const char* path) {
+    FS_Error result = storage_common_mkdir(storage, path);
+    return result == FSE_OK || result == FSE_EXIST;
+}
@@ -0,0 +1,332 @@
+#include <furi.h>
+#include <stream_buffer.h>
+#include <task.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/******************* Kernel *******************/
+
+osStatus_t osDelay(uint32_t ticks) {
+    usleep((useconds_t)ticks * 1000);
+    return osOK;
+}
+
+uint32_t osKernelGetTickCount(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+uint32_t osKernelGetTickFreq(void) {
+    return 1000;
+}
+
+static pthread_mutex_t kernel_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static int32_t kernel_lock_depth = 0;
+
+int32_t osKernelLock(void) {
+    pthread_mutex_lock(&kernel_lock);
+    return kernel_lock_depth++ > 0;
+}
+
+int32_t osKernelUnlock(void) {
+    int32_t locked = kernel_lock_depth-- > 0;
+    pthread_mutex_unlock(&kernel_lock);
+    return locked;
+}
+
+void vTaskSuspendAll(void) {
+    osKernelLock();
+}
+
+BaseType_t xTaskResumeAll(void) {
+    osKernelUnlock();
+    return pdFALSE;
+}
+
+osThreadId_t osThreadGetId(void) {
+    return (osThreadId_t)pthread_self();
+}
+
+/******************* Mutex *******************/
+
+osMutexId_t osMutexNew(const void* attr) {
+    pthread_mutex_t* mutex = furi_alloc(sizeof(pthread_mutex_t));
+    pthread_mutexattr_t mutex_attr;
+    pthread_mutexattr_init(&mutex_attr);
+    pthread_mutexattr_settype(&mutex_attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(mutex, &mutex_attr);
+    pthread_mutexattr_destroy(&mutex_attr);
+    return mutex;
+}
+
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout) {
+    furi_check(timeout == osWaitForever);
+    return pthread_mutex_lock(mutex_id) == 0 ? osOK : osError;
+}
+
+osStatus_t osMutexRelease(osMutexId_t mutex_id) {
+    return pthread_mutex_unlock(mutex_id) == 0 ? osOK : osError;
+}
+
+osStatus_t osMutexDelete(osMutexId_t mutex_id) {
+    pthread_mutex_destroy(mutex_id);
+    free(mutex_id);
+    return osOK;
+}
+
+/******************* Thread *******************/
+
+struct FuriThread {
+    FuriThreadState state;
+    int32_t ret;
+
+    FuriThreadCallback callback;
+    void* context;
+
+    FuriThreadStateCallback state_callback;
+    void* state_context;
+
+    const char* name;
+    size_t stack_size;
+    pthread_t pthread;
+};
+
+static void furi_thread_set_state(FuriThread* thread, FuriThreadState state) {
+    thread->state = state;
+    if(thread->state_callback) thread->state_callback(state, thread->state_context);
+}
+
+static void* furi_thread_body(void* context) {
+    FuriThread* thread = context;
+    furi_thread_set_state(thread, FuriThreadStateRunning);
+    thread->ret = thread->callback(thread->context);
+    furi_thread_set_state(thread, FuriThreadStateStopped);
+    return NULL;
+}
+
+FuriThread* furi_thread_alloc() {
+    FuriThread* thread = furi_alloc(sizeof(FuriThread));
+    return thread;
+}
+
+void furi_thread_free(FuriThread* thread) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    free(thread);
+}
+
+void furi_thread_set_name(FuriThread* thread, const char* name) {
+    furi_assert(thread);
+    thread->name = name;
+}
+
+void furi_thread_set_stack_size(FuriThread* thread, size_t stack_size) {
+    furi_assert(thread);
+    thread->stack_size = stack_size;
+}
+
+void furi_thread_set_callback(FuriThread* thread, FuriThreadCallback callback) {
+    furi_assert(thread);
+    thread->callback = callback;
+}
+
+void furi_thread_set_context(FuriThread* thread, void* context) {
+    furi_assert(thread);
+    thread->context = context;
+}
+
+void furi_thread_set_state_callback(FuriThread* thread, FuriThreadStateCallback callback) {
+    furi_assert(thread);
+    thread->state_callback = callback;
+}
+
+void furi_thread_set_state_context(FuriThread* thread, void* context) {
+    furi_assert(thread);
+    thread->state_context = context;
+}
+
+FuriThreadState furi_thread_get_state(FuriThread* thread) {
+    furi_assert(thread);
+    return thread->state;
+}
+
+bool furi_thread_start(FuriThread* thread) {
+    furi_assert(thread);
+    furi_assert(thread->callback);
+    furi_assert(thread->state == FuriThreadStateStopped);
+
+    furi_thread_set_state(thread, FuriThreadStateStarting);
+    if(pthread_create(&thread->pthread, NULL, furi_thread_body, thread) != 0) {
+        furi_thread_set_state(thread, FuriThreadStateStopped);
+        return false;
+    }
+    return true;
+}
+
+osStatus_t furi_thread_terminate(FuriThread* thread) {
+    // Cooperative workers only: there is no safe way to kill a pthread
+    return osErrorResource;
+}
+
+osStatus_t furi_thread_join(FuriThread* thread) {
+    furi_assert(thread);
+    if(!thread->pthread) return osOK;
+    pthread_join(thread->pthread, NULL);
+    thread->pthread = 0;
+    return osOK;
+}
+
+osThreadId_t furi_thread_get_thread_id(FuriThread* thread) {
+    furi_assert(thread);
+    return (osThreadId_t)thread->pthread;
+}
+
+void furi_thread_enable_heap_trace(FuriThread* thread) {
+}
+
+void furi_thread_disable_heap_trace(FuriThread* thread) {
+}
+
+size_t furi_thread_get_heap_size(FuriThread* thread) {
+    return 0;
+}
+
+/******************* Stream Buffer *******************/
+
+struct StreamBufferDef_t {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint8_t* data;
+    size_t size;
+    size_t head;
+    size_t count;
+};
+
+StreamBufferHandle_t xStreamBufferCreate(size_t buffer_size, size_t trigger_level) {
+    StreamBufferHandle_t stream = furi_alloc(sizeof(struct StreamBufferDef_t));
+    stream->data = furi_alloc(buffer_size);
+    stream->size = buffer_size;
+    pthread_mutex_init(&stream->mutex, NULL);
+    pthread_cond_init(&stream->cond, NULL);
+    return stream;
+}
+
+void vStreamBufferDelete(StreamBufferHandle_t stream) {
+    furi_assert(stream);
+    pthread_cond_destroy(&stream->cond);
+    pthread_mutex_destroy(&stream->mutex);
+    free(stream->data);
+    free(stream);
+}
+
+static bool stream_buffer_wait(StreamBufferHandle_t stream, TickType_t ticks_to_wait) {
+    if(ticks_to_wait == 0) return false;
+    if(ticks_to_wait == portMAX_DELAY) {
+        pthread_cond_wait(&stream->cond, &stream->mutex);
+        return true;
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += ticks_to_wait / 1000;
+    ts.tv_nsec += (ticks_to_wait % 1000) * 1000000L;
+    if(ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    return pthread_cond_timedwait(&stream->cond, &stream->mutex, &ts) != ETIMEDOUT;
+}
+
+size_t xStreamBufferSend(
+    StreamBufferHandle_t stream,
+    const void* data,
+    size_t length,
+    TickType_t ticks_to_wait) {
+    furi_assert(stream);
+    const uint8_t* src = data;
+    size_t sent = 0;
+
+    pthread_mutex_lock(&stream->mutex);
+    while(sent < length) {
+        while(stream->count < stream->size && sent < length) {
+            stream->data[(stream->head + stream->count) % stream->size] = src[sent++];
+            stream->count++;
+        }
+        pthread_cond_broadcast(&stream->cond);
+        if(sent < length && !stream_buffer_wait(stream, ticks_to_wait)) break;
+    }
+    pthread_mutex_unlock(&stream->mutex);
+
+    return sent;
+}
+
+size_t xStreamBufferSendFromISR(
+    StreamBufferHandle_t stream,
+    const void* data,
+    size_t length,
+    BaseType_t* higher_priority_task_woken) {
+    if(higher_priority_task_woken) *higher_priority_task_woken = pdFALSE;
+    return xStreamBufferSend(stream, data, length, 0);
+}
+
+size_t xStreamBufferReceive(
+    StreamBufferHandle_t stream,
+    void* data,
+    size_t length,
+    TickType_t ticks_to_wait) {
+    furi_assert(stream);
+    uint8_t* dst = data;
+    size_t received = 0;
+
+    pthread_mutex_lock(&stream->mutex);
+    if(stream->count == 0) stream_buffer_wait(stream, ticks_to_wait);
+    while(stream->count > 0 && received < length) {
+        dst[received++] = stream->data[stream->head];
+        stream->head = (stream->head + 1) % stream->size;
+        stream->count--;
+    }
+    pthread_cond_broadcast(&stream->cond);
+    pthread_mutex_unlock(&stream->mutex);
+
+    return received;
+}
+
+size_t xStreamBufferReceiveFromISR(
+    StreamBufferHandle_t stream,
+    void* data,
+    size_t length,
+    BaseType_t* higher_priority_task_woken) {
+    if(higher_priority_task_woken) *higher_priority_task_woken = pdFALSE;
+    return xStreamBufferReceive(stream, data, length, 0);
+}
+
+size_t xStreamBufferSpacesAvailable(StreamBufferHandle_t stream) {
+    furi_assert(stream);
+    pthread_mutex_lock(&stream->mutex);
+    size_t spaces = stream->size - stream->count;
+    pthread_mutex_unlock(&stream->mutex);
+    return spaces;
+}
+
+size_t xStreamBufferBytesAvailable(StreamBufferHandle_t stream) {
+    furi_assert(stream);
+    pthread_mutex_lock(&stream->mutex);
+    size_t count = stream->count;
+    pthread_mutex_unlock(&stream->mutex);
+    return count;
+}
+
+BaseType_t xStreamBufferReset(StreamBufferHandle_t stream) {
+    furi_assert(stream);
+    pthread_mutex_lock(&stream->mutex);
+    stream->head = 0;
+    stream->count = 0;
+    pthread_cond_broadcast(&stream->cond);
+    pthread_mutex_unlock(&stream->mutex);
+    return pdTRUE;
+}
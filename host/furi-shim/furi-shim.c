@@ -0,0 +1,217 @@
+#include <furi.h>
+#include <furi-hal.h>
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define FURI_SHIM_RECORDS_MAX 16
+
+typedef struct {
+    const char* name;
+    void* data;
+} FuriShimRecord;
+
+typedef struct {
+    FuriLogLevel log_level;
+    FuriLogPuts puts;
+    FuriLogTimestamp timestamp;
+    FuriShimRecord records[FURI_SHIM_RECORDS_MAX];
+    size_t records_count;
+} FuriShim;
+
+static pthread_mutex_t furi_shim_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t furi_shim_critical_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+static void furi_shim_puts(const char* data) {
+    fputs(data, stderr);
+}
+
+static FuriShim furi_shim = {
+    .log_level = FURI_LOG_LEVEL,
+    .puts = furi_shim_puts,
+    .timestamp = millis,
+};
+
+void furi_init() {
+    furi_log_init();
+    furi_record_init();
+    furi_stats_init();
+}
+
+/******************* Check *******************/
+
+void furi_crash(const char* message) {
+    fprintf(stderr, "\r\n\033[0;31m[CRASH] %s\033[0m\r\n", message ? message : "Programming Error");
+    abort();
+}
+
+/******************* Memory *******************/
+
+size_t memmgr_get_free_heap(void) {
+    return 0;
+}
+
+size_t memmgr_get_minimum_free_heap(void) {
+    return 0;
+}
+
+void* furi_alloc(size_t size) {
+    void* p = calloc(1, size);
+    furi_check(p);
+    return p;
+}
+
+/******************* Log *******************/
+
+void furi_log_init() {
+    furi_shim.log_level = FURI_LOG_LEVEL;
+    furi_shim.puts = furi_shim_puts;
+    furi_shim.timestamp = millis;
+}
+
+void furi_log_print(FuriLogLevel level, const char* format, ...) {
+    if(level > furi_shim.log_level) return;
+
+    char buffer[256];
+    pthread_mutex_lock(&furi_shim_mutex);
+
+    snprintf(buffer, sizeof(buffer), "%u ", (unsigned int)furi_shim.timestamp());
+    furi_shim.puts(buffer);
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    furi_shim.puts(buffer);
+
+    pthread_mutex_unlock(&furi_shim_mutex);
+}
+
+void furi_log_set_level(FuriLogLevel level) {
+    furi_shim.log_level = level;
+}
+
+FuriLogLevel furi_log_get_level(void) {
+    return furi_shim.log_level;
+}
+
+void furi_log_set_puts(FuriLogPuts puts) {
+    furi_assert(puts);
+    furi_shim.puts = puts;
+}
+
+void furi_log_set_timestamp(FuriLogTimestamp timestamp) {
+    furi_assert(timestamp);
+    furi_shim.timestamp = timestamp;
+}
+
+/******************* Record *******************/
+
+static FuriShimRecord* furi_shim_record_find(const char* name) {
+    for(size_t i = 0; i < furi_shim.records_count; i++) {
+        if(!strcmp(furi_shim.records[i].name, name)) return &furi_shim.records[i];
+    }
+    return NULL;
+}
+
+void furi_record_init() {
+}
+
+void furi_record_create(const char* name, void* data) {
+    pthread_mutex_lock(&furi_shim_mutex);
+    FuriShimRecord* record = furi_shim_record_find(name);
+    if(!record) {
+        furi_check(furi_shim.records_count < FURI_SHIM_RECORDS_MAX);
+        record = &furi_shim.records[furi_shim.records_count++];
+        record->name = name;
+    }
+    record->data = data;
+    pthread_mutex_unlock(&furi_shim_mutex);
+}
+
+bool furi_record_destroy(const char* name) {
+    pthread_mutex_lock(&furi_shim_mutex);
+    FuriShimRecord* record = furi_shim_record_find(name);
+    if(record) {
+        *record = furi_shim.records[--furi_shim.records_count];
+    }
+    pthread_mutex_unlock(&furi_shim_mutex);
+    return record != NULL;
+}
+
+void* furi_record_open(const char* name) {
+    pthread_mutex_lock(&furi_shim_mutex);
+    FuriShimRecord* record = furi_shim_record_find(name);
+    pthread_mutex_unlock(&furi_shim_mutex);
+    // There is no other thread to create a record, so waiting is pointless
+    if(!record) furi_crash("furi_record_open: record not found");
+    return record->data;
+}
+
+void furi_record_close(const char* name) {
+    furi_assert(furi_shim_record_find(name));
+}
+
+void furi_shim_critical_enter() {
+    pthread_mutex_lock(&furi_shim_critical_mutex);
+}
+
+void furi_shim_critical_exit() {
+    pthread_mutex_unlock(&furi_shim_critical_mutex);
+}
+
+/******************* HAL *******************/
+
+// Decoders convert DWT cycles with it, replayed timings are scaled to the same clock
+uint32_t SystemCoreClock = 64000000;
+
+uint64_t furi_hal_host_get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+uint32_t furi_hal_delay_get_cycles(void) {
+    return furi_hal_host_get_time_ns() * (SystemCoreClock / 1000000) / 1000;
+}
+
+uint32_t millis(void) {
+    return furi_hal_host_get_time_ns() / 1000000ULL;
+}
+
+void delay(float milliseconds) {
+    delay_us(milliseconds * 1000.0f);
+}
+
+void delay_us(float microseconds) {
+    if(microseconds <= 0) return;
+    uint64_t ns = microseconds * 1000.0f;
+    struct timespec ts = {.tv_sec = ns / 1000000000ULL, .tv_nsec = ns % 1000000000ULL};
+    nanosleep(&ts, NULL);
+}
+
+// There is no secure enclave on host: encrypted keystores can't be loaded
+
+bool furi_hal_crypto_store_add_key(FuriHalCryptoKey* key, uint8_t* slot) {
+    return false;
+}
+
+bool furi_hal_crypto_store_load_key(uint8_t slot, const uint8_t* iv) {
+    FURI_LOG_E("FuriHalCrypto", "Key slots are not available on host");
+    return false;
+}
+
+bool furi_hal_crypto_store_unload_key(uint8_t slot) {
+    return false;
+}
+
+bool furi_hal_crypto_encrypt(const uint8_t* input, uint8_t* output, size_t size) {
+    return false;
+}
+
+bool furi_hal_crypto_decrypt(const uint8_t* input, uint8_t* output, size_t size) {
+    return false;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file furi.h
+ * Host furi shim: subset of Furi used by lib/, backed by libc and pthreads
+ */
+
+#pragma once
+
+#include <cmsis_os2.h>
+
+/* No interrupts to mask on host, critical section is a process wide recursive lock.
+ * Replaces firmware macros even if furi/common_defines.h was included first */
+#undef FURI_CRITICAL_ENTER
+#undef FURI_CRITICAL_EXIT
+#define FURI_CRITICAL_ENTER() furi_shim_critical_enter()
+#define FURI_CRITICAL_EXIT() furi_shim_critical_exit()
+
+#include <furi/common_defines.h>
+#include <furi/check.h>
+#include <furi/memmgr.h>
+#include <furi/pubsub.h>
+#include <furi/record.h>
+#include <furi/stats.h>
+#include <furi/thread.h>
+#include <furi/log.h>
+
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void furi_init();
+
+void furi_shim_critical_enter();
+
+void furi_shim_critical_exit();
+
+/** Core clock of the target, comes with FreeRTOSConfig.h in firmware */
+extern uint32_t SystemCoreClock;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,239 @@
+/**
+ * @file storage.h
+ * Host furi shim: POSIX backed subset of the Storage API
+ *
+ * Signatures match applications/storage/storage.h. Paths starting with
+ * /int, /ext or /any are mapped into the directory set with
+ * storage_host_set_root() or FLIPPER_HOST_STORAGE environment variable,
+ * other paths are used as is.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <m-string.h>
+#include <storage/filesystem-api-defines.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct Storage Storage;
+
+/** Set host directory that replaces /int, /ext and /any prefixes
+ * @param root host directory path, NULL to use current directory
+ */
+void storage_host_set_root(const char* root);
+
+/** Allocates and initializes a file descriptor
+ * @return File*
+ */
+File* storage_file_alloc(Storage* storage);
+
+/** Frees the file descriptor. Closes the file if it was open.
+ */
+void storage_file_free(File* file);
+
+/******************* File Functions *******************/
+
+/** Opens an existing file or create a new one.
+ * @param file pointer to file object.
+ * @param path path to file 
+ * @param access_mode access mode from FS_AccessMode 
+ * @param open_mode open mode from FS_OpenMode 
+ * @return success flag. You need to close the file even if the open operation failed.
+ */
+bool storage_file_open(
+    File* file,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode);
+
+/** Close the file.
+ * @param file pointer to a file object, the file object will be freed.
+ * @return success flag
+ */
+bool storage_file_close(File* file);
+
+/** Tells if the file is open
+ * @param file pointer to a file object
+ * @return bool true if file is open
+ */
+bool storage_file_is_open(File* file);
+
+/** Reads bytes from a file into a buffer
+ * @param file pointer to file object.
+ * @param buff pointer to a buffer, for reading
+ * @param bytes_to_read how many bytes to read. Must be less than or equal to the size of the buffer.
+ * @return uint32_t how many bytes were actually readed
+ */
+uint32_t storage_file_read(File* file, void* buff, uint32_t bytes_to_read);
+
+/** Writes bytes from a buffer to a file
+ * @param file pointer to file object.
+ * @param buff pointer to buffer, for writing
+ * @param bytes_to_write how many bytes to write. Must be less than or equal to the size of the buffer.
+ * @return uint32_t how many bytes were actually written
+ */
+uint32_t storage_file_write(File* file, const void* buff, uint32_t bytes_to_write);
+
+/** Attaches a buffer to the file, buffering is the same code as in firmware.
+ * Buffer is flushed by sync, truncate, size, close and by detaching, and stays attached until the file is closed.
+ * @param file pointer to file object, must be open
+ * @param buffer pointer to buffer, NULL to flush and detach current one
+ * @param buffer_size buffer size
+ * @return bool success flag, false if pending writes couldn't be flushed
+ */
+bool storage_file_set_buffer(File* file, void* buffer, uint32_t buffer_size);
+
+/** Moves the r/w pointer 
+ * @param file pointer to file object.
+ * @param offset offset to move the r/w pointer
+ * @param from_start set an offset from the start or from the current position
+ * @return success flag
+ */
+bool storage_file_seek(File* file, uint32_t offset, bool from_start);
+
+/** Gets the position of the r/w pointer 
+ * @param file pointer to file object.
+ * @return uint64_t position of the r/w pointer 
+ */
+uint64_t storage_file_tell(File* file);
+
+/** Truncates the file size to the current position of the r/w pointer
+ * @param file pointer to file object.
+ * @return bool success flag
+ */
+bool storage_file_truncate(File* file);
+
+/** Gets the size of the file
+ * @param file pointer to file object.
+ * @return uint64_t size of the file
+ */
+uint64_t storage_file_size(File* file);
+
+/** Writes file cache data to the storage
+ * @param file pointer to file object.
+ * @return bool success flag
+ */
+bool storage_file_sync(File* file);
+
+/** Checks that the r/w pointer is at the end of the file
+ * @param file pointer to file object.
+ * @return bool success flag
+ */
+bool storage_file_eof(File* file);
+
+/******************* Dir Functions *******************/
+
+/** Opens a directory to get objects from it
+ * @param file pointer to file object.
+ * @param path path to directory
+ * @return bool success flag. You need to close the directory even if the open operation failed.
+ */
+bool storage_dir_open(File* file, const char* path);
+
+/** Close the directory.
+ * @param file pointer to a file object.
+ * @return bool success flag
+ */
+bool storage_dir_close(File* file);
+
+/** Reads the next object in the directory
+ * @param file pointer to file object.
+ * @param fileinfo pointer to the readed FileInfo, may be NULL
+ * @param name pointer to name buffer, may be NULL
+ * @param name_length name buffer length
+ * @return success flag (if the next object does not exist, it also returns false and sets the file error id to FSE_NOT_EXIST)
+ */
+bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_length);
+
+/** Rewinds the read pointer to first item in the directory
+ * @param file pointer to file object.
+ * @return bool success flag
+ */
+bool storage_dir_rewind(File* file);
+
+/******************* Common Functions *******************/
+
+/** Retrieves information about a file/directory
+ * @param path path to file/directory
+ * @param fileinfo pointer to the readed FileInfo, may be NULL
+ * @return FS_Error operation result
+ */
+FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo);
+
+/** Removes a file/directory, the directory must be empty
+ * @param path 
+ * @return FS_Error operation result
+ */
+FS_Error storage_common_remove(Storage* storage, const char* path);
+
+/** Renames file/directory
+ * @param old_path old path
+ * @param new_path new path
+ * @return FS_Error operation result
+ */
+FS_Error storage_common_rename(Storage* storage, const char* old_path, const char* new_path);
+
+/** Creates a directory
+ * @param path directory path
+ * @return FS_Error operation result
+ */
+FS_Error storage_common_mkdir(Storage* storage, const char* path);
+
+/******************* Error Functions *******************/
+
+/** Retrieves the error text from the error id
+ * @param error_id error id
+ * @return const char* error text
+ */
+const char* storage_error_get_desc(FS_Error error_id);
+
+/** Retrieves the error id from the file object
+ * @param file pointer to file object.
+ * @return FS_Error error id
+ */
+FS_Error storage_file_get_error(File* file);
+
+/** Retrieves the internal (errno) error id from the file object
+ * @param file pointer to file object.
+ * @return FS_Error error id
+ */
+int32_t storage_file_get_internal_error(File* file);
+
+/** Retrieves the error text from the file object
+ * @param file pointer to file object.
+ * @return const char* error text
+ */
+const char* storage_file_get_error_desc(File* file);
+
+/***************** Simplified Functions ******************/
+
+/**
+ * Removes a file/directory, the directory must be empty
+ * @param storage pointer to the api
+ * @param path 
+ * @return true on success or if file/dir is not exist
+ */
+bool storage_simply_remove(Storage* storage, const char* path);
+
+/**
+ * Removes a file/directory from the repository, the directory can be not empty
+ * @param storage pointer to the api
+ * @param path
+ * @return true on success or if file/dir is not exist
+ */
+bool storage_simply_remove_recursive(Storage* storage, const char* path);
+
+/**
+ * Creates a directory
+ * @param storage 
+ * @param path 
+ * @return true on success or if directory is already exist
+ */
+bool storage_simply_mkdir(Storage* storage, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
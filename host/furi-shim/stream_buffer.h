@@ -0,0 +1,52 @@
+/**
+ * @file stream_buffer.h
+ * Host furi shim: FreeRTOS stream buffer subset backed by pthreads
+ */
+
+#pragma once
+
+#include <FreeRTOS.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct StreamBufferDef_t* StreamBufferHandle_t;
+
+StreamBufferHandle_t xStreamBufferCreate(size_t buffer_size, size_t trigger_level);
+
+void vStreamBufferDelete(StreamBufferHandle_t stream);
+
+size_t xStreamBufferSend(
+    StreamBufferHandle_t stream,
+    const void* data,
+    size_t length,
+    TickType_t ticks_to_wait);
+
+size_t xStreamBufferSendFromISR(
+    StreamBufferHandle_t stream,
+    const void* data,
+    size_t length,
+    BaseType_t* higher_priority_task_woken);
+
+size_t xStreamBufferReceive(
+    StreamBufferHandle_t stream,
+    void* data,
+    size_t length,
+    TickType_t ticks_to_wait);
+
+size_t xStreamBufferReceiveFromISR(
+    StreamBufferHandle_t stream,
+    void* data,
+    size_t length,
+    BaseType_t* higher_priority_task_woken);
+
+size_t xStreamBufferSpacesAvailable(StreamBufferHandle_t stream);
+
+size_t xStreamBufferBytesAvailable(StreamBufferHandle_t stream);
+
+BaseType_t xStreamBufferReset(StreamBufferHandle_t stream);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,25 @@
+/**
+ * @file task.h
+ * Host furi shim: scheduler suspension, one recursive lock for all threads
+ */
+
+#pragma once
+
+#include <FreeRTOS.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Suspend scheduler, nests */
+void vTaskSuspendAll(void);
+
+/** Resume scheduler
+ *
+ * @return     pdFALSE
+ */
+BaseType_t xTaskResumeAll(void);
+
+#ifdef __cplusplus
+}
+#endif
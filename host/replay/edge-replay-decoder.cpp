@@ -0,0 +1,104 @@
+#include "edge-replay-i.h"
+#include <furi.h>
+
+#include <lfrfid/helpers/decoder-emmarin.h>
+#include <lfrfid/helpers/decoder-hid26.h>
+#include <lfrfid/helpers/decoder-indala.h>
+#include <ibutton/helpers/cyfral-decoder.h>
+#include <ibutton/helpers/metakom-decoder.h>
+
+class EdgeDecoderGeneric {
+public:
+    virtual void process_front(bool polarity, uint32_t time) = 0;
+    virtual bool read(uint8_t* data, uint8_t data_size) = 0;
+    virtual ~EdgeDecoderGeneric(){};
+};
+
+template <class T> class EdgeDecoderAdapter : public EdgeDecoderGeneric {
+public:
+    void process_front(bool polarity, uint32_t time) {
+        decoder.process_front(polarity, time);
+    }
+
+    bool read(uint8_t* data, uint8_t data_size) {
+        return decoder.read(data, data_size);
+    }
+
+private:
+    T decoder;
+};
+
+struct EdgeDecoder {
+    EdgeDecoderGeneric* decoder;
+    uint8_t data_size;
+};
+
+EdgeDecoder* edge_decoder_alloc(EdgeProtocol protocol) {
+    EdgeDecoder* decoder = static_cast<EdgeDecoder*>(furi_alloc(sizeof(EdgeDecoder)));
+    decoder->data_size = edge_protocol_get_data_size(protocol);
+
+    switch(protocol) {
+    case EdgeProtocolEM4100:
+        decoder->decoder = new EdgeDecoderAdapter<DecoderEMMarin>();
+        break;
+    case EdgeProtocolH10301:
+        decoder->decoder = new EdgeDecoderAdapter<DecoderHID26>();
+        break;
+    case EdgeProtocolI40134:
+        decoder->decoder = new EdgeDecoderAdapter<DecoderIndala>();
+        break;
+    case EdgeProtocolCyfral:
+        decoder->decoder = new EdgeDecoderAdapter<CyfralDecoder>();
+        break;
+    case EdgeProtocolMetakom:
+        decoder->decoder = new EdgeDecoderAdapter<MetakomDecoder>();
+        break;
+    default:
+        furi_crash("Unknown edge protocol");
+        break;
+    }
+
+    return decoder;
+}
+
+void edge_decoder_free(EdgeDecoder* decoder) {
+    furi_assert(decoder);
+    delete decoder->decoder;
+    free(decoder);
+}
+
+void edge_decoder_process(EdgeDecoder* decoder, bool polarity, uint32_t time) {
+    decoder->decoder->process_front(polarity, time);
+}
+
+bool edge_decoder_read(EdgeDecoder* decoder, uint8_t* data) {
+    return decoder->decoder->read(data, decoder->data_size);
+}
+
+void edge_protocol_encode(EdgeProtocol protocol, const uint8_t* key, uint8_t* encoded) {
+    ProtocolEMMarin em_marin;
+    ProtocolHID10301 hid;
+    ProtocolIndala40134 indala;
+    ProtocolGeneric* generic = nullptr;
+
+    switch(protocol) {
+    case EdgeProtocolEM4100:
+        generic = &em_marin;
+        break;
+    case EdgeProtocolH10301:
+        generic = &hid;
+        break;
+    case EdgeProtocolI40134:
+        generic = &indala;
+        break;
+    default:
+        furi_crash("Not an LF RFID protocol");
+        break;
+    }
+
+    generic->encode(
+        key,
+        generic->get_decoded_data_size(),
+        encoded,
+        EDGE_PROTOCOL_ENCODED_SIZE);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "edge-replay.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EDGE_PROTOCOL_ENCODED_SIZE 12
+
+/** Encode LF RFID key with firmware protocol, the way emulator does
+ * @param encoded EDGE_PROTOCOL_ENCODED_SIZE bytes, layout of protocol encode()
+ */
+void edge_protocol_encode(EdgeProtocol protocol, const uint8_t* key, uint8_t* encoded);
+
+#ifdef __cplusplus
+}
+#endif
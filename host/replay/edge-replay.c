@@ -0,0 +1,414 @@
+#include "edge-replay-i.h"
+#include <furi.h>
+#include <furi-hal.h>
+#include <flipper_file.h>
+#include <string.h>
+
+#define TAG "EdgeReplay"
+
+#define EDGE_CAPTURE_FILETYPE "Flipper Edge Capture"
+#define EDGE_CAPTURE_VERSION 1
+#define EDGE_CAPTURE_LINE_SIZE 512
+#define EDGE_CAPTURE_CAPACITY_INITIAL 1024
+
+/* Bit timings of synthesized captures, us */
+#define EDGE_EM4100_BIT 512
+#define EDGE_H10301_ZERO_CYCLE 64
+#define EDGE_H10301_ZERO_CYCLES 6
+#define EDGE_H10301_ONE_CYCLE 80
+#define EDGE_H10301_ONE_CYCLES 5
+#define EDGE_I40134_BIT 256
+/* iButton bit is split in 1/3 and 2/3 of period, as emulator does */
+#define EDGE_IBUTTON_PERIOD 125
+#define EDGE_IBUTTON_SHORT (EDGE_IBUTTON_PERIOD / 3)
+#define EDGE_IBUTTON_LONG (EDGE_IBUTTON_PERIOD - EDGE_IBUTTON_SHORT)
+
+typedef struct {
+    const char* name;
+    uint8_t data_size;
+} EdgeProtocolInfo;
+
+static const EdgeProtocolInfo edge_protocols[EdgeProtocolMax] = {
+    [EdgeProtocolEM4100] = {.name = "EM4100", .data_size = 5},
+    [EdgeProtocolH10301] = {.name = "H10301", .data_size = 3},
+    [EdgeProtocolI40134] = {.name = "I40134", .data_size = 3},
+    [EdgeProtocolCyfral] = {.name = "Cyfral", .data_size = 2},
+    [EdgeProtocolMetakom] = {.name = "Metakom", .data_size = 4},
+};
+
+struct EdgeCapture {
+    EdgeProtocol protocol;
+    uint8_t key[EDGE_CAPTURE_KEY_SIZE];
+
+    int32_t* levels;
+    size_t count;
+    size_t capacity;
+};
+
+typedef struct {
+    EdgeCapture* capture;
+    uint32_t jitter_us;
+    uint32_t random;
+    int32_t offset; /**< Shift of the last edge, us */
+} EdgeGenerator;
+
+const char* edge_protocol_get_name(EdgeProtocol protocol) {
+    furi_assert(protocol < EdgeProtocolMax);
+    return edge_protocols[protocol].name;
+}
+
+bool edge_protocol_get_by_name(const char* name, EdgeProtocol* protocol) {
+    for(size_t i = 0; i < EdgeProtocolMax; i++) {
+        if(strcmp(edge_protocols[i].name, name) == 0) {
+            *protocol = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint8_t edge_protocol_get_data_size(EdgeProtocol protocol) {
+    furi_assert(protocol < EdgeProtocolMax);
+    return edge_protocols[protocol].data_size;
+}
+
+EdgeCapture* edge_capture_alloc() {
+    EdgeCapture* capture = furi_alloc(sizeof(EdgeCapture));
+    capture->capacity = EDGE_CAPTURE_CAPACITY_INITIAL;
+    capture->levels = furi_alloc(capture->capacity * sizeof(int32_t));
+    return capture;
+}
+
+void edge_capture_free(EdgeCapture* capture) {
+    furi_assert(capture);
+    free(capture->levels);
+    free(capture);
+}
+
+void edge_capture_reset(EdgeCapture* capture) {
+    furi_assert(capture);
+    capture->protocol = EdgeProtocolEM4100;
+    memset(capture->key, 0, sizeof(capture->key));
+    capture->count = 0;
+}
+
+void edge_capture_set_key(EdgeCapture* capture, EdgeProtocol protocol, const uint8_t* key) {
+    furi_assert(capture);
+    furi_assert(protocol < EdgeProtocolMax);
+    capture->protocol = protocol;
+    memset(capture->key, 0, sizeof(capture->key));
+    memcpy(capture->key, key, edge_protocol_get_data_size(protocol));
+}
+
+EdgeProtocol edge_capture_get_protocol(EdgeCapture* capture) {
+    furi_assert(capture);
+    return capture->protocol;
+}
+
+const uint8_t* edge_capture_get_key(EdgeCapture* capture) {
+    furi_assert(capture);
+    return capture->key;
+}
+
+static void edge_capture_add_raw(EdgeCapture* capture, int32_t value) {
+    if(capture->count > 0 && (capture->levels[capture->count - 1] > 0) == (value > 0)) {
+        capture->levels[capture->count - 1] += value;
+        return;
+    }
+
+    if(capture->count == capture->capacity) {
+        capture->capacity *= 2;
+        capture->levels = realloc(capture->levels, capture->capacity * sizeof(int32_t));
+        furi_check(capture->levels);
+    }
+    capture->levels[capture->count++] = value;
+}
+
+void edge_capture_add(EdgeCapture* capture, bool level, uint32_t duration_us) {
+    furi_assert(capture);
+    if(duration_us == 0) return;
+    edge_capture_add_raw(capture, level ? (int32_t)duration_us : -(int32_t)duration_us);
+}
+
+size_t edge_capture_get_count(EdgeCapture* capture) {
+    furi_assert(capture);
+    return capture->count;
+}
+
+bool edge_capture_load(EdgeCapture* capture, Storage* storage, const char* path) {
+    furi_assert(capture);
+    FlipperFile* flipper_file = flipper_file_alloc(storage);
+    int32_t* line = malloc(EDGE_CAPTURE_LINE_SIZE * sizeof(int32_t));
+    string_t temp_str;
+    string_init(temp_str);
+    bool result = false;
+
+    edge_capture_reset(capture);
+
+    do {
+        uint32_t version;
+        EdgeProtocol protocol;
+        uint8_t key[EDGE_CAPTURE_KEY_SIZE] = {0};
+
+        if(!flipper_file_open_existing(flipper_file, path)) break;
+        if(!flipper_file_read_header(flipper_file, temp_str, &version)) break;
+        if(string_cmp_str(temp_str, EDGE_CAPTURE_FILETYPE) != 0 ||
+           version != EDGE_CAPTURE_VERSION) {
+            FURI_LOG_E(TAG, "Not an edge capture: %s", path);
+            break;
+        }
+
+        if(!flipper_file_read_string(flipper_file, "Protocol", temp_str)) break;
+        if(!edge_protocol_get_by_name(string_get_cstr(temp_str), &protocol)) {
+            FURI_LOG_E(TAG, "Unknown protocol %s", string_get_cstr(temp_str));
+            break;
+        }
+        if(!flipper_file_read_hex(
+               flipper_file, "Key", key, edge_protocol_get_data_size(protocol))) {
+            break;
+        }
+        edge_capture_set_key(capture, protocol, key);
+
+        uint16_t count = 0;
+        while(flipper_file_read_int32_chunk(
+            flipper_file, "RAW_Data", line, EDGE_CAPTURE_LINE_SIZE, &count)) {
+            for(uint16_t i = 0; i < count; i++) {
+                if(line[i] != 0) edge_capture_add_raw(capture, line[i]);
+            }
+        }
+
+        result = capture->count > 0;
+    } while(0);
+
+    flipper_file_close(flipper_file);
+    flipper_file_free(flipper_file);
+    string_clear(temp_str);
+    free(line);
+    return result;
+}
+
+bool edge_capture_save(EdgeCapture* capture, Storage* storage, const char* path) {
+    furi_assert(capture);
+    FlipperFile* flipper_file = flipper_file_alloc(storage);
+    bool result = false;
+
+    do {
+        if(!flipper_file_open_always(flipper_file, path)) break;
+        if(!flipper_file_write_header_cstr(
+               flipper_file, EDGE_CAPTURE_FILETYPE, EDGE_CAPTURE_VERSION)) {
+            break;
+        }
+        if(!flipper_file_write_string_cstr(
+               flipper_file, "Protocol", edge_protocol_get_name(capture->protocol))) {
+            break;
+        }
+        if(!flipper_file_write_hex(
+               flipper_file,
+               "Key",
+               capture->key,
+               edge_protocol_get_data_size(capture->protocol))) {
+            break;
+        }
+
+        size_t written = 0;
+        while(written < capture->count) {
+            size_t count = MIN(capture->count - written, (size_t)EDGE_CAPTURE_LINE_SIZE);
+            if(!flipper_file_write_int32(
+                   flipper_file, "RAW_Data", &capture->levels[written], count)) {
+                break;
+            }
+            written += count;
+        }
+
+        result = written == capture->count;
+    } while(0);
+
+    flipper_file_close(flipper_file);
+    flipper_file_free(flipper_file);
+    return result;
+}
+
+/* xorshift32, captures must be the same on every run */
+static uint32_t edge_generator_random(EdgeGenerator* generator) {
+    uint32_t x = generator->random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    generator->random = x;
+    return x;
+}
+
+/* Every edge is shifted by up to jitter_us, so error doesn't build up over the capture.
+ * Levels of the same polarity are merged, shifts between them cancel out. */
+static void edge_generator_level(EdgeGenerator* generator, bool level, uint32_t duration_us) {
+    int32_t duration = duration_us;
+    if(generator->jitter_us) {
+        int32_t offset = edge_generator_random(generator) % (generator->jitter_us * 2 + 1);
+        offset -= generator->jitter_us;
+        duration = MAX(duration + offset - generator->offset, 1);
+        generator->offset = offset;
+    }
+    edge_capture_add_raw(generator->capture, level ? duration : -duration);
+}
+
+/* Manchester, 0 is low to high, 1 is high to low */
+static void edge_generate_em4100(EdgeGenerator* generator, const uint8_t* encoded) {
+    uint64_t card_data;
+    memcpy(&card_data, encoded, sizeof(uint64_t));
+
+    for(uint8_t i = 0; i < 64; i++) {
+        bool bit = (card_data >> (63 - i)) & 1;
+        edge_generator_level(generator, bit, EDGE_EM4100_BIT / 2);
+        edge_generator_level(generator, !bit, EDGE_EM4100_BIT / 2);
+    }
+}
+
+/* FSK, carrier divided by 8 for 0 and by 10 for 1 */
+static void edge_generate_h10301(EdgeGenerator* generator, const uint8_t* encoded) {
+    uint32_t card_data[3];
+    memcpy(card_data, encoded, sizeof(card_data));
+
+    for(uint8_t i = 0; i < 96; i++) {
+        bool bit = (card_data[i / 32] >> (31 - (i % 32))) & 1;
+        uint32_t cycle = bit ? EDGE_H10301_ONE_CYCLE : EDGE_H10301_ZERO_CYCLE;
+        uint32_t cycles = bit ? EDGE_H10301_ONE_CYCLES : EDGE_H10301_ZERO_CYCLES;
+        for(uint32_t c = 0; c < cycles; c++) {
+            edge_generator_level(generator, false, cycle / 2);
+            edge_generator_level(generator, true, cycle / 2);
+        }
+    }
+}
+
+/* PSK, demodulated: comparator output is low for 1 */
+static void edge_generate_i40134(EdgeGenerator* generator, const uint8_t* encoded) {
+    uint64_t card_data;
+    memcpy(&card_data, encoded, sizeof(uint64_t));
+
+    for(uint8_t i = 0; i < 64; i++) {
+        bool bit = (card_data >> (63 - i)) & 1;
+        edge_generator_level(generator, !bit, EDGE_I40134_BIT);
+    }
+}
+
+/* Bit is high then low, long low is 1 */
+static void edge_generate_cyfral_nibble(EdgeGenerator* generator, uint8_t nibble) {
+    for(int8_t i = 3; i >= 0; i--) {
+        bool bit = (nibble >> i) & 1;
+        edge_generator_level(generator, true, bit ? EDGE_IBUTTON_SHORT : EDGE_IBUTTON_LONG);
+        edge_generator_level(generator, false, bit ? EDGE_IBUTTON_LONG : EDGE_IBUTTON_SHORT);
+    }
+}
+
+/* Start nibble and 8 nibbles with one 0 bit each, 2 data bits per nibble */
+static void edge_generate_cyfral(EdgeGenerator* generator, const uint8_t* key) {
+    static const uint8_t nibbles[] = {0b0111, 0b1011, 0b1101, 0b1110};
+    uint16_t key_data = key[0] | (key[1] << 8);
+
+    edge_generate_cyfral_nibble(generator, 0b0001);
+    for(int8_t i = 7; i >= 0; i--) {
+        edge_generate_cyfral_nibble(generator, nibbles[(key_data >> (i * 2)) & 0b11]);
+    }
+}
+
+/* Bit is low then high, long low is 1 */
+static void edge_generate_metakom_bit(EdgeGenerator* generator, bool bit, uint32_t extra_high) {
+    edge_generator_level(generator, false, bit ? EDGE_IBUTTON_LONG : EDGE_IBUTTON_SHORT);
+    edge_generator_level(
+        generator, true, (bit ? EDGE_IBUTTON_SHORT : EDGE_IBUTTON_LONG) + extra_high);
+}
+
+/* Start word 010 and 4 bytes, high after the last bit is the start pulse of next packet */
+static void edge_generate_metakom(EdgeGenerator* generator, const uint8_t* key) {
+    edge_generate_metakom_bit(generator, 0, 0);
+    edge_generate_metakom_bit(generator, 1, 0);
+    edge_generate_metakom_bit(generator, 0, 0);
+
+    for(int8_t i = 3; i >= 0; i--) {
+        for(int8_t j = 7; j >= 0; j--) {
+            uint32_t extra_high = (i == 0 && j == 0) ? EDGE_IBUTTON_PERIOD : 0;
+            edge_generate_metakom_bit(generator, (key[i] >> j) & 1, extra_high);
+        }
+    }
+}
+
+void edge_capture_generate(
+    EdgeCapture* capture,
+    EdgeProtocol protocol,
+    const uint8_t* key,
+    uint32_t packets,
+    uint32_t jitter_us,
+    uint32_t seed) {
+    furi_assert(capture);
+    EdgeGenerator generator = {
+        .capture = capture,
+        .jitter_us = jitter_us,
+        .random = seed ? seed : 1,
+    };
+    uint8_t encoded[EDGE_PROTOCOL_ENCODED_SIZE] = {0};
+
+    edge_capture_reset(capture);
+    edge_capture_set_key(capture, protocol, key);
+
+    if(protocol == EdgeProtocolEM4100 || protocol == EdgeProtocolH10301 ||
+       protocol == EdgeProtocolI40134) {
+        edge_protocol_encode(protocol, key, encoded);
+    }
+
+    for(uint32_t i = 0; i < packets; i++) {
+        switch(protocol) {
+        case EdgeProtocolEM4100:
+            edge_generate_em4100(&generator, encoded);
+            break;
+        case EdgeProtocolH10301:
+            edge_generate_h10301(&generator, encoded);
+            break;
+        case EdgeProtocolI40134:
+            edge_generate_i40134(&generator, encoded);
+            break;
+        case EdgeProtocolCyfral:
+            edge_generate_cyfral(&generator, key);
+            break;
+        case EdgeProtocolMetakom:
+            edge_generate_metakom(&generator, key);
+            break;
+        default:
+            furi_crash("Unknown edge protocol");
+            break;
+        }
+    }
+
+    // Cyfral decoder needs start nibble of the next packet to finish
+    if(protocol == EdgeProtocolCyfral) {
+        edge_generate_cyfral_nibble(&generator, 0b0001);
+    }
+}
+
+void edge_replay_run(EdgeCapture* capture, EdgeProtocol protocol, EdgeReplayResult* result) {
+    furi_assert(capture);
+    furi_assert(result);
+    EdgeDecoder* decoder = edge_decoder_alloc(protocol);
+    uint8_t data_size = edge_protocol_get_data_size(protocol);
+    uint8_t data[EDGE_CAPTURE_KEY_SIZE];
+    const uint32_t clocks_in_us = SystemCoreClock / 1000000;
+    bool key_expected = (protocol == capture->protocol);
+
+    uint64_t start = furi_hal_host_get_time_ns();
+    for(size_t i = 0; i < capture->count; i++) {
+        int32_t level = capture->levels[i];
+        // Edge that ends a low level is rising
+        bool polarity = level < 0;
+        uint32_t duration = polarity ? -level : level;
+
+        edge_decoder_process(decoder, polarity, duration * clocks_in_us);
+        if(edge_decoder_read(decoder, data)) {
+            result->reads++;
+            if(key_expected && memcmp(data, capture->key, data_size) == 0) {
+                result->matches++;
+            }
+        }
+    }
+    result->time_ns += furi_hal_host_get_time_ns() - start;
+    result->edges += capture->count;
+
+    edge_decoder_free(decoder);
+}
@@ -0,0 +1,124 @@
+/**
+ * @file edge-replay.h
+ * Replay of LF RFID and iButton edge captures through firmware decoders
+ *
+ * Capture is a FlipperFile with level durations in us, same as SubGhz RAW:
+ *
+ *     Filetype: Flipper Edge Capture
+ *     Version: 1
+ *     Protocol: EM4100
+ *     Key: 01 23 45 67 89
+ *     RAW_Data: 256 -256 512 -256 ...
+ *
+ * Positive duration is high level, negative is low. Replay turns the end of
+ * each level into an edge, just like comparator ISR: polarity is the level
+ * after the edge, time is level duration in DWT cycles.
+ * Protocol and Key tell which key is expected to be read from the capture.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EDGE_CAPTURE_KEY_SIZE 8
+
+typedef enum {
+    EdgeProtocolEM4100,
+    EdgeProtocolH10301,
+    EdgeProtocolI40134,
+    EdgeProtocolCyfral,
+    EdgeProtocolMetakom,
+    EdgeProtocolMax,
+} EdgeProtocol;
+
+typedef struct EdgeDecoder EdgeDecoder;
+
+typedef struct EdgeCapture EdgeCapture;
+
+typedef struct {
+    size_t edges;
+    size_t reads; /**< Keys read, including wrong ones */
+    size_t matches; /**< Keys equal to the capture key */
+    uint64_t time_ns; /**< Time spent in decoder */
+} EdgeReplayResult;
+
+/** Protocol name, as in capture file */
+const char* edge_protocol_get_name(EdgeProtocol protocol);
+
+/** Find protocol by name
+ * @return false if there is no such protocol
+ */
+bool edge_protocol_get_by_name(const char* name, EdgeProtocol* protocol);
+
+/** Key data size in bytes */
+uint8_t edge_protocol_get_data_size(EdgeProtocol protocol);
+
+/** Allocate firmware decoder of the protocol */
+EdgeDecoder* edge_decoder_alloc(EdgeProtocol protocol);
+
+void edge_decoder_free(EdgeDecoder* decoder);
+
+/** Feed edge to decoder, the way comparator ISR does
+ * @param polarity level after the edge
+ * @param time time since previous edge, DWT cycles
+ */
+void edge_decoder_process(EdgeDecoder* decoder, bool polarity, uint32_t time);
+
+/** Get key, the way reader polls decoder
+ * @param data buffer of edge_protocol_get_data_size bytes
+ * @return true if key was read
+ */
+bool edge_decoder_read(EdgeDecoder* decoder, uint8_t* data);
+
+EdgeCapture* edge_capture_alloc();
+
+void edge_capture_free(EdgeCapture* capture);
+
+/** Remove all levels and the key */
+void edge_capture_reset(EdgeCapture* capture);
+
+/** Set expected key */
+void edge_capture_set_key(EdgeCapture* capture, EdgeProtocol protocol, const uint8_t* key);
+
+EdgeProtocol edge_capture_get_protocol(EdgeCapture* capture);
+
+const uint8_t* edge_capture_get_key(EdgeCapture* capture);
+
+/** Append level, adjacent levels of the same polarity are merged */
+void edge_capture_add(EdgeCapture* capture, bool level, uint32_t duration_us);
+
+/** Levels count, that is edges count on replay */
+size_t edge_capture_get_count(EdgeCapture* capture);
+
+bool edge_capture_load(EdgeCapture* capture, Storage* storage, const char* path);
+
+bool edge_capture_save(EdgeCapture* capture, Storage* storage, const char* path);
+
+/** Synthesize capture of the key as it is seen by reader
+ * @param packets packets count, decoders need 2 or 3 to sync
+ * @param jitter_us every level is longer or shorter by up to jitter_us
+ * @param seed jitter random seed, same seed gives same capture
+ */
+void edge_capture_generate(
+    EdgeCapture* capture,
+    EdgeProtocol protocol,
+    const uint8_t* key,
+    uint32_t packets,
+    uint32_t jitter_us,
+    uint32_t seed);
+
+/** Run capture through decoder of the protocol, from a fresh decoder state
+ * @param result stats, added to existing values
+ */
+void edge_replay_run(EdgeCapture* capture, EdgeProtocol protocol, EdgeReplayResult* result);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,124 @@
+#include <furi.h>
+#include <storage/storage.h>
+#include <edge-replay.h>
+#include "tests/minunit.h"
+
+#define TEST_CAPTURE_FILE "/ext/edge_replay_test.edges"
+#define TEST_PACKETS 5
+/* Tightest decoder, HID, misreads FSK cycles with edges shifted by 4us */
+#define TEST_JITTER 2
+
+static const uint8_t test_keys[EdgeProtocolMax][EDGE_CAPTURE_KEY_SIZE] = {
+    [EdgeProtocolEM4100] = {0x01, 0x23, 0x45, 0x67, 0x89},
+    [EdgeProtocolH10301] = {0x71, 0x12, 0x34},
+    [EdgeProtocolI40134] = {0x55, 0x01, 0x02},
+    [EdgeProtocolCyfral] = {0x5A, 0xC3},
+    /* Metakom bytes have even parity */
+    [EdgeProtocolMetakom] = {0x03, 0x05, 0x06, 0x0F},
+};
+
+static EdgeCapture* capture = NULL;
+
+static void test_setup() {
+    capture = edge_capture_alloc();
+}
+
+static void test_teardown() {
+    edge_capture_free(capture);
+    capture = NULL;
+}
+
+MU_TEST(edge_replay_protocol_name_test) {
+    for(size_t i = 0; i < EdgeProtocolMax; i++) {
+        EdgeProtocol protocol;
+        mu_check(edge_protocol_get_by_name(edge_protocol_get_name(i), &protocol));
+        mu_assert_int_eq(i, protocol);
+    }
+    EdgeProtocol protocol;
+    mu_check(!edge_protocol_get_by_name("EM-Marin", &protocol));
+}
+
+MU_TEST(edge_replay_decode_test) {
+    for(size_t i = 0; i < EdgeProtocolMax; i++) {
+        for(uint32_t jitter = 0; jitter <= TEST_JITTER; jitter++) {
+            EdgeReplayResult result = {0};
+            edge_capture_generate(capture, i, test_keys[i], TEST_PACKETS, jitter, i + 1);
+            edge_replay_run(capture, i, &result);
+
+            mu_assert_int_greater_than(0, result.matches);
+            mu_assert_int_eq(result.reads, result.matches);
+            mu_assert_int_eq(edge_capture_get_count(capture), result.edges);
+        }
+    }
+}
+
+MU_TEST(edge_replay_cross_decode_test) {
+    for(size_t i = 0; i < EdgeProtocolMax; i++) {
+        edge_capture_generate(capture, i, test_keys[i], TEST_PACKETS, TEST_JITTER, i + 1);
+        for(size_t decoder = 0; decoder < EdgeProtocolMax; decoder++) {
+            if(decoder == i) continue;
+            EdgeReplayResult result = {0};
+            edge_replay_run(capture, decoder, &result);
+            mu_assert_int_eq(0, result.reads);
+        }
+    }
+}
+
+MU_TEST(edge_replay_wrong_key_test) {
+    uint8_t key[EDGE_CAPTURE_KEY_SIZE];
+    memcpy(key, test_keys[EdgeProtocolEM4100], sizeof(key));
+
+    edge_capture_generate(capture, EdgeProtocolEM4100, key, TEST_PACKETS, 0, 1);
+    key[0] ^= 0xFF;
+    edge_capture_set_key(capture, EdgeProtocolEM4100, key);
+
+    EdgeReplayResult result = {0};
+    edge_replay_run(capture, EdgeProtocolEM4100, &result);
+    mu_assert_int_greater_than(0, result.reads);
+    mu_assert_int_eq(0, result.matches);
+}
+
+MU_TEST(edge_replay_file_test) {
+    Storage* storage = furi_record_open("storage");
+    EdgeCapture* loaded = edge_capture_alloc();
+
+    edge_capture_generate(
+        capture, EdgeProtocolMetakom, test_keys[EdgeProtocolMetakom], TEST_PACKETS, 1, 7);
+    mu_check(edge_capture_save(capture, storage, TEST_CAPTURE_FILE));
+    mu_check(edge_capture_load(loaded, storage, TEST_CAPTURE_FILE));
+
+    mu_assert_int_eq(EdgeProtocolMetakom, edge_capture_get_protocol(loaded));
+    mu_check(
+        memcmp(
+            test_keys[EdgeProtocolMetakom],
+            edge_capture_get_key(loaded),
+            edge_protocol_get_data_size(EdgeProtocolMetakom)) == 0);
+    mu_assert_int_eq(edge_capture_get_count(capture), edge_capture_get_count(loaded));
+
+    EdgeReplayResult saved_result = {0};
+    EdgeReplayResult loaded_result = {0};
+    edge_replay_run(capture, EdgeProtocolMetakom, &saved_result);
+    edge_replay_run(loaded, EdgeProtocolMetakom, &loaded_result);
+    mu_assert_int_eq(saved_result.matches, loaded_result.matches);
+
+    mu_check(storage_simply_remove(storage, TEST_CAPTURE_FILE));
+    mu_check(!edge_capture_load(loaded, storage, TEST_CAPTURE_FILE));
+
+    edge_capture_free(loaded);
+    furi_record_close("storage");
+}
+
+MU_TEST_SUITE(edge_replay) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(edge_replay_protocol_name_test);
+    MU_RUN_TEST(edge_replay_decode_test);
+    MU_RUN_TEST(edge_replay_cross_decode_test);
+    MU_RUN_TEST(edge_replay_wrong_key_test);
+    MU_RUN_TEST(edge_replay_file_test);
+}
+
+int run_minunit_test_edge_replay() {
+    MU_RUN_SUITE(edge_replay);
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,44 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <furi.h>
+#include <storage/storage.h>
+#include "tests/minunit_vars.h"
+
+int run_minunit_test_irda_decoder_encoder();
+int run_minunit_test_flipper_file();
+int run_minunit_test_sector_cache();
+int run_minunit_test_storage_file_buffer();
+int run_minunit_test_furi_stats();
+int run_minunit_test_edge_replay();
+
+void minunit_print_progress(void) {
+}
+
+void minunit_print_fail(const char* str) {
+    printf("%s\n", str);
+}
+
+int main(int argc, char* argv[]) {
+    furi_init();
+
+    /* Tests write to /ext, keep it away from the real storage root */
+    char storage_root[] = "/tmp/flipper-host-tests-XXXXXX";
+    furi_check(mkdtemp(storage_root));
+    storage_host_set_root(storage_root);
+
+    int test_result = 0;
+    test_result |= run_minunit_test_irda_decoder_encoder();
+    test_result |= run_minunit_test_flipper_file();
+    test_result |= run_minunit_test_sector_cache();
+    test_result |= run_minunit_test_storage_file_buffer();
+    test_result |= run_minunit_test_furi_stats();
+    test_result |= run_minunit_test_edge_replay();
+
+    rmdir(storage_root);
+
+    printf("%d tests, %d assertions, %d failures\n", minunit_run, minunit_assert, minunit_fail);
+    printf("%s\n", test_result ? "FAILED" : "PASSED");
+
+    return test_result ? EXIT_FAILURE : EXIT_SUCCESS;
+}
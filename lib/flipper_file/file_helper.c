@@ -166,6 +166,166 @@ bool file_helper_read_value(File* file, string_t value, bool* last) {
     return result;
 }
 
+/** Formats value into buffer, returns its length. Buffer must fit 11 chars. */
+static uint8_t file_helper_format_int32(char* buffer, int32_t value) {
+    char digits[10];
+    uint8_t digits_count = 0;
+    uint8_t length = 0;
+    // Magnitude of INT32_MIN doesn't fit int32
+    uint32_t magnitude = value < 0 ? 0U - (uint32_t)value : (uint32_t)value;
+
+    do {
+        digits[digits_count++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while(magnitude);
+
+    if(value < 0) buffer[length++] = '-';
+    while(digits_count) buffer[length++] = digits[--digits_count];
+    return length;
+}
+
+bool file_helper_write_int32_array(File* file, const int32_t* data, uint16_t data_size) {
+    const uint8_t buffer_size = 64;
+    const uint8_t value_size_max = 12; // sign, 10 digits, space
+    char buffer[buffer_size];
+    uint8_t length = 0;
+    bool result = true;
+
+    for(uint16_t i = 0; result && (i < data_size); i++) {
+        if(buffer_size - length < value_size_max) {
+            result = file_helper_write(file, buffer, length);
+            length = 0;
+        }
+        if(i != 0) buffer[length++] = ' ';
+        length += file_helper_format_int32(&buffer[length], data[i]);
+    }
+
+    if(result && length) result = file_helper_write(file, buffer, length);
+    return result;
+}
+
+static int32_t file_helper_int32_value(bool negative, uint32_t magnitude) {
+    return negative ? (int32_t)(0U - magnitude) : (int32_t)magnitude;
+}
+
+bool file_helper_read_int32_array(
+    File* file,
+    int32_t* data,
+    uint16_t data_size,
+    uint16_t* count,
+    bool* last) {
+    const uint8_t buffer_size = 64;
+    uint8_t buffer[buffer_size];
+    bool error = false;
+    bool done = false;
+
+    // Value being parsed, may span over blocks
+    bool sign = false;
+    bool negative = false;
+    bool digits = false;
+    uint32_t magnitude = 0;
+
+    *count = 0;
+    *last = false;
+
+    while(!done && !error) {
+        uint16_t bytes_were_read = storage_file_read(file, buffer, buffer_size);
+        if(bytes_were_read == 0) {
+            *last = true;
+            break;
+        }
+
+        uint16_t i;
+        for(i = 0; i < bytes_were_read; i++) {
+            uint8_t symbol = buffer[i];
+            if(symbol >= '0' && symbol <= '9') {
+                if(!sign && !digits && *count == data_size) {
+                    done = true;
+                    break;
+                }
+                uint8_t digit = symbol - '0';
+                // INT32_MAX is 2147483647, magnitude of INT32_MIN is one more
+                if(magnitude > 214748364 || (magnitude == 214748364 && digit > 7 + negative)) {
+                    error = true;
+                    break;
+                }
+                magnitude = magnitude * 10 + digit;
+                digits = true;
+            } else if((symbol == '-' || symbol == '+') && !sign && !digits) {
+                if(*count == data_size) {
+                    done = true;
+                    break;
+                }
+                sign = true;
+                negative = (symbol == '-');
+            } else if(
+                symbol == ' ' || symbol == flipper_file_eolr || symbol == flipper_file_eoln) {
+                if(digits) {
+                    data[(*count)++] = file_helper_int32_value(negative, magnitude);
+                    sign = false;
+                    negative = false;
+                    digits = false;
+                    magnitude = 0;
+                } else if(sign) {
+                    error = true;
+                    break;
+                }
+
+                if(symbol == flipper_file_eoln) {
+                    *last = true;
+                    done = true;
+                    break;
+                }
+            } else {
+                error = true;
+                break;
+            }
+        }
+
+        if(done && !file_helper_seek(file, i - bytes_were_read)) error = true;
+    }
+
+    // Last value in file without EOL
+    if(!error && digits) {
+        data[(*count)++] = file_helper_int32_value(negative, magnitude);
+    } else if(sign) {
+        error = true;
+    }
+
+    return !error;
+}
+
+bool file_helper_count_values(File* file, uint32_t* count) {
+    const uint8_t buffer_size = 64;
+    uint8_t buffer[buffer_size];
+    bool separator = true;
+    bool done = false;
+    bool error = false;
+
+    *count = 0;
+    while(!done && !error) {
+        uint16_t bytes_were_read = storage_file_read(file, buffer, buffer_size);
+        if(bytes_were_read == 0) break;
+
+        for(uint16_t i = 0; i < bytes_were_read; i++) {
+            if(buffer[i] == flipper_file_eoln) {
+                if(!file_helper_seek(file, i - bytes_were_read)) error = true;
+                done = true;
+                break;
+            } else if(buffer[i] == ' ') {
+                separator = true;
+            } else if(buffer[i] == flipper_file_eolr) {
+                // Ignore
+            } else if(separator) {
+                separator = false;
+                *count = *count + 1;
+            }
+        }
+    }
+
+    return !error && *count > 0;
+}
+
 bool file_helper_write(File* file, const void* data, uint16_t data_size) {
     uint16_t bytes_written = storage_file_write(file, data, data_size);
     return bytes_written == data_size;
@@ -50,6 +50,42 @@ bool file_helper_seek_to_next_line(File* file);
  */
 bool file_helper_read_value(File* file, string_t value, bool* last);
 
+/**
+ * Writes int32 array as decimal values separated by ' '.
+ * Values are formatted into a block, so there is one storage call per block, not per value.
+ * @param file 
+ * @param data 
+ * @param data_size 
+ * @return true on success write 
+ */
+bool file_helper_write_int32_array(File* file, const int32_t* data, uint16_t data_size);
+
+/**
+ * Reads up to data_size int32 values (separated by ' ') from the rw pointer.
+ * If the line is over, rw pointer is left on the \n symbol, otherwise on the next value.
+ * @param file 
+ * @param data 
+ * @param data_size 
+ * @param count number of values read
+ * @param last true if there are no more values in the line
+ * @return false if value is not a number
+ */
+bool file_helper_read_int32_array(
+    File* file,
+    int32_t* data,
+    uint16_t data_size,
+    uint16_t* count,
+    bool* last);
+
+/**
+ * Counts values (separated by ' ') from the rw pointer to the end of line.
+ * Moves rw pointer to the \n symbol.
+ * @param file 
+ * @param count 
+ * @return false if there are no values
+ */
+bool file_helper_count_values(File* file, uint32_t* count);
+
 /**
  * Write helper
  * @param file 
@@ -12,6 +12,7 @@ FlipperFile* flipper_file_alloc(Storage* storage) {
     FlipperFile* flipper_file = malloc(sizeof(FlipperFile));
     flipper_file->storage = storage;
     flipper_file->file = storage_file_alloc(flipper_file->storage);
+    flipper_file_index_init(flipper_file);
 
     return flipper_file;
 }
@@ -22,13 +23,29 @@ void flipper_file_free(FlipperFile* flipper_file) {
         storage_file_close(flipper_file->file);
     }
     storage_file_free(flipper_file->file);
+    flipper_file_index_free(flipper_file);
     free(flipper_file);
 }
 
+static bool flipper_file_open(
+    FlipperFile* flipper_file,
+    const char* filename,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    flipper_file_index_reset(flipper_file);
+    bool result = storage_file_open(flipper_file->file, filename, access_mode, open_mode);
+    if(result) {
+        // Line and key parsers read and seek in small steps, keep them off the storage thread
+        storage_file_set_buffer(
+            flipper_file->file, flipper_file->buffer, FLIPPER_FILE_BUFFER_SIZE);
+    }
+    return result;
+}
+
 bool flipper_file_open_existing(FlipperFile* flipper_file, const char* filename) {
     furi_assert(flipper_file);
-    bool result = storage_file_open(
-        flipper_file->file, filename, FSAM_READ | FSAM_WRITE, FSOM_OPEN_EXISTING);
+    bool result =
+        flipper_file_open(flipper_file, filename, FSAM_READ | FSAM_WRITE, FSOM_OPEN_EXISTING);
     return result;
 }
 
@@ -36,7 +53,7 @@ bool flipper_file_open_append(FlipperFile* flipper_file, const char* filename) {
     furi_assert(flipper_file);
 
     bool result =
-        storage_file_open(flipper_file->file, filename, FSAM_READ | FSAM_WRITE, FSOM_OPEN_APPEND);
+        flipper_file_open(flipper_file, filename, FSAM_READ | FSAM_WRITE, FSOM_OPEN_APPEND);
 
     // Add EOL if it is not there
     if(storage_file_size(flipper_file->file) >= 1) {
@@ -62,20 +79,21 @@ bool flipper_file_open_append(FlipperFile* flipper_file, const char* filename) {
 
 bool flipper_file_open_always(FlipperFile* flipper_file, const char* filename) {
     furi_assert(flipper_file);
-    bool result = storage_file_open(
-        flipper_file->file, filename, FSAM_READ | FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    bool result =
+        flipper_file_open(flipper_file, filename, FSAM_READ | FSAM_WRITE, FSOM_CREATE_ALWAYS);
     return result;
 }
 
 bool flipper_file_open_new(FlipperFile* flipper_file, const char* filename) {
     furi_assert(flipper_file);
-    bool result = storage_file_open(
-        flipper_file->file, filename, FSAM_READ | FSAM_WRITE, FSOM_CREATE_NEW);
+    bool result =
+        flipper_file_open(flipper_file, filename, FSAM_READ | FSAM_WRITE, FSOM_CREATE_NEW);
     return result;
 }
 
 bool flipper_file_close(FlipperFile* flipper_file) {
     furi_assert(flipper_file);
+    flipper_file_index_reset(flipper_file);
     if(storage_file_is_open(flipper_file->file)) {
         return storage_file_close(flipper_file->file);
     }
@@ -84,6 +102,7 @@ bool flipper_file_close(FlipperFile* flipper_file) {
 
 bool flipper_file_rewind(FlipperFile* flipper_file) {
     furi_assert(flipper_file);
+    flipper_file->value_pending = false;
     return storage_file_seek(flipper_file->file, 0, true);
 }
 
@@ -129,42 +148,22 @@ bool flipper_file_write_header_cstr(
 bool flipper_file_get_value_count(FlipperFile* flipper_file, const char* key, uint32_t* count) {
     furi_assert(flipper_file);
     bool result = false;
-    bool last = false;
-
-    string_t value;
-    string_init(value);
 
     uint32_t position = storage_file_tell(flipper_file->file);
-    do {
-        if(!flipper_file_seek_to_key(flipper_file->file, key)) break;
-
-        // Balance between speed and memory consumption
-        // I prefer lower speed but less memory consumption
-        *count = 0;
-
-        result = true;
-        while(true) {
-            if(!file_helper_read_value(flipper_file->file, value, &last)) {
-                result = false;
-                break;
-            }
-
-            *count = *count + 1;
-            if(last) break;
-        }
-
-    } while(true);
+    if(flipper_file_index_seek_to_key(flipper_file, key)) {
+        result = file_helper_count_values(flipper_file->file, count);
+    }
 
     if(!storage_file_seek(flipper_file->file, position, true)) {
         result = false;
     }
 
-    string_clear(value);
     return result;
 }
 
 bool flipper_file_write_comment(FlipperFile* flipper_file, string_t data) {
     furi_assert(flipper_file);
+    flipper_file_index_reset(flipper_file);
 
     bool result = false;
     do {
@@ -199,6 +198,7 @@ bool flipper_file_delete_key_and_call(
     const uint16_t cb_data_size) {
     bool result = false;
     File* scratch_file = storage_file_alloc(flipper_file->storage);
+    flipper_file_index_reset(flipper_file);
 
     do {
         // get size
@@ -322,16 +322,17 @@ bool flipper_file_write_internal(
 }
 
 bool flipper_file_read_internal(
-    File* file,
+    FlipperFile* flipper_file,
     const char* key,
     void* _data,
     const uint16_t data_size,
     FlipperFileValueType type) {
+    File* file = flipper_file->file;
     bool result = false;
     string_t value;
     string_init(value);
 
-    if(flipper_file_seek_to_key(file, key)) {
+    if(flipper_file_index_seek_to_key(flipper_file, key)) {
         result = true;
         for(uint16_t i = 0; i < data_size; i++) {
             bool last = false;
@@ -381,6 +382,8 @@ bool flipper_file_read_internal(
                 break;
             }
         }
+
+        if(result) flipper_file_index_value_read(flipper_file);
     }
 
     string_clear(value);
@@ -390,6 +393,8 @@ bool flipper_file_read_internal(
 File* flipper_file_get_file(FlipperFile* flipper_file) {
     furi_assert(flipper_file);
     furi_assert(flipper_file->file);
+    // Caller can change the file behind our back
+    flipper_file_index_reset(flipper_file);
 
     return flipper_file->file;
 }
\ No newline at end of file
@@ -27,6 +27,9 @@
  * 
  * The library is designed in such a way that comments and field values are completely ignored when searching for keys, that is, they do not consume memory.
  * 
+ * Keys are searched from the current position forward, the position is not changed if the key is not found.
+ * Key positions are remembered while searching, so the file is scanned once, and lookups after rewind are cheap.
+ * 
  * File example: 
  * 
  * ~~~~~~~~~~~~~~~~~~~~~
@@ -276,6 +279,23 @@ bool flipper_file_read_int32(
     int32_t* data,
     const uint16_t data_size);
 
+/**
+ * Read array of int32 by Key in chunks, so lines of any length (like RAW_Data) can be read with a small buffer.
+ * First call finds the key from the current position, next calls continue its line until it is over, then go to the next line with the key.
+ * @param flipper_file Pointer to a FlipperFile instance
+ * @param key Key
+ * @param data Value
+ * @param data_size Values count
+ * @param count Values read
+ * @return True on success
+ */
+bool flipper_file_read_int32_chunk(
+    FlipperFile* flipper_file,
+    const char* key,
+    int32_t* data,
+    const uint16_t data_size,
+    uint16_t* count);
+
 /**
  * Write key and array of int32 to file.
  * @param flipper_file Pointer to a FlipperFile instance
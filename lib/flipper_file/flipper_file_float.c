@@ -18,8 +18,7 @@ bool flipper_file_read_float(
     float* data,
     const uint16_t data_size) {
     furi_assert(flipper_file);
-    return flipper_file_read_internal(
-        flipper_file->file, key, data, data_size, FlipperFileValueFloat);
+    return flipper_file_read_internal(flipper_file, key, data, data_size, FlipperFileValueFloat);
 }
 
 bool flipper_file_write_float(
@@ -28,6 +27,7 @@ bool flipper_file_write_float(
     const float* data,
     const uint16_t data_size) {
     furi_assert(flipper_file);
+    flipper_file_index_reset(flipper_file);
     return flipper_file_write_float_internal(flipper_file->file, key, data, data_size);
 }
 
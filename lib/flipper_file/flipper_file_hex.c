@@ -18,6 +18,7 @@ bool flipper_file_write_hex(
     const uint8_t* data,
     const uint16_t data_size) {
     furi_assert(flipper_file);
+    flipper_file_index_reset(flipper_file);
     return flipper_file_write_hex_internal(flipper_file->file, key, data, data_size);
 }
 
@@ -27,8 +28,7 @@ bool flipper_file_read_hex(
     uint8_t* data,
     const uint16_t data_size) {
     furi_assert(flipper_file);
-    return flipper_file_read_internal(
-        flipper_file->file, key, data, data_size, FlipperFileValueHex);
+    return flipper_file_read_internal(flipper_file, key, data, data_size, FlipperFileValueHex);
 }
 
 bool flipper_file_update_hex(
@@ -1,9 +1,40 @@
 #include <stdint.h>
 #include <storage/storage.h>
 
+/** Storage buffer size, small reads and seeks inside it don't reach storage thread.
+ * Part of every FlipperFile instance */
+#define FLIPPER_FILE_BUFFER_SIZE 512
+
+/** Key index capacity, runs of the same key take one item.
+ * Items are allocated by the first seek to key, FLIPPER_FILE_INDEX_SIZE_MIN of them,
+ * and doubled when they run out: files searched by a few keys pay for a few items */
+#define FLIPPER_FILE_INDEX_SIZE_MIN 8
+#define FLIPPER_FILE_INDEX_SIZE 64
+
+/** Run of lines with the same key */
+typedef struct {
+    uint32_t key_hash;
+    uint32_t first; /**< Offset of the first line of the run */
+    uint32_t last; /**< Offset of the last line of the run */
+} FlipperFileIndexItem;
+
+/** Key index, built while searching for keys, so the file is scanned once */
+typedef struct {
+    FlipperFileIndexItem* items; /**< NULL until the first key is indexed */
+    size_t capacity;
+    size_t count;
+    uint32_t end; /**< Scanned up to this offset, it's always after a key delimiter */
+    uint32_t value; /**< Offset of the value after the last found key */
+    bool complete; /**< Whole file is indexed */
+    bool full; /**< Out of items, keys after end are searched by scanning */
+} FlipperFileIndex;
+
 struct FlipperFile {
     File* file;
     Storage* storage;
+    uint8_t buffer[FLIPPER_FILE_BUFFER_SIZE];
+    FlipperFileIndex index;
+    bool value_pending; /**< Chunked read stopped in the middle of the line */
 };
 
 /**
@@ -57,7 +88,7 @@ bool flipper_file_write_internal(
 
 /**
  * Internal read values function
- * @param file 
+ * @param flipper_file 
  * @param key 
  * @param _data 
  * @param data_size 
@@ -65,8 +96,42 @@ bool flipper_file_write_internal(
  * @return bool 
  */
 bool flipper_file_read_internal(
-    File* file,
+    FlipperFile* flipper_file,
     const char* key,
     void* _data,
     const uint16_t data_size,
-    FlipperFileValueType type);
\ No newline at end of file
+    FlipperFileValueType type);
+
+/**
+ * Init empty key index, items are not allocated yet
+ * @param flipper_file
+ */
+void flipper_file_index_init(FlipperFile* flipper_file);
+
+/**
+ * Free key index items
+ * @param flipper_file
+ */
+void flipper_file_index_free(FlipperFile* flipper_file);
+
+/**
+ * Drop key index, must be called before file content changes
+ * @param flipper_file 
+ */
+void flipper_file_index_reset(FlipperFile* flipper_file);
+
+/**
+ * Sets rw pointer to the data after the key, same as flipper_file_seek_to_key,
+ * but uses and extends key index. rw pointer is not moved if key was not found.
+ * @param flipper_file 
+ * @param key 
+ * @return true if key was found 
+ */
+bool flipper_file_index_seek_to_key(FlipperFile* flipper_file, const char* key);
+
+/**
+ * Tells index that value after the found key was read up to the rw pointer,
+ * so next search doesn't read it again. Pointer must stay on the same line.
+ * @param flipper_file 
+ */
+void flipper_file_index_value_read(FlipperFile* flipper_file);
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include <furi.h>
+
+#include "flipper_file.h"
+#include "flipper_file_i.h"
+#include "flipper_file_helper.h"
+
+static uint32_t flipper_file_index_hash(const char* key, size_t key_size) {
+    // FNV-1a
+    uint32_t hash = 2166136261UL;
+    for(size_t i = 0; i < key_size; i++) {
+        hash ^= (uint8_t)key[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+/** Allocates items on the first call, doubles them on the next ones */
+static void flipper_file_index_grow(FlipperFileIndex* index) {
+    size_t capacity = index->capacity ? index->capacity * 2 : FLIPPER_FILE_INDEX_SIZE_MIN;
+    FlipperFileIndexItem* items = furi_alloc(sizeof(FlipperFileIndexItem) * capacity);
+    if(index->count) memcpy(items, index->items, sizeof(FlipperFileIndexItem) * index->count);
+    free(index->items);
+    index->items = items;
+    index->capacity = capacity;
+}
+
+static void flipper_file_index_add(FlipperFileIndex* index, uint32_t key_hash, uint32_t offset) {
+    if(index->full) {
+        return;
+    } else if(index->count > 0 && index->items[index->count - 1].key_hash == key_hash) {
+        index->items[index->count - 1].last = offset;
+    } else if(index->count < FLIPPER_FILE_INDEX_SIZE) {
+        if(index->count == index->capacity) flipper_file_index_grow(index);
+        FlipperFileIndexItem* item = &index->items[index->count++];
+        item->key_hash = key_hash;
+        item->first = offset;
+        item->last = offset;
+    } else {
+        index->full = true;
+    }
+}
+
+/** Old way: read keys from the rw pointer until the key is found */
+static bool
+    flipper_file_index_search(FlipperFile* flipper_file, uint32_t position, const char* key) {
+    FlipperFileIndex* index = &flipper_file->index;
+    bool result = flipper_file_seek_to_key(flipper_file->file, key);
+    if(result) {
+        index->value = storage_file_tell(flipper_file->file);
+    } else {
+        storage_file_seek(flipper_file->file, position, true);
+    }
+    return result;
+}
+
+/** Checks the key in the file at the offset, rw pointer is moved to its value on success */
+static bool flipper_file_index_check(
+    FlipperFile* flipper_file,
+    uint32_t offset,
+    const char* key,
+    size_t key_size) {
+    FlipperFileIndex* index = &flipper_file->index;
+    File* file = flipper_file->file;
+    char buffer[32];
+    bool result = storage_file_seek(file, offset, true);
+
+    // Key and delimiter
+    for(size_t checked = 0; result && checked <= key_size;) {
+        size_t chunk = MIN(sizeof(buffer), key_size + 1 - checked);
+        if(storage_file_read(file, buffer, chunk) != chunk) {
+            result = false;
+        } else if(checked + chunk > key_size) {
+            result = memcmp(buffer, &key[checked], chunk - 1) == 0 &&
+                     buffer[chunk - 1] == flipper_file_delimiter;
+        } else {
+            result = memcmp(buffer, &key[checked], chunk) == 0;
+        }
+        checked += chunk;
+    }
+
+    if(result) {
+        index->value = offset + key_size + 2;
+        result = storage_file_seek(file, index->value, true);
+    }
+    return result;
+}
+
+/** Continue scanning the file from index end, adding keys to the index */
+static bool flipper_file_index_scan(
+    FlipperFile* flipper_file,
+    uint32_t position,
+    const char* key,
+    uint32_t key_hash) {
+    FlipperFileIndex* index = &flipper_file->index;
+    File* file = flipper_file->file;
+    if(index->end != position && !storage_file_seek(file, index->end, true)) return false;
+
+    const uint8_t buffer_size = 32;
+    uint8_t buffer[buffer_size];
+    string_t line_key;
+    string_init(line_key);
+
+    // Index end is either the file start, or somewhere after a key delimiter
+    bool new_line = (index->end == 0);
+    bool accumulate = new_line;
+    uint32_t offset = index->end;
+    uint32_t line_offset = offset;
+    bool found = false;
+    bool error = false;
+
+    while(!found && !error) {
+        uint16_t bytes_were_read = storage_file_read(file, buffer, buffer_size);
+        if(bytes_were_read == 0) {
+            if(!index->full) {
+                index->end = offset;
+                index->complete = true;
+            }
+            break;
+        }
+
+        for(uint16_t i = 0; i < bytes_were_read; i++, offset++) {
+            if(buffer[i] == flipper_file_eoln) {
+                string_reset(line_key);
+                accumulate = true;
+                new_line = true;
+                line_offset = offset + 1;
+            } else if(buffer[i] == flipper_file_eolr) {
+                // Ignore
+            } else if(buffer[i] == flipper_file_comment && new_line) {
+                accumulate = false;
+                new_line = false;
+            } else if(buffer[i] == flipper_file_delimiter) {
+                if(accumulate && !new_line) {
+                    uint32_t line_key_hash =
+                        flipper_file_index_hash(string_get_cstr(line_key), string_size(line_key));
+                    flipper_file_index_add(index, line_key_hash, line_offset);
+                    if(!index->full) index->end = offset + 1;
+
+                    if(line_offset >= position && line_key_hash == key_hash &&
+                       string_cmp_str(line_key, key) == 0) {
+                        index->value = offset + 2;
+                        if(!storage_file_seek(file, index->value, true)) error = true;
+                        found = true;
+                        break;
+                    }
+                }
+                // The rest of the line is value
+                accumulate = false;
+                new_line = false;
+            } else {
+                new_line = false;
+                if(accumulate) string_push_back(line_key, buffer[i]);
+            }
+        }
+    }
+
+    string_clear(line_key);
+
+    if(!found && !error) {
+        storage_file_seek(file, position, true);
+    }
+    return found && !error;
+}
+
+void flipper_file_index_init(FlipperFile* flipper_file) {
+    memset(&flipper_file->index, 0, sizeof(FlipperFileIndex));
+    flipper_file->value_pending = false;
+}
+
+void flipper_file_index_free(FlipperFile* flipper_file) {
+    free(flipper_file->index.items);
+    flipper_file_index_init(flipper_file);
+}
+
+void flipper_file_index_reset(FlipperFile* flipper_file) {
+    FlipperFileIndex* index = &flipper_file->index;
+    // Items are kept, the file is likely to be searched again
+    FlipperFileIndexItem* items = index->items;
+    size_t capacity = index->capacity;
+    memset(index, 0, sizeof(FlipperFileIndex));
+    index->items = items;
+    index->capacity = capacity;
+    flipper_file->value_pending = false;
+}
+
+bool flipper_file_index_seek_to_key(FlipperFile* flipper_file, const char* key) {
+    FlipperFileIndex* index = &flipper_file->index;
+    flipper_file->value_pending = false;
+    uint32_t position = storage_file_tell(flipper_file->file);
+    size_t key_size = strlen(key);
+    uint32_t key_hash = flipper_file_index_hash(key, key_size);
+
+    for(size_t i = 0; i < index->count; i++) {
+        const FlipperFileIndexItem* item = &index->items[i];
+        if(item->last < position || item->key_hash != key_hash) continue;
+
+        if(item->first >= position) {
+            if(flipper_file_index_check(flipper_file, item->first, key, key_size)) return true;
+            // Hash collision
+            if(!storage_file_seek(flipper_file->file, position, true)) return false;
+        }
+
+        // Position is inside of the run, next line with the key is near
+        return flipper_file_index_search(flipper_file, position, key);
+    }
+
+    if(index->complete) return false;
+    if(index->full && index->end < position) {
+        return flipper_file_index_search(flipper_file, position, key);
+    }
+    return flipper_file_index_scan(flipper_file, position, key, key_hash);
+}
+
+void flipper_file_index_value_read(FlipperFile* flipper_file) {
+    FlipperFileIndex* index = &flipper_file->index;
+    // Value right after the index end was read, nothing to index there
+    if(!index->complete && !index->full && index->value == index->end + 1) {
+        index->end = storage_file_tell(flipper_file->file);
+    }
+}
@@ -9,7 +9,19 @@ static bool flipper_file_write_int32_internal(
     const char* key,
     const void* _data,
     const uint16_t data_size) {
-    return flipper_file_write_internal(file, key, _data, data_size, FlipperFileValueInt32);
+    bool result = false;
+
+    do {
+        result = flipper_file_write_key(file, key);
+        if(!result) break;
+
+        result = file_helper_write_int32_array(file, _data, data_size);
+        if(!result) break;
+
+        result = file_helper_write_eol(file);
+    } while(false);
+
+    return result;
 };
 
 bool flipper_file_read_int32(
@@ -18,8 +30,41 @@ bool flipper_file_read_int32(
     int32_t* data,
     const uint16_t data_size) {
     furi_assert(flipper_file);
-    return flipper_file_read_internal(
-        flipper_file->file, key, data, data_size, FlipperFileValueInt32);
+    bool result = false;
+    uint16_t count = 0;
+    bool last = false;
+
+    if(flipper_file_index_seek_to_key(flipper_file, key)) {
+        result = file_helper_read_int32_array(flipper_file->file, data, data_size, &count, &last);
+        result = result && (count == data_size);
+        if(result) flipper_file_index_value_read(flipper_file);
+    }
+
+    return result;
+}
+
+bool flipper_file_read_int32_chunk(
+    FlipperFile* flipper_file,
+    const char* key,
+    int32_t* data,
+    const uint16_t data_size,
+    uint16_t* count) {
+    furi_assert(flipper_file);
+    bool result = true;
+    bool last = false;
+
+    if(!flipper_file->value_pending) {
+        result = flipper_file_index_seek_to_key(flipper_file, key);
+    }
+
+    *count = 0;
+    if(result) {
+        result = file_helper_read_int32_array(flipper_file->file, data, data_size, count, &last);
+    }
+
+    flipper_file->value_pending = result && !last;
+    if(result && last) flipper_file_index_value_read(flipper_file);
+    return result;
 }
 
 bool flipper_file_write_int32(
@@ -28,6 +73,7 @@ bool flipper_file_write_int32(
     const int32_t* data,
     const uint16_t data_size) {
     furi_assert(flipper_file);
+    flipper_file_index_reset(flipper_file);
     return flipper_file_write_int32_internal(flipper_file->file, key, data, data_size);
 }
 
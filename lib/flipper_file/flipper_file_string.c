@@ -29,8 +29,9 @@ bool flipper_file_read_string(FlipperFile* flipper_file, const char* key, string
     furi_assert(flipper_file);
 
     bool result = false;
-    if(flipper_file_seek_to_key(flipper_file->file, key)) {
+    if(flipper_file_index_seek_to_key(flipper_file, key)) {
         if(file_helper_read_line(flipper_file->file, data)) {
+            flipper_file_index_value_read(flipper_file);
             result = true;
         }
     }
@@ -39,6 +40,7 @@ bool flipper_file_read_string(FlipperFile* flipper_file, const char* key, string
 
 bool flipper_file_write_string(FlipperFile* flipper_file, const char* key, string_t data) {
     furi_assert(flipper_file);
+    flipper_file_index_reset(flipper_file);
     return flipper_file_write_string_internal(flipper_file->file, key, data, 0);
 }
 
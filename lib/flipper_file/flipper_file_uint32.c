@@ -18,8 +18,7 @@ bool flipper_file_read_uint32(
     uint32_t* data,
     const uint16_t data_size) {
     furi_assert(flipper_file);
-    return flipper_file_read_internal(
-        flipper_file->file, key, data, data_size, FlipperFileValueUint32);
+    return flipper_file_read_internal(flipper_file, key, data, data_size, FlipperFileValueUint32);
 }
 
 bool flipper_file_write_uint32(
@@ -28,6 +27,7 @@ bool flipper_file_write_uint32(
     const uint32_t* data,
     const uint16_t data_size) {
     furi_assert(flipper_file);
+    flipper_file_index_reset(flipper_file);
     return flipper_file_write_uint32_internal(flipper_file->file, key, data, data_size);
 }
 
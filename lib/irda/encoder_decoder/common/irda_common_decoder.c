@@ -9,13 +9,24 @@
 
 static void irda_common_decoder_reset_state(IrdaCommonDecoder* decoder);
 
-static inline size_t consume_samples(uint32_t* array, size_t len, size_t shift) {
-    furi_assert(len >= shift);
-    len -= shift;
-    for (int i = 0; i < len; ++i)
-        array[i] = array[i + shift];
+static IrdaTimingBand irda_timing_band_make(uint32_t value, uint32_t tolerance) {
+    IrdaTimingBand band;
+    /* value - tolerance < x < value + tolerance, x > 0 */
+    band.min = (value > tolerance) ? (value - tolerance + 1) : 1;
+    band.span = (value + tolerance > band.min) ? (value + tolerance - band.min) : 0;
+    return band;
+}
 
-    return len;
+static void irda_common_decoder_make_bands(IrdaCommonTimingBands* bands, const IrdaTimings* timings) {
+    bands->preamble_mark = irda_timing_band_make(timings->preamble_mark, timings->preamble_tolerance);
+    bands->preamble_space = irda_timing_band_make(timings->preamble_space, timings->preamble_tolerance);
+    bands->bit1_mark = irda_timing_band_make(timings->bit1_mark, timings->bit_tolerance);
+    bands->bit1_space = irda_timing_band_make(timings->bit1_space, timings->bit_tolerance);
+    bands->bit0_mark = irda_timing_band_make(timings->bit0_mark, timings->bit_tolerance);
+    bands->bit0_space = irda_timing_band_make(timings->bit0_space, timings->bit_tolerance);
+    bands->quant_single = bands->bit1_mark;
+    bands->quant_double = irda_timing_band_make(2 * timings->bit1_mark, timings->bit_tolerance);
+    bands->quant_triple = irda_timing_band_make(3 * timings->bit1_mark, timings->bit_tolerance);
 }
 
 static inline void accumulate_lsb(IrdaCommonDecoder* decoder, bool bit) {
@@ -45,7 +56,7 @@ static bool irda_check_preamble(IrdaCommonDecoder* decoder) {
 
     // align to start at Mark timing
     if (!start_level) {
-        decoder->timings_cnt = consume_samples(decoder->timings, decoder->timings_cnt, 1);
+        irda_common_decoder_consume_timings(decoder, 1);
     }
 
     if (decoder->protocol->timings.preamble_mark == 0) {
@@ -53,16 +64,15 @@ static bool irda_check_preamble(IrdaCommonDecoder* decoder) {
     }
 
     while ((!result) && (decoder->timings_cnt >= 2)) {
-        float preamble_tolerance = decoder->protocol->timings.preamble_tolerance;
-        uint16_t preamble_mark = decoder->protocol->timings.preamble_mark;
-        uint16_t preamble_space = decoder->protocol->timings.preamble_space;
+        uint32_t preamble_mark = irda_common_decoder_get_timing(decoder, 0);
+        uint32_t preamble_space = irda_common_decoder_get_timing(decoder, 1);
 
-        if ((MATCH_TIMING(decoder->timings[0], preamble_mark, preamble_tolerance))
-            && (MATCH_TIMING(decoder->timings[1], preamble_space, preamble_tolerance))) {
+        if (irda_timing_band_match(&decoder->bands.preamble_mark, preamble_mark)
+            && irda_timing_band_match(&decoder->bands.preamble_space, preamble_space)) {
             result = true;
         }
 
-        decoder->timings_cnt = consume_samples(decoder->timings, decoder->timings_cnt, 2);
+        irda_common_decoder_consume_timings(decoder, 2);
     }
 
     return result;
@@ -82,7 +92,7 @@ static IrdaStatus irda_common_decode_bits(IrdaCommonDecoder* decoder) {
 
     while (decoder->timings_cnt && (status == IrdaStatusOk)) {
         bool level = (decoder->level + decoder->timings_cnt + 1) % 2;
-        uint32_t timing = decoder->timings[0];
+        uint32_t timing = irda_common_decoder_get_timing(decoder, 0);
 
         if (timings->min_split_time && !level) {
             if (timing > timings->min_split_time) {
@@ -104,7 +114,7 @@ static IrdaStatus irda_common_decode_bits(IrdaCommonDecoder* decoder) {
         if (status == IrdaStatusError) {
             break;
         }
-        decoder->timings_cnt = consume_samples(decoder->timings, decoder->timings_cnt, 1);
+        irda_common_decoder_consume_timings(decoder, 1);
 
         /* check if largest protocol version can be decoded */
         if (level && (decoder->protocol->databit_len[0] == decoder->databit_cnt) && !timings->min_split_time) {
@@ -121,27 +131,24 @@ IrdaStatus irda_common_decode_pdwm(IrdaCommonDecoder* decoder, bool level, uint3
     furi_assert(decoder);
 
     IrdaStatus status = IrdaStatusOk;
-    uint32_t bit_tolerance = decoder->protocol->timings.bit_tolerance;
-    uint16_t bit1_mark = decoder->protocol->timings.bit1_mark;
-    uint16_t bit1_space = decoder->protocol->timings.bit1_space;
-    uint16_t bit0_mark = decoder->protocol->timings.bit0_mark;
-    uint16_t bit0_space = decoder->protocol->timings.bit0_space;
+    const IrdaCommonTimingBands* bands = &decoder->bands;
+    bool same_marks = (decoder->protocol->timings.bit1_mark == decoder->protocol->timings.bit0_mark);
 
-    bool analyze_timing = level ^ (bit1_mark == bit0_mark);
-    uint16_t bit1 = level ? bit1_mark : bit1_space;
-    uint16_t bit0 = level ? bit0_mark : bit0_space;
-    uint16_t no_info_timing = (bit1_mark == bit0_mark) ? bit1_mark : bit1_space;
+    bool analyze_timing = level ^ same_marks;
+    const IrdaTimingBand* bit1 = level ? &bands->bit1_mark : &bands->bit1_space;
+    const IrdaTimingBand* bit0 = level ? &bands->bit0_mark : &bands->bit0_space;
+    const IrdaTimingBand* no_info_timing = same_marks ? &bands->bit1_mark : &bands->bit1_space;
 
     if (analyze_timing) {
-        if (MATCH_TIMING(timing, bit1, bit_tolerance)) {
+        if (irda_timing_band_match(bit1, timing)) {
             accumulate_lsb(decoder, 1);
-        } else if (MATCH_TIMING(timing, bit0, bit_tolerance)) {
+        } else if (irda_timing_band_match(bit0, timing)) {
             accumulate_lsb(decoder, 0);
         } else {
             status = IrdaStatusError;
         }
     } else {
-        if (!MATCH_TIMING(timing, no_info_timing, bit_tolerance)) {
+        if (!irda_timing_band_match(no_info_timing, timing)) {
             status = IrdaStatusError;
         }
     }
@@ -152,14 +159,12 @@ IrdaStatus irda_common_decode_pdwm(IrdaCommonDecoder* decoder, bool level, uint3
 /* level switch detection goes in middle of time-quant */
 IrdaStatus irda_common_decode_manchester(IrdaCommonDecoder* decoder, bool level, uint32_t timing) {
     furi_assert(decoder);
-    uint16_t bit = decoder->protocol->timings.bit1_mark;
-    uint16_t tolerance = decoder->protocol->timings.bit_tolerance;
 
     bool* switch_detect = &decoder->switch_detect;
     furi_assert((*switch_detect == true) || (*switch_detect == false));
 
-    bool single_timing = MATCH_TIMING(timing, bit, tolerance);
-    bool double_timing = MATCH_TIMING(timing, 2*bit, tolerance);
+    bool single_timing = irda_timing_band_match(&decoder->bands.quant_single, timing);
+    bool double_timing = irda_timing_band_match(&decoder->bands.quant_double, timing);
 
     if(!single_timing && !double_timing) {
         return IrdaStatusError;
@@ -227,9 +232,10 @@ IrdaMessage* irda_common_decode(IrdaCommonDecoder* decoder, bool level, uint32_t
     }
     decoder->level = level;   // start with low level (Space timing)
 
-    decoder->timings[decoder->timings_cnt] = duration;
+    furi_check(decoder->timings_cnt < IRDA_COMMON_DECODER_TIMINGS_SIZE);
+    uint8_t index = (decoder->timings_start + decoder->timings_cnt) & IRDA_COMMON_DECODER_TIMINGS_MASK;
+    decoder->timings[index] = duration;
     decoder->timings_cnt++;
-    furi_check(decoder->timings_cnt <= sizeof(decoder->timings));
 
     while(1) {
         switch (decoder->state) {
@@ -286,6 +292,7 @@ void* irda_common_decoder_alloc(const IrdaCommonProtocolSpec* protocol) {
                           + !!(protocol->databit_len[0] % 8);
     IrdaCommonDecoder* decoder = furi_alloc(alloc_size);
     decoder->protocol = protocol;
+    irda_common_decoder_make_bands(&decoder->bands, &protocol->timings);
     decoder->level = true;
     return decoder;
 }
@@ -302,7 +309,7 @@ void irda_common_decoder_reset_state(IrdaCommonDecoder* decoder) {
     decoder->message.protocol = IrdaProtocolUnknown;
     if (decoder->protocol->timings.preamble_mark == 0) {
         if (decoder->timings_cnt > 0) {
-            decoder->timings_cnt = consume_samples(decoder->timings, decoder->timings_cnt, 1);
+            irda_common_decoder_consume_timings(decoder, 1);
         }
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <furi/check.h>
 #include "irda.h"
 #include "irda_i.h"
 
@@ -8,6 +9,30 @@
 #define MATCH_TIMING(x, v, delta)       (  ((x) < (v + delta)) \
                                         && ((x) > (v - delta)))
 
+/* Ring of timings waiting to be decoded, size has to be power of 2 */
+#define IRDA_COMMON_DECODER_TIMINGS_SIZE    8
+#define IRDA_COMMON_DECODER_TIMINGS_MASK    (IRDA_COMMON_DECODER_TIMINGS_SIZE - 1)
+
+/* Same as MATCH_TIMING(x, v, delta): x matches if (x - min) < span */
+typedef struct {
+    uint32_t min;
+    uint32_t span;
+} IrdaTimingBand;
+
+/* Protocol timings with tolerances applied, precompiled on decoder alloc */
+typedef struct {
+    IrdaTimingBand preamble_mark;
+    IrdaTimingBand preamble_space;
+    IrdaTimingBand bit1_mark;
+    IrdaTimingBand bit1_space;
+    IrdaTimingBand bit0_mark;
+    IrdaTimingBand bit0_space;
+    /* Manchester: 1, 2 and 3 time-quants (bit1_mark) */
+    IrdaTimingBand quant_single;
+    IrdaTimingBand quant_double;
+    IrdaTimingBand quant_triple;
+} IrdaCommonTimingBands;
+
 typedef struct IrdaCommonDecoder IrdaCommonDecoder;
 typedef struct IrdaCommonEncoder IrdaCommonEncoder;
 
@@ -44,9 +69,11 @@ typedef enum {
 struct IrdaCommonDecoder {
     const IrdaCommonProtocolSpec* protocol;
     void* context;
-    uint32_t timings[6];
+    IrdaCommonTimingBands bands;
+    uint32_t timings[IRDA_COMMON_DECODER_TIMINGS_SIZE];
     IrdaMessage message;
     IrdaCommonStateDecoder state;
+    uint8_t timings_start;
     uint8_t timings_cnt;
     bool switch_detect;
     bool level;
@@ -66,6 +93,21 @@ struct IrdaCommonEncoder {
     uint8_t data[];
 };
 
+static inline bool irda_timing_band_match(const IrdaTimingBand* band, uint32_t timing) {
+    return (timing - band->min) < band->span;
+}
+
+/* index 0 is the oldest timing not consumed yet */
+static inline uint32_t irda_common_decoder_get_timing(const IrdaCommonDecoder* decoder, size_t index) {
+    return decoder->timings[(decoder->timings_start + index) & IRDA_COMMON_DECODER_TIMINGS_MASK];
+}
+
+static inline void irda_common_decoder_consume_timings(IrdaCommonDecoder* decoder, size_t count) {
+    furi_assert(decoder->timings_cnt >= count);
+    decoder->timings_start = (decoder->timings_start + count) & IRDA_COMMON_DECODER_TIMINGS_MASK;
+    decoder->timings_cnt -= count;
+}
+
 IrdaMessage* irda_common_decode(IrdaCommonDecoder *decoder, bool level, uint32_t duration);
 IrdaStatus irda_common_decode_pdwm(IrdaCommonDecoder* decoder, bool level, uint32_t timing);
 IrdaStatus irda_common_decode_manchester(IrdaCommonDecoder* decoder, bool level, uint32_t timing);
@@ -5,16 +5,22 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <furi.h>
 #include "irda_i.h"
 #include <furi-hal-irda.h>
 
+/* irda_decode_buffer() feeds timings to decoders by blocks of this size */
+#define IRDA_DECODE_BUFFER_BLOCK_SIZE   16
+
 typedef struct {
     IrdaAlloc alloc;
     IrdaDecode decode;
     IrdaDecoderReset reset;
     IrdaFree free;
     IrdaDecoderCheckReady check_ready;
+    /* used to filter out frames which don't start with protocol's preamble */
+    const IrdaTimings* timings;
 } IrdaDecoders;
 
 typedef struct {
@@ -24,8 +30,23 @@ typedef struct {
     IrdaFree free;
 } IrdaEncoders;
 
+/* Decoder is kept in dispatch only while frame starts from its preamble mark.
+ * Frame is a sequence of timings separated by a space longer than frame_gap.
+ * Skipped decoder comes back on a preamble mark or on a space longer than
+ * preamble space, so glitch in front of preamble doesn't cost whole frame. */
+typedef struct {
+    uint32_t preamble_mark_min;
+    uint32_t preamble_mark_max;
+    uint32_t preamble_space_max;
+    uint32_t frame_gap;
+    bool frame_start;
+    bool skip;
+} IrdaDecoderDispatch;
+
 struct IrdaDecoderHandler {
     void** ctx;
+    IrdaDecoderDispatch* dispatch;
+    uint32_t skipped_cnt;
 };
 
 struct IrdaEncoderHandler {
@@ -46,7 +67,8 @@ static const IrdaEncoderDecoder irda_encoder_decoder[] = {
           .decode = irda_decoder_nec_decode,
           .reset = irda_decoder_nec_reset,
           .check_ready = irda_decoder_nec_check_ready,
-          .free = irda_decoder_nec_free},
+          .free = irda_decoder_nec_free,
+          .timings = &protocol_nec.timings},
       .encoder = {
           .alloc = irda_encoder_nec_alloc,
           .encode = irda_encoder_nec_encode,
@@ -60,7 +82,8 @@ static const IrdaEncoderDecoder irda_encoder_decoder[] = {
           .decode = irda_decoder_samsung32_decode,
           .reset = irda_decoder_samsung32_reset,
           .check_ready = irda_decoder_samsung32_check_ready,
-          .free = irda_decoder_samsung32_free},
+          .free = irda_decoder_samsung32_free,
+          .timings = &protocol_samsung32.timings},
       .encoder = {
           .alloc = irda_encoder_samsung32_alloc,
           .encode = irda_encoder_samsung32_encode,
@@ -74,7 +97,8 @@ static const IrdaEncoderDecoder irda_encoder_decoder[] = {
           .decode = irda_decoder_rc5_decode,
           .reset = irda_decoder_rc5_reset,
           .check_ready = irda_decoder_rc5_check_ready,
-          .free = irda_decoder_rc5_free},
+          .free = irda_decoder_rc5_free,
+          .timings = &protocol_rc5.timings},
       .encoder = {
           .alloc = irda_encoder_rc5_alloc,
           .encode = irda_encoder_rc5_encode,
@@ -88,7 +112,8 @@ static const IrdaEncoderDecoder irda_encoder_decoder[] = {
           .decode = irda_decoder_rc6_decode,
           .reset = irda_decoder_rc6_reset,
           .check_ready = irda_decoder_rc6_check_ready,
-          .free = irda_decoder_rc6_free},
+          .free = irda_decoder_rc6_free,
+          .timings = &protocol_rc6.timings},
       .encoder = {
           .alloc = irda_encoder_rc6_alloc,
           .encode = irda_encoder_rc6_encode,
@@ -102,7 +127,8 @@ static const IrdaEncoderDecoder irda_encoder_decoder[] = {
           .decode = irda_decoder_sirc_decode,
           .reset = irda_decoder_sirc_reset,
           .check_ready = irda_decoder_sirc_check_ready,
-          .free = irda_decoder_sirc_free},
+          .free = irda_decoder_sirc_free,
+          .timings = &protocol_sirc.timings},
       .encoder = {
           .alloc = irda_encoder_sirc_alloc,
           .encode = irda_encoder_sirc_encode,
@@ -116,6 +142,58 @@ static const IrdaEncoderDecoder irda_encoder_decoder[] = {
 static int irda_find_index_by_protocol(IrdaProtocol protocol);
 static const IrdaProtocolSpecification* irda_get_spec_by_protocol(IrdaProtocol protocol);
 
+static void irda_decoder_dispatch_init(IrdaDecoderDispatch* dispatch, const IrdaTimings* timings) {
+    dispatch->frame_start = true;
+    dispatch->skip = false;
+
+    if (!timings || !timings->preamble_mark) {
+        /* no preamble - can't tell whether frame belongs to protocol */
+        dispatch->preamble_mark_min = 0;
+        dispatch->preamble_mark_max = UINT32_MAX;
+        dispatch->preamble_space_max = UINT32_MAX;
+        dispatch->frame_gap = UINT32_MAX;
+    } else {
+        dispatch->preamble_mark_min = timings->preamble_mark - timings->preamble_tolerance;
+        dispatch->preamble_mark_max = timings->preamble_mark + timings->preamble_tolerance;
+        dispatch->preamble_space_max = timings->preamble_space + timings->preamble_tolerance;
+        /* longest space inside of protocol's frame is either preamble space or split time */
+        dispatch->frame_gap = MAX(timings->min_split_time,
+                                  timings->preamble_space + timings->preamble_tolerance);
+    }
+}
+
+static inline IrdaMessage* irda_decode_dispatch(IrdaDecoderHandler* handler, int index, bool level, uint32_t duration) {
+    IrdaDecoderDispatch* dispatch = &handler->dispatch[index];
+    bool frame_end = !level && (duration > dispatch->frame_gap);
+    bool preamble_mark = level
+        && (duration > dispatch->preamble_mark_min)
+        && (duration < dispatch->preamble_mark_max);
+
+    if (dispatch->skip) {
+        if (level ? !preamble_mark : (duration <= dispatch->preamble_space_max)) {
+            ++handler->skipped_cnt;
+            return NULL;
+        }
+        /* decoder missed start of frame, start it from scratch */
+        dispatch->skip = false;
+        dispatch->frame_start = !level;
+        irda_encoder_decoder[index].decoder.reset(handler->ctx[index]);
+    } else if (level && dispatch->frame_start) {
+        dispatch->frame_start = false;
+        if (!preamble_mark) {
+            dispatch->skip = true;
+            ++handler->skipped_cnt;
+            return NULL;
+        }
+    }
+
+    if (frame_end) {
+        dispatch->frame_start = true;
+    }
+
+    return irda_encoder_decoder[index].decoder.decode(handler->ctx[index], level, duration);
+}
+
 const IrdaMessage* irda_decode(IrdaDecoderHandler* handler, bool level, uint32_t duration) {
     furi_assert(handler);
 
@@ -124,7 +202,7 @@ const IrdaMessage* irda_decode(IrdaDecoderHandler* handler, bool level, uint32_t
 
     for (int i = 0; i < COUNT_OF(irda_encoder_decoder); ++i) {
         if (irda_encoder_decoder[i].decoder.decode) {
-            message = irda_encoder_decoder[i].decoder.decode(handler->ctx[i], level, duration);
+            message = irda_decode_dispatch(handler, i, level, duration);
             if (!result && message) {
                 result = message;
             }
@@ -134,9 +212,82 @@ const IrdaMessage* irda_decode(IrdaDecoderHandler* handler, bool level, uint32_t
     return result;
 }
 
+size_t irda_decode_buffer(
+    IrdaDecoderHandler* handler,
+    const uint32_t* timings,
+    size_t timings_cnt,
+    IrdaMessage* messages,
+    size_t messages_max,
+    size_t* decoded_end) {
+    furi_assert(handler);
+    furi_assert(timings || !timings_cnt);
+    furi_assert(messages);
+    furi_assert(messages_max);
+
+    IrdaMessage block_messages[IRDA_DECODE_BUFFER_BLOCK_SIZE];
+    bool block_decoded[IRDA_DECODE_BUFFER_BLOCK_SIZE];
+    size_t messages_cnt = 0;
+    size_t last_end = 0;
+
+    for (size_t block_start = 0; block_start < timings_cnt; block_start += IRDA_DECODE_BUFFER_BLOCK_SIZE) {
+        const uint32_t* block = &timings[block_start];
+        size_t block_size = MIN(timings_cnt - block_start, (size_t) IRDA_DECODE_BUFFER_BLOCK_SIZE);
+
+        /* Block may fill messages up: it goes timing by timing then, so decoders
+         * don't consume timings after the message that fills it */
+        if (messages_max - messages_cnt < block_size) {
+            for (size_t j = 0; j < block_size; ++j) {
+                const IrdaMessage* message = irda_decode(handler, !(j % 2), block[j]);
+                if (message) {
+                    messages[messages_cnt++] = *message;
+                    last_end = block_start + j + 1;
+                    if (messages_cnt == messages_max)
+                        break;
+                }
+            }
+            if (messages_cnt == messages_max)
+                break;
+            continue;
+        }
+
+        memset(block_decoded, 0, sizeof(block_decoded));
+
+        /* Decoders are independent, so each one runs through the whole block
+         * while its state is hot, instead of switching decoders on every timing */
+        for (int i = 0; i < COUNT_OF(irda_encoder_decoder); ++i) {
+            if (!irda_encoder_decoder[i].decoder.decode)
+                continue;
+
+            for (size_t j = 0; j < block_size; ++j) {
+                /* block size is even, so block starts from Mark too */
+                bool level = !(j % 2);
+                IrdaMessage* message = irda_decode_dispatch(handler, i, level, block[j]);
+                /* same as irda_decode(): first decoder in table wins */
+                if (message && !block_decoded[j]) {
+                    block_messages[j] = *message;
+                    block_decoded[j] = true;
+                }
+            }
+        }
+
+        for (size_t j = 0; j < block_size; ++j) {
+            if (block_decoded[j]) {
+                messages[messages_cnt++] = block_messages[j];
+                last_end = block_start + j + 1;
+            }
+        }
+    }
+
+    if (decoded_end) {
+        *decoded_end = last_end;
+    }
+    return messages_cnt;
+}
+
 IrdaDecoderHandler* irda_alloc_decoder(void) {
     IrdaDecoderHandler* handler = furi_alloc(sizeof(IrdaDecoderHandler));
     handler->ctx = furi_alloc(sizeof(void*) * COUNT_OF(irda_encoder_decoder));
+    handler->dispatch = furi_alloc(sizeof(IrdaDecoderDispatch) * COUNT_OF(irda_encoder_decoder));
 
     for (int i = 0; i < COUNT_OF(irda_encoder_decoder); ++i) {
         handler->ctx[i] = 0;
@@ -157,6 +308,7 @@ void irda_free_decoder(IrdaDecoderHandler* handler) {
             irda_encoder_decoder[i].decoder.free(handler->ctx[i]);
     }
 
+    free(handler->dispatch);
     free(handler->ctx);
     free(handler);
 }
@@ -165,9 +317,15 @@ void irda_reset_decoder(IrdaDecoderHandler* handler) {
     for (int i = 0; i < COUNT_OF(irda_encoder_decoder); ++i) {
         if (irda_encoder_decoder[i].decoder.reset)
             irda_encoder_decoder[i].decoder.reset(handler->ctx[i]);
+        irda_decoder_dispatch_init(&handler->dispatch[i], irda_encoder_decoder[i].decoder.timings);
     }
 }
 
+uint32_t irda_get_decoder_skipped_count(const IrdaDecoderHandler* handler) {
+    furi_assert(handler);
+    return handler->skipped_cnt;
+}
+
 const IrdaMessage* irda_check_decoder_ready(IrdaDecoderHandler* handler) {
     furi_assert(handler);
 
@@ -175,7 +333,8 @@ const IrdaMessage* irda_check_decoder_ready(IrdaDecoderHandler* handler) {
     IrdaMessage* result = NULL;
 
     for (int i = 0; i < COUNT_OF(irda_encoder_decoder); ++i) {
-        if (irda_encoder_decoder[i].decoder.check_ready) {
+        /* skipped decoder holds state from before current frame */
+        if (irda_encoder_decoder[i].decoder.check_ready && !handler->dispatch[i].skip) {
             message = irda_encoder_decoder[i].decoder.check_ready(handler->ctx[i]);
             if (!result && message) {
                 result = message;
@@ -297,3 +456,95 @@ float irda_get_protocol_duty_cycle(IrdaProtocol protocol) {
     return irda_get_spec_by_protocol(protocol)->duty_cycle;
 }
 
+
+/* Longest frame among supported protocols is well below this */
+#define IRDA_WAVEFORM_FRAME_TIMINGS_MAX     256
+
+static bool irda_waveform_frames_equal(const uint32_t* timings,
+                                       const size_t* frame_end,
+                                       size_t frame) {
+    size_t start = frame ? frame_end[frame - 1] : 0;
+    size_t size = frame_end[frame] - start;
+    return ((frame_end[frame + 1] - frame_end[frame]) == size)
+        && !memcmp(&timings[start], &timings[frame_end[frame]], size * sizeof(uint32_t));
+}
+
+/* Runs fresh encoder for frames_max frames, stores end of each frame and, if
+ * timings is not NULL, the timings themselves. Encoder is not reused, as reset
+ * flips toggle bit of RC5/RC6, so both passes render the same frames. */
+static bool irda_waveform_render(const IrdaMessage* message,
+                                 uint32_t* timings,
+                                 size_t* frame_end,
+                                 size_t frames_max) {
+    size_t timings_cnt = 0;
+    IrdaStatus status = IrdaStatusOk;
+    IrdaEncoderHandler* handler = irda_alloc_encoder();
+    irda_reset_encoder(handler, message);
+
+    for (size_t frame = 0; (frame < frames_max) && (status != IrdaStatusError); ++frame) {
+        size_t frame_timings = 0;
+        do {
+            uint32_t duration;
+            bool level;
+            status = irda_encode(handler, &duration, &level);
+            if ((status == IrdaStatusError) || (frame_timings == IRDA_WAVEFORM_FRAME_TIMINGS_MAX)) {
+                status = IrdaStatusError;
+                break;
+            }
+            if (timings) {
+                timings[timings_cnt] = duration | (level ? IRDA_WAVEFORM_LEVEL : 0);
+            }
+            ++timings_cnt;
+            ++frame_timings;
+        } while (status != IrdaStatusDone);
+
+        frame_end[frame] = timings_cnt;
+    }
+
+    irda_free_encoder(handler);
+    return (status != IrdaStatusError);
+}
+
+IrdaWaveform* irda_waveform_alloc(const IrdaMessage* message) {
+    furi_assert(message);
+    furi_assert(irda_is_protocol_valid(message->protocol));
+
+    /* one extra frame to see the last one repeats */
+    const size_t frames_max = IRDA_WAVEFORM_FRAMES_MAX + 1;
+    size_t frame_end[IRDA_WAVEFORM_FRAMES_MAX + 1];
+    size_t frames_cnt = 0;
+    uint32_t* timings = NULL;
+
+    /* First pass only counts timings, so table is allocated at its exact size
+     * and is handed to waveform without copying */
+    if (irda_waveform_render(message, NULL, frame_end, frames_max)) {
+        timings = furi_alloc(frame_end[frames_max - 1] * sizeof(uint32_t));
+        if (irda_waveform_render(message, timings, frame_end, frames_max)) {
+            for (size_t frame = 1; (frame < frames_max) && !frames_cnt; ++frame) {
+                if (irda_waveform_frames_equal(timings, frame_end, frame - 1)) {
+                    frames_cnt = frame;
+                }
+            }
+        }
+    }
+
+    IrdaWaveform* waveform = NULL;
+    if (frames_cnt) {
+        waveform = furi_alloc(sizeof(IrdaWaveform));
+        waveform->timings = timings;
+        memcpy(waveform->frame_end, frame_end, frames_cnt * sizeof(size_t));
+        waveform->frames_cnt = frames_cnt;
+        waveform->frequency = irda_get_protocol_frequency(message->protocol);
+        waveform->duty_cycle = irda_get_protocol_duty_cycle(message->protocol);
+    } else {
+        free(timings);
+    }
+
+    return waveform;
+}
+
+void irda_waveform_free(IrdaWaveform* waveform) {
+    furi_assert(waveform);
+    free(waveform->timings);
+    free(waveform);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -41,6 +42,19 @@ typedef struct {
     bool repeat;
 } IrdaMessage;
 
+/* Mark bit of IrdaWaveform timing, the rest is duration in us */
+#define IRDA_WAVEFORM_LEVEL                (1UL << 31)
+/* Waveform keeps frames till they start to repeat, at most this number */
+#define IRDA_WAVEFORM_FRAMES_MAX           4
+
+typedef struct {
+    uint32_t* timings;          /* duration in us, IRDA_WAVEFORM_LEVEL set for mark */
+    size_t frames_cnt;          /* last frame is repeated after the others */
+    size_t frame_end[IRDA_WAVEFORM_FRAMES_MAX]; /* index of timing after each frame */
+    uint32_t frequency;
+    float duty_cycle;
+} IrdaWaveform;
+
 typedef enum {
     IrdaStatusError,
     IrdaStatusOk,
@@ -70,6 +84,31 @@ IrdaDecoderHandler* irda_alloc_decoder(void);
  */
 const IrdaMessage* irda_decode(IrdaDecoderHandler* handler, bool level, uint32_t duration);
 
+/**
+ * Provide to decoder array of timings.
+ * Gives the same messages as calling \c irda_decode() for every timing, but
+ * runs each protocol decoder through a block of timings at once.
+ *
+ * \param[in]   handler     - handler to IRDA decoders. Should be acquired with \c irda_alloc_decoder().
+ * \param[in]   timings     - durations of steady input signal. First timing is Mark (high level),
+ *                          then levels alternate, as in raw signals.
+ * \param[in]   timings_cnt - amount of timings.
+ * \param[out]  messages    - array to store decoded messages to, in order of decoding.
+ * \param[in]   messages_max - size of \c messages array, not 0.
+ * \param[out]  decoded_end - index of first timing after last decoded message, 0 if
+ *                          nothing was decoded. Can be NULL.
+ * \return      amount of decoded messages. When it reaches \c messages_max, decoding
+ *              stops right after the last stored message: timings from \c decoded_end
+ *              on are not fed to decoders and should be passed again.
+ */
+size_t irda_decode_buffer(
+    IrdaDecoderHandler* handler,
+    const uint32_t* timings,
+    size_t timings_cnt,
+    IrdaMessage* messages,
+    size_t messages_max,
+    size_t* decoded_end);
+
 /**
  * Check whether decoder is ready.
  * Functionality is quite similar to irda_decode(), but with no timing providing.
@@ -100,6 +139,16 @@ void irda_free_decoder(IrdaDecoderHandler* handler);
  */
 void irda_reset_decoder(IrdaDecoderHandler* handler);
 
+/**
+ * Get amount of decoder invocations avoided by preamble filter.
+ * Frame (timings between long silences) which doesn't start from protocol's
+ * preamble mark isn't passed to this protocol's decoder.
+ *
+ * \param[in]   handler     - handler to IRDA decoders. Should be acquired with \c irda_alloc_decoder().
+ * \return      amount of timings not passed to decoders since \c irda_alloc_decoder().
+ */
+uint32_t irda_get_decoder_skipped_count(const IrdaDecoderHandler* handler);
+
 /**
  * Get protocol name by protocol enum.
  *
@@ -199,6 +248,25 @@ uint32_t irda_get_protocol_frequency(IrdaProtocol protocol);
  */
 float irda_get_protocol_duty_cycle(IrdaProtocol protocol);
 
+/**
+ * Render message with all its repeats into table of timings.
+ * Encoder is run till its frames start to repeat, so transmitter only walks
+ * the table: frames go one by one, last one is sent over and over again.
+ *
+ * \param[in]   message     - message to render.
+ *
+ * \return      waveform, or NULL if message can't be encoded or its repeat frames
+ *              don't settle within IRDA_WAVEFORM_FRAMES_MAX.
+ */
+IrdaWaveform* irda_waveform_alloc(const IrdaMessage* message);
+
+/**
+ * Free waveform previously allocated with \c irda_waveform_alloc().
+ *
+ * \param[in]   waveform    - waveform to free.
+ */
+void irda_waveform_free(IrdaWaveform* waveform);
+
 #ifdef __cplusplus
 }
 #endif
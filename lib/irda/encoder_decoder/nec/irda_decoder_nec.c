@@ -65,17 +65,22 @@ bool irda_decoder_nec_interpret(IrdaCommonDecoder* decoder) {
 IrdaStatus irda_decoder_nec_decode_repeat(IrdaCommonDecoder* decoder) {
     furi_assert(decoder);
 
-    float preamble_tolerance = decoder->protocol->timings.preamble_tolerance;
-    uint32_t bit_tolerance = decoder->protocol->timings.bit_tolerance;
     IrdaStatus status = IrdaStatusError;
 
     if(decoder->timings_cnt < 4) return IrdaStatusOk;
 
-    if((decoder->timings[0] > IRDA_NEC_REPEAT_PAUSE_MIN) &&
-       (decoder->timings[0] < IRDA_NEC_REPEAT_PAUSE_MAX) &&
-       MATCH_TIMING(decoder->timings[1], IRDA_NEC_REPEAT_MARK, preamble_tolerance) &&
-       MATCH_TIMING(decoder->timings[2], IRDA_NEC_REPEAT_SPACE, preamble_tolerance) &&
-       MATCH_TIMING(decoder->timings[3], decoder->protocol->timings.bit1_mark, bit_tolerance)) {
+    uint32_t pause = irda_common_decoder_get_timing(decoder, 0);
+    if((pause > IRDA_NEC_REPEAT_PAUSE_MIN) && (pause < IRDA_NEC_REPEAT_PAUSE_MAX) &&
+       MATCH_TIMING(
+           irda_common_decoder_get_timing(decoder, 1),
+           IRDA_NEC_REPEAT_MARK,
+           IRDA_NEC_PREAMBLE_TOLERANCE) &&
+       MATCH_TIMING(
+           irda_common_decoder_get_timing(decoder, 2),
+           IRDA_NEC_REPEAT_SPACE,
+           IRDA_NEC_PREAMBLE_TOLERANCE) &&
+       irda_timing_band_match(
+           &decoder->bands.bit1_mark, irda_common_decoder_get_timing(decoder, 3))) {
         status = IrdaStatusReady;
         decoder->timings_cnt = 0;
     } else {
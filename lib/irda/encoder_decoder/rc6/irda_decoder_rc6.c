@@ -59,11 +59,10 @@ IrdaStatus irda_decoder_rc6_decode_manchester(IrdaCommonDecoder* decoder, bool l
     // 4th bit lasts 2x times more
     IrdaStatus status = IrdaStatusError;
     uint16_t bit = decoder->protocol->timings.bit1_mark;
-    uint16_t tolerance = decoder->protocol->timings.bit_tolerance;
 
-    bool single_timing = MATCH_TIMING(timing, bit, tolerance);
-    bool double_timing = MATCH_TIMING(timing, 2*bit, tolerance);
-    bool triple_timing = MATCH_TIMING(timing, 3*bit, tolerance);
+    bool single_timing = irda_timing_band_match(&decoder->bands.quant_single, timing);
+    bool double_timing = irda_timing_band_match(&decoder->bands.quant_double, timing);
+    bool triple_timing = irda_timing_band_match(&decoder->bands.quant_triple, timing);
 
     if (decoder->databit_cnt == 4) {
         furi_assert(decoder->switch_detect == true);
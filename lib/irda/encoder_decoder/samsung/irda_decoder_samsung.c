@@ -34,20 +34,22 @@ bool irda_decoder_samsung32_interpret(IrdaCommonDecoder* decoder) {
 IrdaStatus irda_decoder_samsung32_decode_repeat(IrdaCommonDecoder* decoder) {
     furi_assert(decoder);
 
-    float preamble_tolerance = decoder->protocol->timings.preamble_tolerance;
-    uint32_t bit_tolerance = decoder->protocol->timings.bit_tolerance;
+    const IrdaCommonTimingBands* bands = &decoder->bands;
     IrdaStatus status = IrdaStatusError;
 
     if (decoder->timings_cnt < 6)
         return IrdaStatusOk;
 
-    if ((decoder->timings[0] > IRDA_SAMSUNG_REPEAT_PAUSE_MIN)
-        && (decoder->timings[0] < IRDA_SAMSUNG_REPEAT_PAUSE_MAX)
-        && MATCH_TIMING(decoder->timings[1], IRDA_SAMSUNG_REPEAT_MARK, preamble_tolerance)
-        && MATCH_TIMING(decoder->timings[2], IRDA_SAMSUNG_REPEAT_SPACE, preamble_tolerance)
-        && MATCH_TIMING(decoder->timings[3], decoder->protocol->timings.bit1_mark, bit_tolerance)
-        && MATCH_TIMING(decoder->timings[4], decoder->protocol->timings.bit1_space, bit_tolerance)
-        && MATCH_TIMING(decoder->timings[5], decoder->protocol->timings.bit1_mark, bit_tolerance)
+    uint32_t pause = irda_common_decoder_get_timing(decoder, 0);
+    uint32_t repeat_mark = irda_common_decoder_get_timing(decoder, 1);
+    uint32_t repeat_space = irda_common_decoder_get_timing(decoder, 2);
+    if ((pause > IRDA_SAMSUNG_REPEAT_PAUSE_MIN)
+        && (pause < IRDA_SAMSUNG_REPEAT_PAUSE_MAX)
+        && MATCH_TIMING(repeat_mark, IRDA_SAMSUNG_REPEAT_MARK, IRDA_SAMSUNG_PREAMBLE_TOLERANCE)
+        && MATCH_TIMING(repeat_space, IRDA_SAMSUNG_REPEAT_SPACE, IRDA_SAMSUNG_PREAMBLE_TOLERANCE)
+        && irda_timing_band_match(&bands->bit1_mark, irda_common_decoder_get_timing(decoder, 3))
+        && irda_timing_band_match(&bands->bit1_space, irda_common_decoder_get_timing(decoder, 4))
+        && irda_timing_band_match(&bands->bit1_mark, irda_common_decoder_get_timing(decoder, 5))
         ) {
         status = IrdaStatusReady;
         decoder->timings_cnt = 0;
@@ -11,6 +11,8 @@ static uint32_t irda_tx_raw_timings_index = 0;
 static uint32_t irda_tx_raw_timings_number = 0;
 static uint32_t irda_tx_raw_start_from_mark = 0;
 static bool irda_tx_raw_add_silence = false;
+static uint32_t irda_tx_waveform_index = 0;
+static uint32_t irda_tx_waveform_frame = 0;
 
 FuriHalIrdaTxGetDataState irda_get_raw_data_callback (void* context, uint32_t* duration, bool* level) {
     furi_assert(duration);
@@ -81,11 +83,59 @@ FuriHalIrdaTxGetDataState irda_get_data_callback (void* context, uint32_t* durat
     return state;
 }
 
+FuriHalIrdaTxGetDataState irda_get_waveform_data_callback (void* context, uint32_t* duration, bool* level) {
+    FuriHalIrdaTxGetDataState state = FuriHalIrdaTxGetDataStateOk;
+    const IrdaWaveform* waveform = context;
+
+    uint32_t timing = waveform->timings[irda_tx_waveform_index++];
+    *level = !!(timing & IRDA_WAVEFORM_LEVEL);
+    *duration = timing & ~IRDA_WAVEFORM_LEVEL;
+
+    if (irda_tx_waveform_index == waveform->frame_end[irda_tx_waveform_frame]) {
+        state = FuriHalIrdaTxGetDataStateDone;
+        if (--irda_tx_number_of_transmissions == 0) {
+            state = FuriHalIrdaTxGetDataStateLastDone;
+        } else if (irda_tx_waveform_frame + 1 < waveform->frames_cnt) {
+            ++irda_tx_waveform_frame;
+        } else if (irda_tx_waveform_frame > 0) {
+            /* rewind to the start of the repeat frame */
+            irda_tx_waveform_index = waveform->frame_end[irda_tx_waveform_frame - 1];
+        } else {
+            irda_tx_waveform_index = 0;
+        }
+    }
+
+    return state;
+}
+
+void irda_send_waveform(const IrdaWaveform* waveform, int times) {
+    furi_assert(waveform);
+    furi_assert(times);
+
+    irda_tx_number_of_transmissions = times;
+    irda_tx_waveform_index = 0;
+    irda_tx_waveform_frame = 0;
+
+    furi_hal_irda_async_tx_set_data_isr_callback(irda_get_waveform_data_callback, (void*) waveform);
+    furi_hal_irda_async_tx_start(waveform->frequency, waveform->duty_cycle);
+    furi_hal_irda_async_tx_wait_termination();
+
+    furi_assert(!furi_hal_irda_is_busy());
+}
+
 void irda_send(const IrdaMessage* message, int times) {
     furi_assert(message);
     furi_assert(times);
     furi_assert(irda_is_protocol_valid(message->protocol));
 
+    /* Encode in thread context, ISR only walks the table */
+    IrdaWaveform* waveform = irda_waveform_alloc(message);
+    if (waveform) {
+        irda_send_waveform(waveform, times);
+        irda_waveform_free(waveform);
+        return;
+    }
+
     IrdaEncoderHandler* handler = irda_alloc_encoder();
     irda_reset_encoder(handler, message);
     irda_tx_number_of_transmissions = times;
@@ -101,4 +151,3 @@ void irda_send(const IrdaMessage* message, int times) {
 
     furi_assert(!furi_hal_irda_is_busy());
 }
-
@@ -14,6 +14,15 @@ extern "C" {
  */
 void irda_send(const IrdaMessage* message, int times);
 
+/**
+ * Send frames of message rendered with \c irda_waveform_alloc().
+ * Render once and send it many times, e.g. while button is held.
+ *
+ * \param[in]   waveform    - rendered message.
+ * \param[in]   times       - number of frames to send.
+ */
+void irda_send_waveform(const IrdaWaveform* waveform, int times);
+
 /**
  * Send raw data through infrared port.
  *
@@ -12,6 +12,10 @@
 #include <stream_buffer.h>
 
 #define IRDA_WORKER_RX_TIMEOUT              IRDA_RAW_RX_TIMING_DELAY_US
+/* Should be even: batch starts from Mark */
+#define IRDA_WORKER_RX_BATCH_SIZE           32
+/* Every timing of batch fits, so irda_decode_buffer() never stops early */
+#define IRDA_WORKER_RX_BATCH_MESSAGES       IRDA_WORKER_RX_BATCH_SIZE
 
 #define IRDA_WORKER_RX_RECEIVED             0x01
 #define IRDA_WORKER_RX_TIMEOUT_RECEIVED     0x02
@@ -78,8 +82,18 @@ struct IrdaWorker {
             IrdaWorkerReceivedSignalCallback received_signal_callback;
             void* received_signal_context;
             bool overrun;
+            IrdaMessage messages[IRDA_WORKER_RX_BATCH_MESSAGES];
         } rx;
     };
+
+    FuriStatsGroup* stats;
+    FuriStatsCounter* stats_edges;
+    FuriStatsCounter* stats_stream_overruns;
+    FuriStatsCounter* stats_signal_overruns;
+    FuriStatsCounter* stats_stream_max;
+    FuriStatsCounter* stats_raw;
+    FuriStatsCounter* stats_decoded[IrdaProtocolMAX];
+    FuriStatsHistogram* stats_decode_latency;
 };
 
 typedef struct {
@@ -109,6 +123,9 @@ static void irda_worker_rx_callback(void* context, bool level, uint32_t duration
     size_t ret =
         xStreamBufferSendFromISR(instance->stream, &level_duration, sizeof(LevelDuration), &xHigherPriorityTaskWoken);
     uint32_t events = (ret == sizeof(LevelDuration)) ? IRDA_WORKER_RX_RECEIVED : IRDA_WORKER_OVERRUN;
+    furi_stats_counter_add(instance->stats_edges, 1);
+    if (events == IRDA_WORKER_OVERRUN)
+        furi_stats_counter_add(instance->stats_stream_overruns, 1);
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 
     uint32_t flags_set = osEventFlagsSet(instance->events, events);
@@ -124,35 +141,74 @@ static void irda_worker_process_timeout(IrdaWorker* instance) {
         instance->signal.message = *message_decoded;
         instance->signal.timings_cnt = 0;
         instance->signal.decoded = true;
+        furi_stats_counter_add(instance->stats_decoded[message_decoded->protocol], 1);
     } else {
         instance->signal.decoded = false;
+        furi_stats_counter_add(instance->stats_raw, 1);
     }
     if (instance->rx.received_signal_callback)
         instance->rx.received_signal_callback(instance->rx.received_signal_context, &instance->signal);
 }
 
+static void irda_worker_signal_decoded(IrdaWorker* instance, const IrdaMessage* message) {
+    instance->signal.message = *message;
+    instance->signal.timings_cnt = 0;
+    instance->signal.decoded = true;
+    furi_stats_counter_add(instance->stats_decoded[message->protocol], 1);
+    if (instance->rx.received_signal_callback)
+        instance->rx.received_signal_callback(instance->rx.received_signal_context, &instance->signal);
+}
+
+static void irda_worker_signal_add_timing(IrdaWorker* instance, uint32_t duration, bool level) {
+    /* Skip first timing if it starts from Space */
+    if ((instance->signal.timings_cnt == 0) && !level) {
+        return;
+    }
+
+    if (instance->signal.timings_cnt < MAX_TIMINGS_AMOUNT) {
+        instance->signal.timings[instance->signal.timings_cnt] = duration;
+        ++instance->signal.timings_cnt;
+    } else {
+        uint32_t flags_set = osEventFlagsSet(instance->events, IRDA_WORKER_OVERRUN);
+        furi_check(flags_set & IRDA_WORKER_OVERRUN);
+        if (!instance->rx.overrun)
+            furi_stats_counter_add(instance->stats_signal_overruns, 1);
+        instance->rx.overrun = true;
+    }
+}
+
 static void irda_worker_process_timings(IrdaWorker* instance, uint32_t duration, bool level) {
     const IrdaMessage* message_decoded = irda_decode(instance->irda_decoder, level, duration);
     if (message_decoded) {
-        instance->signal.message = *message_decoded;
-        instance->signal.timings_cnt = 0;
-        instance->signal.decoded = true;
-        if (instance->rx.received_signal_callback)
-            instance->rx.received_signal_callback(instance->rx.received_signal_context, &instance->signal);
+        irda_worker_signal_decoded(instance, message_decoded);
     } else {
-        /* Skip first timing if it starts from Space */
-        if ((instance->signal.timings_cnt == 0) && !level) {
-            return;
-        }
+        irda_worker_signal_add_timing(instance, duration, level);
+    }
+}
 
-        if (instance->signal.timings_cnt < MAX_TIMINGS_AMOUNT) {
-            instance->signal.timings[instance->signal.timings_cnt] = duration;
-            ++instance->signal.timings_cnt;
-        } else {
-            uint32_t flags_set = osEventFlagsSet(instance->events, IRDA_WORKER_OVERRUN);
-            furi_check(flags_set & IRDA_WORKER_OVERRUN);
-            instance->rx.overrun = true;
-        }
+/* Batch starts from Mark, then levels alternate */
+static void irda_worker_process_batch(IrdaWorker* instance, const uint32_t* timings, size_t timings_cnt) {
+    IrdaMessage* messages = instance->rx.messages;
+    size_t decoded_end = 0;
+    uint32_t start = furi_stats_timer_start();
+    /* Batch holds no more messages than timings, so decoding never stops early */
+    size_t messages_cnt = irda_decode_buffer(
+        instance->irda_decoder,
+        timings,
+        timings_cnt,
+        messages,
+        IRDA_WORKER_RX_BATCH_MESSAGES,
+        &decoded_end);
+    furi_stats_timer_stop(instance->stats_decode_latency, start);
+
+    for (size_t i = 0; i < messages_cnt; ++i) {
+        irda_worker_signal_decoded(instance, &messages[i]);
+    }
+
+    /* Timings after last message are kept, same as with irda_decode() per timing:
+     * they start next raw signal, or a message to be checked on timeout */
+    for (size_t i = decoded_end; (i < timings_cnt) && !instance->rx.overrun; ++i) {
+        irda_worker_signal_add_timing(instance, timings[i], !(i % 2));
     }
 }
 
@@ -161,6 +217,8 @@ static int32_t irda_worker_rx_thread(void* thread_context) {
     uint32_t events = 0;
     LevelDuration level_duration;
     TickType_t last_blink_time = 0;
+    uint32_t batch[IRDA_WORKER_RX_BATCH_SIZE];
+    size_t batch_cnt = 0;
 
     while(1) {
         events = osEventFlagsWait(instance->events, IRDA_WORKER_ALL_RX_EVENTS, 0, osWaitForever);
@@ -173,13 +231,29 @@ static int32_t irda_worker_rx_thread(void* thread_context) {
             }
             if (instance->signal.timings_cnt == 0)
                 notification_message(instance->notification, &sequence_display_on);
+            furi_stats_counter_max(instance->stats_stream_max,
+                xStreamBufferBytesAvailable(instance->stream) / sizeof(LevelDuration));
             while (sizeof(LevelDuration) == xStreamBufferReceive(instance->stream, &level_duration, sizeof(LevelDuration), 0)) {
-                if (!instance->rx.overrun) {
-                    bool level = level_duration_get_level(level_duration);
-                    uint32_t duration = level_duration_get_duration(level_duration);
+                if (instance->rx.overrun)
+                    continue;
+
+                bool level = level_duration_get_level(level_duration);
+                uint32_t duration = level_duration_get_duration(level_duration);
+                if (level == !(batch_cnt % 2)) {
+                    batch[batch_cnt++] = duration;
+                    if (batch_cnt == IRDA_WORKER_RX_BATCH_SIZE) {
+                        irda_worker_process_batch(instance, batch, batch_cnt);
+                        batch_cnt = 0;
+                    }
+                } else {
+                    /* Leading Space or broken alternation - decode it on its own */
+                    irda_worker_process_batch(instance, batch, batch_cnt);
+                    batch_cnt = 0;
                     irda_worker_process_timings(instance, duration, level);
                 }
             }
+            irda_worker_process_batch(instance, batch, batch_cnt);
+            batch_cnt = 0;
         }
         if (events & IRDA_WORKER_OVERRUN) {
             printf("#");
@@ -229,6 +303,17 @@ IrdaWorker* irda_worker_alloc() {
     instance->state = IrdaWorkerStateIdle;
     instance->events = osEventFlagsNew(NULL);
 
+    instance->stats = furi_stats_group_alloc("irda_worker");
+    instance->stats_edges = furi_stats_counter_alloc(instance->stats, "edges");
+    instance->stats_stream_overruns = furi_stats_counter_alloc(instance->stats, "stream_overruns");
+    instance->stats_signal_overruns = furi_stats_counter_alloc(instance->stats, "signal_overruns");
+    instance->stats_stream_max = furi_stats_counter_alloc(instance->stats, "stream_max");
+    instance->stats_raw = furi_stats_counter_alloc(instance->stats, "raw");
+    for (size_t i = 0; i < IrdaProtocolMAX; ++i) {
+        instance->stats_decoded[i] = furi_stats_counter_alloc(instance->stats, irda_get_protocol_name(i));
+    }
+    instance->stats_decode_latency = furi_stats_histogram_alloc(instance->stats, "decode_latency", "us");
+
     return instance;
 }
 
@@ -236,6 +321,7 @@ void irda_worker_free(IrdaWorker* instance) {
     furi_assert(instance);
     furi_assert(instance->state == IrdaWorkerStateIdle);
 
+    furi_stats_group_free(instance->stats);
     furi_record_close("notification");
     irda_free_decoder(instance->irda_decoder);
     irda_free_encoder(instance->irda_encoder);
@@ -99,6 +99,10 @@ C_SOURCES		+= $(wildcard $(LIB_DIR)/irda/worker/*.c)
 C_SOURCES		+= $(wildcard $(LIB_DIR)/subghz/*.c)
 C_SOURCES		+= $(wildcard $(LIB_DIR)/subghz/*/*.c)
 
+# KeeLoq cipher backend: 0 - reference, 1 - unrolled, 2 - bitsliced batches
+KEELOQ_CIPHER	?= 1
+CFLAGS			+= -DKEELOQ_CIPHER=$(KEELOQ_CIPHER)
+
 #scened app template lib
 CFLAGS			+= -I$(LIB_DIR)/app-scened-template
 C_SOURCES		+= $(wildcard $(LIB_DIR)/app-scened-template/*.c)
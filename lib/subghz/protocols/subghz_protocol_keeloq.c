@@ -7,10 +7,56 @@
 
 #include <m-string.h>
 
+#define SUBGHZ_KEELOQ_CACHE_SIZE 8
+
+// Only bitsliced cipher decrypts batches faster than one key at a time
+#define SUBGHZ_KEELOQ_SCAN (KEELOQ_CIPHER == KEELOQ_CIPHER_BITSLICE)
+
+/* Remote that was recently matched: next packets with the same serial are
+ * checked against its learning key first, with a single decryption */
+typedef struct {
+    uint32_t serial;
+    uint64_t man;
+    const char* manufacture_name;
+} SubGhzProtocolKeeloqCacheEntry;
+
+#if SUBGHZ_KEELOQ_SCAN
+// Keystore keys checked with one batch of decryptions
+#define SUBGHZ_KEELOQ_SCAN_KEYS 16
+// Learning keys tried per manufacture key of unknown type
+#define SUBGHZ_KEELOQ_SCAN_VARIANTS 6
+
+/* Scratch for keystore scan, learning keys of several manufacture keys are
+ * derived and tried in batches */
+typedef struct {
+    // Normal Learning: two decryptions of serial per key
+    uint64_t normal_keys[SUBGHZ_KEELOQ_SCAN_KEYS * 2];
+    uint32_t normal_low[SUBGHZ_KEELOQ_SCAN_KEYS * 2];
+    uint32_t normal_high[SUBGHZ_KEELOQ_SCAN_KEYS * 2];
+    // Secure Learning: seed part is precomputed by keystore
+    uint64_t secure_keys[SUBGHZ_KEELOQ_SCAN_KEYS * 2];
+    uint32_t secure_seed[SUBGHZ_KEELOQ_SCAN_KEYS * 2];
+    uint32_t secure_high[SUBGHZ_KEELOQ_SCAN_KEYS * 2];
+    // Learning keys in the order they must be tried
+    uint64_t man[SUBGHZ_KEELOQ_SCAN_KEYS * SUBGHZ_KEELOQ_SCAN_VARIANTS];
+    SubGhzKey* manufacture_code[SUBGHZ_KEELOQ_SCAN_KEYS * SUBGHZ_KEELOQ_SCAN_VARIANTS];
+    uint32_t decrypt[SUBGHZ_KEELOQ_SCAN_KEYS * SUBGHZ_KEELOQ_SCAN_VARIANTS];
+} SubGhzProtocolKeeloqScan;
+#endif
+
 struct SubGhzProtocolKeeloq {
     SubGhzProtocolCommon common;
     SubGhzKeystore* keystore;
     const char* manufacture_name;
+
+    // Most recently matched first
+    SubGhzProtocolKeeloqCacheEntry cache[SUBGHZ_KEELOQ_CACHE_SIZE];
+    size_t cache_count;
+    uint32_t cache_generation;
+
+#if SUBGHZ_KEELOQ_SCAN
+    SubGhzProtocolKeeloqScan scan;
+#endif
 };
 
 typedef enum {
@@ -63,114 +109,341 @@ static inline bool subghz_protocol_keeloq_check_decrypt(
     return false;
 }
 
-/** Checking the accepted code against the database manafacture key
+static void subghz_protocol_keeloq_cache_put(
+    SubGhzProtocolKeeloq* instance,
+    uint32_t serial,
+    uint64_t man,
+    const char* manufacture_name) {
+    size_t index = 0;
+    while(index < instance->cache_count && instance->cache[index].serial != serial) index++;
+    if(index == SUBGHZ_KEELOQ_CACHE_SIZE) {
+        // Drop least recently matched
+        index--;
+    } else if(index == instance->cache_count) {
+        instance->cache_count++;
+    }
+
+    memmove(&instance->cache[1], &instance->cache[0], sizeof(instance->cache[0]) * index);
+    instance->cache[0].serial = serial;
+    instance->cache[0].man = man;
+    instance->cache[0].manufacture_name = manufacture_name;
+}
+
+/** Checking the accepted code against recently matched remotes
  * 
  * @param instance SubGhzProtocolKeeloq instance
  * @param fix fix part of the parcel
  * @param hop hop encrypted part of the parcel
- * @return true on successful search
+ * @return true if remote was matched before and its key still fits
  */
-uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
+static bool subghz_protocol_keeloq_cache_check(
     SubGhzProtocolKeeloq* instance,
     uint32_t fix,
     uint32_t hop) {
+    uint32_t generation = subghz_keystore_get_generation(instance->keystore);
+    if(instance->cache_generation != generation) {
+        // Names point into keystore, which was changed
+        instance->cache_count = 0;
+        instance->cache_generation = generation;
+        return false;
+    }
+
+    uint32_t serial = fix & 0x0FFFFFFF;
+    for(size_t i = 0; i < instance->cache_count; i++) {
+        SubGhzProtocolKeeloqCacheEntry* entry = &instance->cache[i];
+        if(entry->serial != serial) continue;
+
+        uint32_t decrypt = subghz_protocol_keeloq_common_decrypt(hop, entry->man);
+        if(!subghz_protocol_keeloq_check_decrypt(
+               instance, decrypt, (uint8_t)(fix >> 28), (uint16_t)(fix & 0xFF))) {
+            return false;
+        }
+        instance->manufacture_name = entry->manufacture_name;
+        subghz_protocol_keeloq_cache_put(instance, serial, entry->man, entry->manufacture_name);
+        return true;
+    }
+    return false;
+}
+
+#if SUBGHZ_KEELOQ_SCAN
+static inline void subghz_protocol_keeloq_scan_add(
+    SubGhzProtocolKeeloqScan* scan,
+    size_t* man_count,
+    uint64_t man,
+    SubGhzKey* manufacture_code) {
+    scan->man[*man_count] = man;
+    scan->manufacture_code[*man_count] = manufacture_code;
+    (*man_count)++;
+}
+
+static inline uint64_t
+    subghz_protocol_keeloq_scan_normal(SubGhzProtocolKeeloqScan* scan, size_t* index) {
+    uint64_t man = (uint64_t)scan->normal_high[*index] << 32 | scan->normal_low[*index];
+    (*index)++;
+    return man;
+}
+
+static inline uint64_t
+    subghz_protocol_keeloq_scan_secure(SubGhzProtocolKeeloqScan* scan, size_t* index) {
+    uint64_t man = (uint64_t)scan->secure_high[*index] << 32 | scan->secure_seed[*index];
+    (*index)++;
+    return man;
+}
+
+/** Checking the accepted code against a part of the database manafacture key
+ * 
+ * Candidates are tried in the same order as with one key at a time, so the
+ * first matching key wins as before. Hop is decrypted KEELOQ_BITSLICE_LANES
+ * candidates at a time and search stops at the first batch with a match.
+ * 
+ * @param instance SubGhzProtocolKeeloq instance
+ * @param fix fix part of the parcel
+ * @param hop hop encrypted part of the parcel
+ * @param manufacture_codes keys to check
+ * @param count keys count, up to SUBGHZ_KEELOQ_SCAN_KEYS
+ * @return true on successful search
+ */
+static bool subghz_protocol_keeloq_check_remote_controller_batch(
+    SubGhzProtocolKeeloq* instance,
+    uint32_t fix,
+    uint32_t hop,
+    SubGhzKey* manufacture_codes,
+    size_t count) {
+    SubGhzProtocolKeeloqScan* scan = &instance->scan;
+    size_t normal_count = 0;
+    size_t secure_count = 0;
+
+    // Serial dependent halves of learning keys
+    for(size_t i = 0; i < count; i++) {
+        SubGhzKey* manufacture_code = &manufacture_codes[i];
+        switch(manufacture_code->type) {
+        case KEELOQ_LEARNING_NORMAL:
+            scan->normal_keys[normal_count++] = manufacture_code->key;
+            break;
+        case KEELOQ_LEARNING_SECURE:
+            scan->secure_keys[secure_count] = manufacture_code->key;
+            scan->secure_seed[secure_count++] = manufacture_code->seed_decrypt;
+            break;
+        case KEELOQ_LEARNING_UNKNOWN:
+            scan->normal_keys[normal_count++] = manufacture_code->key;
+            scan->normal_keys[normal_count++] = manufacture_code->key_mirrored;
+            scan->secure_keys[secure_count] = manufacture_code->key;
+            scan->secure_seed[secure_count++] = manufacture_code->seed_decrypt;
+            scan->secure_keys[secure_count] = manufacture_code->key_mirrored;
+            scan->secure_seed[secure_count++] = manufacture_code->seed_decrypt_mirrored;
+            break;
+        }
+    }
+    // Same as subghz_protocol_keeloq_common_normal_learning
+    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+    subghz_protocol_keeloq_common_decrypt_batch(
+        (fix & 0x0FFFFFFF) | 0x20000000, scan->normal_keys, normal_count, scan->normal_low);
+    subghz_protocol_keeloq_common_decrypt_batch(
+        (fix & 0x0FFFFFFF) | 0x60000000, scan->normal_keys, normal_count, scan->normal_high);
+    // Same as subghz_protocol_keeloq_common_secure_learning with zero seed
+    subghz_protocol_keeloq_common_decrypt_batch(
+        fix & 0x0FFFFFFF, scan->secure_keys, secure_count, scan->secure_high);
+
+    size_t man_count = 0;
+    size_t normal_index = 0;
+    size_t secure_index = 0;
+    uint64_t man;
+    for(size_t i = 0; i < count; i++) {
+        SubGhzKey* manufacture_code = &manufacture_codes[i];
+        switch(manufacture_code->type) {
+        case KEELOQ_LEARNING_SIMPLE:
+            // Simple Learning
+            subghz_protocol_keeloq_scan_add(
+                scan, &man_count, manufacture_code->key, manufacture_code);
+            break;
+        case KEELOQ_LEARNING_NORMAL:
+            // Normal Learning
+            man = subghz_protocol_keeloq_scan_normal(scan, &normal_index);
+            subghz_protocol_keeloq_scan_add(scan, &man_count, man, manufacture_code);
+            break;
+        case KEELOQ_LEARNING_SECURE:
+            man = subghz_protocol_keeloq_scan_secure(scan, &secure_index);
+            subghz_protocol_keeloq_scan_add(scan, &man_count, man, manufacture_code);
+            break;
+        case KEELOQ_LEARNING_UNKNOWN:
+            // Simple Learning
+            subghz_protocol_keeloq_scan_add(
+                scan, &man_count, manufacture_code->key, manufacture_code);
+            // Check for mirrored man
+            subghz_protocol_keeloq_scan_add(
+                scan, &man_count, manufacture_code->key_mirrored, manufacture_code);
+            // Normal Learning, key and mirrored key
+            man = subghz_protocol_keeloq_scan_normal(scan, &normal_index);
+            subghz_protocol_keeloq_scan_add(scan, &man_count, man, manufacture_code);
+            man = subghz_protocol_keeloq_scan_normal(scan, &normal_index);
+            subghz_protocol_keeloq_scan_add(scan, &man_count, man, manufacture_code);
+            // Secure Learning, key and mirrored key
+            man = subghz_protocol_keeloq_scan_secure(scan, &secure_index);
+            subghz_protocol_keeloq_scan_add(scan, &man_count, man, manufacture_code);
+            man = subghz_protocol_keeloq_scan_secure(scan, &secure_index);
+            subghz_protocol_keeloq_scan_add(scan, &man_count, man, manufacture_code);
+            break;
+        }
+    }
+
     // protocol HCS300 uses 10 bits in discriminator, HCS200 uses 8 bits, for backward compatibility, we are looking for the 8-bit pattern
     // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
     // HCS200 -> uint16_t end_serial = (uint16_t)(fix & 0xFF);
-
     uint16_t end_serial = (uint16_t)(fix & 0xFF);
     uint8_t btn = (uint8_t)(fix >> 28);
-    uint32_t decrypt = 0;
-    uint64_t man_learning;
-    uint32_t seed = 0;
+    // Results are checked as every batch finishes, so early match skips the rest
+    for(size_t start = 0; start < man_count; start += KEELOQ_BITSLICE_LANES) {
+        size_t end = MIN(start + KEELOQ_BITSLICE_LANES, man_count);
+        subghz_protocol_keeloq_common_decrypt_batch(
+            hop, &scan->man[start], end - start, &scan->decrypt[start]);
+        for(size_t i = start; i < end; i++) {
+            if(subghz_protocol_keeloq_check_decrypt(instance, scan->decrypt[i], btn, end_serial)) {
+                instance->manufacture_name = string_get_cstr(scan->manufacture_code[i]->name);
+                subghz_protocol_keeloq_cache_put(
+                    instance, fix & 0x0FFFFFFF, scan->man[i], instance->manufacture_name);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+#else
+/** Secure Learning with seed part precomputed by keystore
+ * 
+ * @param fix fix part of the parcel
+ * @param seed_decrypt decrypted seed
+ * @param key manufacture key
+ * @return manufacture for this serial number
+ */
+static inline uint64_t
+    subghz_protocol_keeloq_secure_learning(uint32_t fix, uint32_t seed_decrypt, uint64_t key) {
+    return ((uint64_t)subghz_protocol_keeloq_common_decrypt(fix & 0x0FFFFFFF, key) << 32) |
+           seed_decrypt;
+}
 
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(instance->keystore), SubGhzKeyArray_t) {
-            switch(manufacture_code->type) {
-            case KEELOQ_LEARNING_SIMPLE:
-                // Simple Learning
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_NORMAL:
-                // Normal Learning
-                // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                man_learning =
-                    subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_learning);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_SECURE:
-                man_learning = subghz_protocol_keeloq_common_secure_learning(
-                    fix, seed, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_learning);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_UNKNOWN:
-                // Simple Learning
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                // Check for mirrored man
-                uint64_t man_rev = 0;
-                uint64_t man_rev_byte = 0;
-                for(uint8_t i = 0; i < 64; i += 8) {
-                    man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                    man_rev = man_rev | man_rev_byte << (56 - i);
-                }
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                //###########################
-                // Normal Learning
-                // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                man_learning =
-                    subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_learning);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                man_learning = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_learning);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+/** Checking the accepted code against one learning key
+ * 
+ * @param instance SubGhzProtocolKeeloq instance
+ * @param fix fix part of the parcel
+ * @param hop hop encrypted part of the parcel
+ * @param man learning key
+ * @param manufacture_code manufacture key which learning key derived from
+ * @return true if key fits
+ */
+static inline bool subghz_protocol_keeloq_check_man(
+    SubGhzProtocolKeeloq* instance,
+    uint32_t fix,
+    uint32_t hop,
+    uint64_t man,
+    SubGhzKey* manufacture_code) {
+    // protocol HCS300 uses 10 bits in discriminator, HCS200 uses 8 bits, for backward compatibility, we are looking for the 8-bit pattern
+    // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
+    // HCS200 -> uint16_t end_serial = (uint16_t)(fix & 0xFF);
+    uint32_t decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+    if(!subghz_protocol_keeloq_check_decrypt(
+           instance, decrypt, (uint8_t)(fix >> 28), (uint16_t)(fix & 0xFF))) {
+        return false;
+    }
+    instance->manufacture_name = string_get_cstr(manufacture_code->name);
+    subghz_protocol_keeloq_cache_put(instance, fix & 0x0FFFFFFF, man, instance->manufacture_name);
+    return true;
+}
 
-                // Secure Learning
-                man_learning = subghz_protocol_keeloq_common_secure_learning(
-                    fix, seed, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_learning);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+/** Checking the accepted code against one manufacture key, learning keys are
+ * tried one by one and the first match wins
+ * 
+ * @param instance SubGhzProtocolKeeloq instance
+ * @param fix fix part of the parcel
+ * @param hop hop encrypted part of the parcel
+ * @param manufacture_code manufacture key
+ * @return true if key fits
+ */
+static bool subghz_protocol_keeloq_check_manufacture_code(
+    SubGhzProtocolKeeloq* instance,
+    uint32_t fix,
+    uint32_t hop,
+    SubGhzKey* manufacture_code) {
+    uint64_t man_learning;
 
-                // Check for mirrored man
+    switch(manufacture_code->type) {
+    case KEELOQ_LEARNING_SIMPLE:
+        // Simple Learning
+        return subghz_protocol_keeloq_check_man(
+            instance, fix, hop, manufacture_code->key, manufacture_code);
+    case KEELOQ_LEARNING_NORMAL:
+        // Normal Learning
+        // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+        man_learning = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+        return subghz_protocol_keeloq_check_man(instance, fix, hop, man_learning, manufacture_code);
+    case KEELOQ_LEARNING_SECURE:
+        man_learning = subghz_protocol_keeloq_secure_learning(
+            fix, manufacture_code->seed_decrypt, manufacture_code->key);
+        return subghz_protocol_keeloq_check_man(instance, fix, hop, man_learning, manufacture_code);
+    case KEELOQ_LEARNING_UNKNOWN:
+        // Simple Learning
+        if(subghz_protocol_keeloq_check_man(
+               instance, fix, hop, manufacture_code->key, manufacture_code))
+            return true;
+        // Check for mirrored man
+        if(subghz_protocol_keeloq_check_man(
+               instance, fix, hop, manufacture_code->key_mirrored, manufacture_code))
+            return true;
+        // Normal Learning
+        // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+        man_learning = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+        if(subghz_protocol_keeloq_check_man(instance, fix, hop, man_learning, manufacture_code))
+            return true;
+        man_learning =
+            subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key_mirrored);
+        if(subghz_protocol_keeloq_check_man(instance, fix, hop, man_learning, manufacture_code))
+            return true;
+        // Secure Learning
+        man_learning = subghz_protocol_keeloq_secure_learning(
+            fix, manufacture_code->seed_decrypt, manufacture_code->key);
+        if(subghz_protocol_keeloq_check_man(instance, fix, hop, man_learning, manufacture_code))
+            return true;
+        // Check for mirrored man
+        man_learning = subghz_protocol_keeloq_secure_learning(
+            fix, manufacture_code->seed_decrypt_mirrored, manufacture_code->key_mirrored);
+        return subghz_protocol_keeloq_check_man(instance, fix, hop, man_learning, manufacture_code);
+    }
+    return false;
+}
+#endif
 
-                man_learning = subghz_protocol_keeloq_common_secure_learning(fix, seed, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_learning);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            }
+/** Checking the accepted code against the database manafacture key
+ * 
+ * @param instance SubGhzProtocolKeeloq instance
+ * @param fix fix part of the parcel
+ * @param hop hop encrypted part of the parcel
+ * @return true on successful search
+ */
+uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
+    SubGhzProtocolKeeloq* instance,
+    uint32_t fix,
+    uint32_t hop) {
+    // Repeated presses of the same remote
+    if(subghz_protocol_keeloq_cache_check(instance, fix, hop)) return 1;
+
+    SubGhzKeyArray_t* manufacture_codes = subghz_keystore_get_data(instance->keystore);
+#if SUBGHZ_KEELOQ_SCAN
+    size_t size = SubGhzKeyArray_size(*manufacture_codes);
+    for(size_t i = 0; i < size; i += SUBGHZ_KEELOQ_SCAN_KEYS) {
+        if(subghz_protocol_keeloq_check_remote_controller_batch(
+               instance,
+               fix,
+               hop,
+               SubGhzKeyArray_get(*manufacture_codes, i),
+               MIN(size - i, (size_t)SUBGHZ_KEELOQ_SCAN_KEYS)))
+            return 1;
+    }
+#else
+    for
+        M_EACH(manufacture_code, *manufacture_codes, SubGhzKeyArray_t) {
+            if(subghz_protocol_keeloq_check_manufacture_code(instance, fix, hop, manufacture_code))
+                return 1;
         }
+#endif
 
     instance->manufacture_name = "Unknown";
     instance->common.cnt = 0;
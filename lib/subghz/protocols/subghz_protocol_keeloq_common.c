@@ -5,6 +5,8 @@
 #include <m-string.h>
 #include <m-array.h>
 
+#if KEELOQ_CIPHER == KEELOQ_CIPHER_REFERENCE
+
 /** Simple Learning Encrypt
  * @param data - 0xBSSSCCCC, B(4bit) key, S(10bit) serial&0x3FF, C(16bit) counter
  * @param key - manufacture (64bit)
@@ -32,6 +34,151 @@ inline uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const
     return x;
 }
 
+#else
+
+/* NLF output for 5 input bits of x, gathered into table index with constant shifts */
+#define KEELOQ_NLF_BIT(x, a, b, c, d, e)                                             \
+    (KEELOQ_NLF >> ((((x) >> (a)) & 1) | (((x) >> ((b)-1)) & 2) | (((x) >> ((c)-2)) & 4) | \
+                    (((x) >> ((d)-3)) & 8) | (((x) >> ((e)-4)) & 16)))
+
+/* k - key bit in bit 0 */
+#define KEELOQ_ENCRYPT_ROUND(x, k) \
+    x = ((x) >> 1) ^ ((((x) ^ ((x) >> 16) ^ (k) ^ KEELOQ_NLF_BIT(x, 1, 9, 20, 26, 31)) & 1) << 31)
+
+#define KEELOQ_DECRYPT_ROUND(x, k) \
+    x = ((x) << 1) ^ (((x) >> 31 ^ (x) >> 15 ^ (k) ^ KEELOQ_NLF_BIT(x, 0, 8, 19, 25, 30)) & 1)
+
+/** Simple Learning Encrypt
+ * @param data - 0xBSSSCCCC, B(4bit) key, S(10bit) serial&0x3FF, C(16bit) counter
+ * @param key - manufacture (64bit)
+ * @return keelog encrypt data
+ */
+uint32_t subghz_protocol_keeloq_common_encrypt(const uint32_t data, const uint64_t key) {
+    uint32_t x = data;
+    // Round r uses key bit r % 64: key bytes 0..7, lowest bit first
+    for(uint8_t step = 0; step < 528 / 8; step++) {
+        uint32_t k = (uint8_t)(key >> ((step & 7) * 8));
+        KEELOQ_ENCRYPT_ROUND(x, k);
+        KEELOQ_ENCRYPT_ROUND(x, k >> 1);
+        KEELOQ_ENCRYPT_ROUND(x, k >> 2);
+        KEELOQ_ENCRYPT_ROUND(x, k >> 3);
+        KEELOQ_ENCRYPT_ROUND(x, k >> 4);
+        KEELOQ_ENCRYPT_ROUND(x, k >> 5);
+        KEELOQ_ENCRYPT_ROUND(x, k >> 6);
+        KEELOQ_ENCRYPT_ROUND(x, k >> 7);
+    }
+    return x;
+}
+
+/** Simple Learning Decrypt
+ * @param data - keelog encrypt data
+ * @param key - manufacture (64bit)
+ * @return 0xBSSSCCCC, B(4bit) key, S(10bit) serial&0x3FF, C(16bit) counter
+ */
+uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const uint64_t key) {
+    uint32_t x = data;
+    // Round r uses key bit (15 - r) % 64: key bytes 1, 0, 7..2, highest bit first
+    for(uint8_t step = 0; step < 528 / 8; step++) {
+        uint32_t k = (uint8_t)(key >> (((1 - step) & 7) * 8));
+        KEELOQ_DECRYPT_ROUND(x, k >> 7);
+        KEELOQ_DECRYPT_ROUND(x, k >> 6);
+        KEELOQ_DECRYPT_ROUND(x, k >> 5);
+        KEELOQ_DECRYPT_ROUND(x, k >> 4);
+        KEELOQ_DECRYPT_ROUND(x, k >> 3);
+        KEELOQ_DECRYPT_ROUND(x, k >> 2);
+        KEELOQ_DECRYPT_ROUND(x, k >> 1);
+        KEELOQ_DECRYPT_ROUND(x, k);
+    }
+    return x;
+}
+
+#endif
+
+#if KEELOQ_CIPHER == KEELOQ_CIPHER_BITSLICE
+
+/* KEELOQ_NLF in algebraic normal form, every bit of arguments is separate lane */
+static inline uint32_t subghz_protocol_keeloq_common_nlf_bitslice(
+    uint32_t a,
+    uint32_t b,
+    uint32_t c,
+    uint32_t d,
+    uint32_t e) {
+    uint32_t ab = a & b;
+    uint32_t cd = c & d;
+    uint32_t t = a ^ b ^ ab ^ (b & c) ^ (a & d) ^ cd;
+    uint32_t u = a ^ ab ^ c ^ (a & c) ^ (b & d) ^ cd;
+    return t ^ (e & u);
+}
+
+/** Decrypt one data with up to KEELOQ_BITSLICE_LANES keys at once
+ * 
+ * State bit i of all lanes lives in one word, so round shift is only a change
+ * of the word that is bit 0.
+ */
+static void subghz_protocol_keeloq_common_decrypt_bitslice(
+    const uint32_t data,
+    const uint64_t* keys,
+    size_t count,
+    uint32_t* result) {
+    uint32_t key_slices[64] = {0};
+    for(size_t lane = 0; lane < count; lane++) {
+        uint32_t key_low = keys[lane];
+        uint32_t key_high = keys[lane] >> 32;
+        for(uint8_t i = 0; i < 32; i++) {
+            key_slices[i] |= ((key_low >> i) & 1) << lane;
+            key_slices[i + 32] |= ((key_high >> i) & 1) << lane;
+        }
+    }
+
+    // Before round r bit i is state[(r + 31 - i) % 32]
+    uint32_t state[32];
+    for(uint8_t i = 0; i < 32; i++) {
+        state[(31 - i) & 31] = -((data >> i) & 1);
+    }
+
+    uint32_t r;
+    for(r = 0; r < 528; r++) {
+        uint32_t x31 = state[r & 31];
+        uint32_t nlf = subghz_protocol_keeloq_common_nlf_bitslice(
+            state[(r + 31) & 31],
+            state[(r + 23) & 31],
+            state[(r + 12) & 31],
+            state[(r + 6) & 31],
+            state[(r + 1) & 31]);
+        // New bit 0 takes place of bit 31
+        state[r & 31] = x31 ^ state[(r + 16) & 31] ^ key_slices[(15 - r) & 63] ^ nlf;
+    }
+
+    for(size_t lane = 0; lane < count; lane++) {
+        uint32_t x = 0;
+        for(uint8_t i = 0; i < 32; i++) {
+            x |= ((state[(r + 31 - i) & 31] >> lane) & 1) << i;
+        }
+        result[lane] = x;
+    }
+}
+
+#endif
+
+void subghz_protocol_keeloq_common_decrypt_batch(
+    const uint32_t data,
+    const uint64_t* keys,
+    size_t count,
+    uint32_t* result) {
+    size_t i = 0;
+#if KEELOQ_CIPHER == KEELOQ_CIPHER_BITSLICE
+    // Bitsliced pass costs about as much as 4 single decryptions
+    while(count - i >= 4) {
+        size_t lanes = MIN(count - i, (size_t)KEELOQ_BITSLICE_LANES);
+        subghz_protocol_keeloq_common_decrypt_bitslice(data, &keys[i], lanes, &result[i]);
+        i += lanes;
+    }
+#endif
+    for(; i < count; i++) {
+        result[i] = subghz_protocol_keeloq_common_decrypt(data, keys[i]);
+    }
+}
+
 /** Normal Learning
  * @param data - serial number (28bit)
  * @param key - manufacture (64bit)
@@ -25,6 +25,21 @@
 #define KEELOQ_LEARNING_NORMAL 2u
 #define KEELOQ_LEARNING_SECURE 3u
 
+/*
+ * KeeLoq cipher backends, selected at build time with KEELOQ_CIPHER
+ * All of them give the same results, only speed differs
+ */
+#define KEELOQ_CIPHER_REFERENCE 0 /* One bit per round, straight from datasheet */
+#define KEELOQ_CIPHER_UNROLLED 1 /* Key consumed bytewise, rounds unrolled by 8 */
+#define KEELOQ_CIPHER_BITSLICE 2 /* Unrolled, batches decrypted 32 keys at a time */
+
+#ifndef KEELOQ_CIPHER
+#define KEELOQ_CIPHER KEELOQ_CIPHER_UNROLLED
+#endif
+
+/* Keys decrypted at once by bitsliced backend */
+#define KEELOQ_BITSLICE_LANES 32
+
 /** Simple Learning Encrypt
  * @param data - 0xBSSSCCCC, B(4bit) key, S(10bit) serial&0x3FF, C(16bit) counter
  * @param key - manufacture (64bit)
@@ -39,6 +54,18 @@ uint32_t subghz_protocol_keeloq_common_encrypt(const uint32_t data, const uint64
  */
 uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const uint64_t key);
 
+/** Simple Learning Decrypt of one data with many keys
+ * @param data - keelog encrypt data
+ * @param keys - manufacture (64bit) array
+ * @param count - keys count
+ * @param result - 0xBSSSCCCC for every key, B(4bit) key, S(10bit) serial&0x3FF, C(16bit) counter
+ */
+void subghz_protocol_keeloq_common_decrypt_batch(
+    const uint32_t data,
+    const uint64_t* keys,
+    size_t count,
+    uint32_t* result);
+
 /** Normal Learning
  * @param data - serial number (28bit)
  * @param key - manufacture (64bit)
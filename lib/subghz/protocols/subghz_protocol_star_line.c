@@ -154,13 +154,8 @@ uint8_t subghz_protocol_star_line_check_remote_controller_selector(
                     return 1;
                 }
                 // Check for mirrored man
-                uint64_t man_rev = 0;
-                uint64_t man_rev_byte = 0;
-                for(uint8_t i = 0; i < 64; i += 8) {
-                    man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                    man_rev = man_rev | man_rev_byte << (56 - i);
-                }
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
+                decrypt =
+                    subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key_mirrored);
                 if((decrypt >> 24 == btn) &&
                    ((((uint16_t)(decrypt >> 16)) & 0x00FF) == end_serial)) {
                     instance->manufacture_name = string_get_cstr(manufacture_code->name);
@@ -180,13 +175,8 @@ uint8_t subghz_protocol_star_line_check_remote_controller_selector(
                     return 1;
                 }
                 // Check for mirrored man
-                man_rev = 0;
-                man_rev_byte = 0;
-                for(uint8_t i = 0; i < 64; i += 8) {
-                    man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                    man_rev = man_rev | man_rev_byte << (56 - i);
-                }
-                man_normal_learning = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
+                man_normal_learning = subghz_protocol_keeloq_common_normal_learning(
+                    fix, manufacture_code->key_mirrored);
                 decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
                 if((decrypt >> 24 == btn) &&
                    ((((uint16_t)(decrypt >> 16)) & 0x00FF) == end_serial)) {
@@ -2,7 +2,6 @@
 #include <stream_buffer.h>
 
 #include <lib/flipper_file/flipper_file.h>
-#include <lib/flipper_file/file_helper.h>
 
 #define TAG "SubGhzFileEncoderWorker"
 
@@ -19,6 +18,7 @@ struct SubGhzFileEncoderWorker {
     volatile bool worker_stoping;
     bool level;
     int32_t duration;
+    int32_t data[SUBGHZ_FILE_ENCODER_LOAD];
     string_t str_data;
     string_t file_path;
 
@@ -58,34 +58,6 @@ void subghz_file_encoder_worker_add_livel_duration(
     }
 }
 
-bool subghz_file_encoder_worker_data_parse(
-    SubGhzFileEncoderWorker* instance,
-    const char* strStart,
-    size_t len) {
-    char* str1;
-    size_t ind_start = (size_t)strStart; //store the start address of the beginning of the line
-    bool res = false;
-
-    str1 = strstr(
-        strStart, "RAW_Data: "); //looking for the beginning of the desired title in the line
-    if(str1 != NULL) {
-        str1 = strchr(
-            str1,
-            ' '); //if found, shift the pointer by 1 element per line "RAW_Data: -1, 2, -2..."
-        while(
-            strchr(str1, ' ') != NULL &&
-            ((size_t)str1 <
-             (len +
-              ind_start))) { //check that there is still an element in the line and that it has not gone beyond the line
-            str1 = strchr(str1, ' ');
-            str1 += 1; //if found, shift the pointer by next element per line
-            subghz_file_encoder_worker_add_livel_duration(instance, atoi(str1));
-        }
-        res = true;
-    }
-    return res;
-}
-
 LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
     furi_assert(context);
     SubGhzFileEncoderWorker* instance = context;
@@ -121,7 +93,6 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     SubGhzFileEncoderWorker* instance = context;
     FURI_LOG_I(TAG, "Worker start");
     bool res = false;
-    File* file = flipper_file_get_file(instance->flipper_file);
     do {
         if(!flipper_file_open_existing(
                instance->flipper_file, string_get_cstr(instance->file_path))) {
@@ -134,8 +105,6 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
             break;
         }
 
-        //skip the end of the previous line "\n"
-        storage_file_seek(file, 1, false);
         res = true;
         instance->worker_stoping = false;
         FURI_LOG_I(TAG, "Start transmission");
@@ -144,20 +113,18 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     while(res && instance->worker_running) {
         size_t stream_free_byte = xStreamBufferSpacesAvailable(instance->stream);
         if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
-            if(file_helper_read_line(file, instance->str_data)) {
-                //skip the end of the previous line "\n"
-                storage_file_seek(file, 1, false);
-                if(!subghz_file_encoder_worker_data_parse(
-                       instance,
-                       string_get_cstr(instance->str_data),
-                       strlen(string_get_cstr(instance->str_data)))) {
-                    //to stop DMA correctly
-                    subghz_file_encoder_worker_add_livel_duration(instance, LEVEL_DURATION_RESET);
-                    subghz_file_encoder_worker_add_livel_duration(instance, LEVEL_DURATION_RESET);
-
-                    break;
+            uint16_t count = 0;
+            if(flipper_file_read_int32_chunk(
+                   instance->flipper_file,
+                   "RAW_Data",
+                   instance->data,
+                   SUBGHZ_FILE_ENCODER_LOAD,
+                   &count)) {
+                for(uint16_t i = 0; i < count; i++) {
+                    subghz_file_encoder_worker_add_livel_duration(instance, instance->data[i]);
                 }
             } else {
+                //to stop DMA correctly
                 subghz_file_encoder_worker_add_livel_duration(instance, LEVEL_DURATION_RESET);
                 subghz_file_encoder_worker_add_livel_duration(instance, LEVEL_DURATION_RESET);
                 break;
@@ -2,11 +2,14 @@
 
 #include <furi.h>
 #include <furi-hal.h>
+#include <inttypes.h>
 
 #include <storage/storage.h>
 #include <toolbox/hex.h>
 #include <flipper_file/flipper_file.h>
 
+#include "protocols/subghz_protocol_keeloq_common.h"
+
 #define TAG "SubGhzKeystore"
 
 #define FILE_BUFFER_SIZE 64
@@ -26,6 +29,7 @@ typedef enum {
 
 struct SubGhzKeystore {
     SubGhzKeyArray_t data;
+    uint32_t generation;
 };
 
 SubGhzKeystore* subghz_keystore_alloc() {
@@ -58,6 +62,18 @@ static void subghz_keystore_add_key(
     string_init_set_str(manufacture_code->name, name);
     manufacture_code->key = key;
     manufacture_code->type = type;
+
+    manufacture_code->key_mirrored = 0;
+    for(uint8_t i = 0; i < 64; i += 8) {
+        manufacture_code->key_mirrored |= (uint64_t)(uint8_t)(key >> i) << (56 - i);
+    }
+    // Receivers always use zero seed
+    manufacture_code->seed_decrypt = subghz_protocol_keeloq_common_decrypt(0, key);
+    manufacture_code->seed_decrypt_mirrored =
+        subghz_protocol_keeloq_common_decrypt(0, manufacture_code->key_mirrored);
+
+    // Array may have been reallocated
+    instance->generation++;
 }
 
 static bool subghz_keystore_process_line(SubGhzKeystore* instance, char* line) {
@@ -78,11 +94,12 @@ static bool subghz_keystore_process_line(SubGhzKeystore* instance, char* line) {
 
 static void subghz_keystore_mess_with_iv(uint8_t* iv) {
     // Alignment check for `ldrd` instruction
-    furi_assert(((uint32_t)iv) % 4 == 0);
+    furi_assert(((uintptr_t)iv) % 4 == 0);
     // Please do not share decrypted manufacture keys
     // Sharing them will bring some discomfort to legal owners
     // And potential legal action against you
     // While you reading this code think about your own personal responsibility
+#ifdef __arm__
     asm volatile("nani:                    \n"
                  "ldrd  r0, r2, [%0, #0x0] \n"
                  "lsl   r1, r0, #8         \n"
@@ -102,6 +119,10 @@ static void subghz_keystore_mess_with_iv(uint8_t* iv) {
                  :
                  : "r"(iv)
                  : "r0", "r1", "r2", "r3", "memory");
+#else
+    // Host builds have no crypto enclave, so encrypted keystores can't be used anyway
+    (void)iv;
+#endif
 }
 
 static bool subghz_keystore_read_file(SubGhzKeystore* instance, File* file, uint8_t* iv) {
@@ -281,7 +302,7 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8
                 int len = snprintf(
                     decrypted_line,
                     SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE,
-                    "%08lX%08lX:%hu:%s",
+                    "%08" PRIX32 "%08" PRIX32 ":%hu:%s",
                     (uint32_t)(key->key >> 32),
                     (uint32_t)key->key,
                     key->type,
@@ -335,6 +356,11 @@ SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance) {
     return &instance->data;
 }
 
+uint32_t subghz_keystore_get_generation(SubGhzKeystore* instance) {
+    furi_assert(instance);
+    return instance->generation;
+}
+
 bool subghz_keystore_raw_encrypted_save(
     const char* input_file_name,
     const char* output_file_name,
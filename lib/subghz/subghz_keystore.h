@@ -8,6 +8,10 @@ typedef struct {
     string_t name;
     uint64_t key;
     uint16_t type;
+    // Precomputed on load, so receivers don't redo it for every packet
+    uint64_t key_mirrored; // key with byte order reversed
+    uint32_t seed_decrypt; // Secure Learning seed part for key
+    uint32_t seed_decrypt_mirrored; // Secure Learning seed part for key_mirrored
 } SubGhzKey;
 
 ARRAY_DEF(SubGhzKeyArray, SubGhzKey, M_POD_OPLIST)
@@ -49,6 +53,15 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* filename, uint8_
  */
 SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance);
 
+/** Get keystore generation, changes every time keys are added
+ * 
+ * Pointers into keystore data are valid only while generation stays the same
+ * 
+ * @param instance - SubGhzKeystore instance
+ * @return uint32_t generation
+ */
+uint32_t subghz_keystore_get_generation(SubGhzKeystore* instance);
+
 /** Save RAW encrypted to file
  * 
  * @param input_file_name - const char* full path to the input file
@@ -26,41 +26,180 @@
 
 #define SUBGHZ_PARSER_TAG "SubGhzParser"
 
-typedef enum {
-    SubGhzProtocolTypeCame,
-    SubGhzProtocolTypeCameTwee,
-    SubGhzProtocolTypeCameAtomo,
-    SubGhzProtocolTypeKeeloq,
-    SubGhzProtocolTypeNiceFlo,
-    SubGhzProtocolTypeNiceFlorS,
-    SubGhzProtocolTypePrinceton,
-    SubGhzProtocolTypeGateTX,
-    SubGhzProtocolTypeIDo,
-    SubGhzProtocolTypeFaacSLH,
-    SubGhzProtocolTypeNeroSketch,
-    SubGhzProtocolTypeStarLine,
-    SubGhzProtocolTypeNeroRadio,
-    SubGhzProtocolTypeScherKhan,
-    SubGhzProtocolTypeKIA,
-    SubGhzProtocolTypeRAW,
-    SubGhzProtocolTypeHormann,
-
-    SubGhzProtocolTypeMax,
-} SubGhzProtocolType;
+typedef void* (*SubGhzParserProtocolAlloc)(void);
+typedef void* (*SubGhzParserProtocolAllocKeystore)(SubGhzKeystore* keystore);
+typedef void (*SubGhzParserProtocolFree)(void* instance);
+typedef void (*SubGhzParserProtocolReset)(void* instance);
+typedef void (*SubGhzParserProtocolParse)(void* instance, bool level, uint32_t duration);
+
+typedef struct {
+    SubGhzParserProtocolAlloc alloc;
+    // Used instead of alloc by protocols which need manufacture keys
+    SubGhzParserProtocolAllocKeystore alloc_keystore;
+    SubGhzParserProtocolFree free;
+    SubGhzParserProtocolReset reset;
+    SubGhzParserProtocolParse parse;
+} SubGhzParserProtocol;
+
+static const SubGhzParserProtocol subghz_parser_protocols[SubGhzProtocolTypeMax] = {
+    [SubGhzProtocolTypeCame] =
+        {
+            .alloc = (SubGhzParserProtocolAlloc)subghz_protocol_came_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_protocol_came_free,
+            .reset = (SubGhzParserProtocolReset)subghz_protocol_came_reset,
+            .parse = (SubGhzParserProtocolParse)subghz_protocol_came_parse,
+        },
+    [SubGhzProtocolTypeCameTwee] =
+        {
+            .alloc = (SubGhzParserProtocolAlloc)subghz_protocol_came_twee_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_protocol_came_twee_free,
+            .reset = (SubGhzParserProtocolReset)subghz_protocol_came_twee_reset,
+            .parse = (SubGhzParserProtocolParse)subghz_protocol_came_twee_parse,
+        },
+    [SubGhzProtocolTypeCameAtomo] =
+        {
+            .alloc = (SubGhzParserProtocolAlloc)subghz_protocol_came_atomo_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_protocol_came_atomo_free,
+            .reset = (SubGhzParserProtocolReset)subghz_protocol_came_atomo_reset,
+            .parse = (SubGhzParserProtocolParse)subghz_protocol_came_atomo_parse,
+        },
+    [SubGhzProtocolTypeKeeloq] =
+        {
+            .alloc_keystore = (SubGhzParserProtocolAllocKeystore)subghz_protocol_keeloq_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_protocol_keeloq_free,
+            .reset = (SubGhzParserProtocolReset)subghz_protocol_keeloq_reset,
+            .parse = (SubGhzParserProtocolParse)subghz_protocol_keeloq_parse,
+        },
+    [SubGhzProtocolTypePrinceton] =
+        {
+            .alloc = (SubGhzParserProtocolAlloc)subghz_decoder_princeton_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_decoder_princeton_free,
+            .reset = (SubGhzParserProtocolReset)subghz_decoder_princeton_reset,
+            .parse = (SubGhzParserProtocolParse)subghz_decoder_princeton_parse,
+        },
+    [SubGhzProtocolTypeNiceFlo] =
+        {
+            .alloc = (SubGhzParserProtocolAlloc)subghz_protocol_nice_flo_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_protocol_nice_flo_free,
+            .reset = (SubGhzParserProtocolReset)subghz_protocol_nice_flo_reset,
+            .parse = (SubGhzParserProtocolParse)subghz_protocol_nice_flo_parse,
+        },
+    [SubGhzProtocolTypeNiceFlorS] =
+        {
+            .alloc = (SubGhzParserProtocolAlloc)subghz_protocol_nice_flor_s_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_protocol_nice_flor_s_free,
+            .reset = (SubGhzParserProtocolReset)subghz_protocol_nice_flor_s_reset,
+            .parse = (SubGhzParserProtocolParse)subghz_protocol_nice_flor_s_parse,
+        },
+    [SubGhzProtocolTypeGateTX] =
+        {
+            .alloc = (SubGhzParserProtocolAlloc)subghz_protocol_gate_tx_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_protocol_gate_tx_free,
+            .reset = (SubGhzParserProtocolReset)subghz_protocol_gate_tx_reset,
+            .parse = (SubGhzParserProtocolParse)subghz_protocol_gate_tx_parse,
+        },
+    [SubGhzProtocolTypeIDo] =
+        {
+            .alloc = (SubGhzParserProtocolAlloc)subghz_protocol_ido_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_protocol_ido_free,
+            .reset = (SubGhzParserProtocolReset)subghz_protocol_ido_reset,
+            .parse = (SubGhzParserProtocolParse)subghz_protocol_ido_parse,
+        },
+    [SubGhzProtocolTypeFaacSLH] =
+        {
+            .alloc = (SubGhzParserProtocolAlloc)subghz_protocol_faac_slh_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_protocol_faac_slh_free,
+            .reset = (SubGhzParserProtocolReset)subghz_protocol_faac_slh_reset,
+            .parse = (SubGhzParserProtocolParse)subghz_protocol_faac_slh_parse,
+        },
+    [SubGhzProtocolTypeNeroSketch] =
+        {
+            .alloc = (SubGhzParserProtocolAlloc)subghz_protocol_nero_sketch_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_protocol_nero_sketch_free,
+            .reset = (SubGhzParserProtocolReset)subghz_protocol_nero_sketch_reset,
+            .parse = (SubGhzParserProtocolParse)subghz_protocol_nero_sketch_parse,
+        },
+    [SubGhzProtocolTypeStarLine] =
+        {
+            .alloc_keystore = (SubGhzParserProtocolAllocKeystore)subghz_protocol_star_line_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_protocol_star_line_free,
+            .reset = (SubGhzParserProtocolReset)subghz_protocol_star_line_reset,
+            .parse = (SubGhzParserProtocolParse)subghz_protocol_star_line_parse,
+        },
+    [SubGhzProtocolTypeNeroRadio] =
+        {
+            .alloc = (SubGhzParserProtocolAlloc)subghz_protocol_nero_radio_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_protocol_nero_radio_free,
+            .reset = (SubGhzParserProtocolReset)subghz_protocol_nero_radio_reset,
+            .parse = (SubGhzParserProtocolParse)subghz_protocol_nero_radio_parse,
+        },
+    [SubGhzProtocolTypeScherKhan] =
+        {
+            .alloc = (SubGhzParserProtocolAlloc)subghz_protocol_scher_khan_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_protocol_scher_khan_free,
+            .reset = (SubGhzParserProtocolReset)subghz_protocol_scher_khan_reset,
+            .parse = (SubGhzParserProtocolParse)subghz_protocol_scher_khan_parse,
+        },
+    [SubGhzProtocolTypeKIA] =
+        {
+            .alloc = (SubGhzParserProtocolAlloc)subghz_protocol_kia_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_protocol_kia_free,
+            .reset = (SubGhzParserProtocolReset)subghz_protocol_kia_reset,
+            .parse = (SubGhzParserProtocolParse)subghz_protocol_kia_parse,
+        },
+    [SubGhzProtocolTypeRAW] =
+        {
+            .alloc = (SubGhzParserProtocolAlloc)subghz_protocol_raw_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_protocol_raw_free,
+            .reset = (SubGhzParserProtocolReset)subghz_protocol_raw_reset,
+            // RAW is fed by subghz_parser_raw_parse only
+            .parse = NULL,
+        },
+    [SubGhzProtocolTypeHormann] =
+        {
+            .alloc = (SubGhzParserProtocolAlloc)subghz_protocol_hormann_alloc,
+            .free = (SubGhzParserProtocolFree)subghz_protocol_hormann_free,
+            .reset = (SubGhzParserProtocolReset)subghz_protocol_hormann_reset,
+            .parse = (SubGhzParserProtocolParse)subghz_protocol_hormann_parse,
+        },
+};
+
+typedef struct {
+    SubGhzParserProtocolParse parse;
+    SubGhzProtocolCommon* protocol;
+} SubGhzParserActiveProtocol;
 
 struct SubGhzParser {
     SubGhzKeystore* keystore;
 
     SubGhzProtocolCommon* protocols[SubGhzProtocolTypeMax];
 
+    uint32_t protocol_mask;
+    // Enabled protocols which are fed on every edge
+    SubGhzParserActiveProtocol active[SubGhzProtocolTypeMax];
+    size_t active_count;
+
     SubGhzProtocolTextCallback text_callback;
     void* text_callback_context;
     SubGhzProtocolCommonCallbackDump parser_callback;
     void* parser_callback_context;
+
+    FuriStatsGroup* stats;
+    FuriStatsCounter* stats_hits[SubGhzProtocolTypeMax];
 };
 
+static void subghz_parser_stats_hit(SubGhzParser* instance, SubGhzProtocolCommon* parser) {
+    for(size_t i = 0; i < SubGhzProtocolTypeMax; i++) {
+        if(instance->protocols[i] == parser) {
+            furi_stats_counter_add(instance->stats_hits[i], 1);
+            break;
+        }
+    }
+}
+
 static void subghz_parser_text_rx_callback(SubGhzProtocolCommon* parser, void* context) {
     SubGhzParser* instance = context;
+    subghz_parser_stats_hit(instance, parser);
 
     string_t output;
     string_init(output);
@@ -75,6 +214,7 @@ static void subghz_parser_text_rx_callback(SubGhzProtocolCommon* parser, void* c
 
 static void subghz_parser_parser_rx_callback(SubGhzProtocolCommon* parser, void* context) {
     SubGhzParser* instance = context;
+    subghz_parser_stats_hit(instance, parser);
     if(instance->parser_callback) {
         instance->parser_callback(parser, instance->parser_callback_context);
     }
@@ -85,40 +225,22 @@ SubGhzParser* subghz_parser_alloc() {
 
     instance->keystore = subghz_keystore_alloc();
 
-    instance->protocols[SubGhzProtocolTypeCame] =
-        (SubGhzProtocolCommon*)subghz_protocol_came_alloc();
-    instance->protocols[SubGhzProtocolTypeCameTwee] =
-        (SubGhzProtocolCommon*)subghz_protocol_came_twee_alloc();
-    instance->protocols[SubGhzProtocolTypeCameAtomo] =
-        (SubGhzProtocolCommon*)subghz_protocol_came_atomo_alloc();
-    instance->protocols[SubGhzProtocolTypeKeeloq] =
-        (SubGhzProtocolCommon*)subghz_protocol_keeloq_alloc(instance->keystore);
-    instance->protocols[SubGhzProtocolTypePrinceton] =
-        (SubGhzProtocolCommon*)subghz_decoder_princeton_alloc();
-    instance->protocols[SubGhzProtocolTypeNiceFlo] =
-        (SubGhzProtocolCommon*)subghz_protocol_nice_flo_alloc();
-    instance->protocols[SubGhzProtocolTypeNiceFlorS] =
-        (SubGhzProtocolCommon*)subghz_protocol_nice_flor_s_alloc();
-    instance->protocols[SubGhzProtocolTypeGateTX] =
-        (SubGhzProtocolCommon*)subghz_protocol_gate_tx_alloc();
-    instance->protocols[SubGhzProtocolTypeIDo] =
-        (SubGhzProtocolCommon*)subghz_protocol_ido_alloc();
-    instance->protocols[SubGhzProtocolTypeFaacSLH] =
-        (SubGhzProtocolCommon*)subghz_protocol_faac_slh_alloc();
-    instance->protocols[SubGhzProtocolTypeNeroSketch] =
-        (SubGhzProtocolCommon*)subghz_protocol_nero_sketch_alloc();
-    instance->protocols[SubGhzProtocolTypeStarLine] =
-        (SubGhzProtocolCommon*)subghz_protocol_star_line_alloc(instance->keystore);
-    instance->protocols[SubGhzProtocolTypeNeroRadio] =
-        (SubGhzProtocolCommon*)subghz_protocol_nero_radio_alloc();
-    instance->protocols[SubGhzProtocolTypeScherKhan] =
-        (SubGhzProtocolCommon*)subghz_protocol_scher_khan_alloc();
-    instance->protocols[SubGhzProtocolTypeKIA] =
-        (SubGhzProtocolCommon*)subghz_protocol_kia_alloc();
-    instance->protocols[SubGhzProtocolTypeRAW] =
-        (SubGhzProtocolCommon*)subghz_protocol_raw_alloc();
-    instance->protocols[SubGhzProtocolTypeHormann] =
-        (SubGhzProtocolCommon*)subghz_protocol_hormann_alloc();
+    for(size_t i = 0; i < SubGhzProtocolTypeMax; i++) {
+        const SubGhzParserProtocol* protocol = &subghz_parser_protocols[i];
+        if(protocol->alloc_keystore) {
+            instance->protocols[i] = protocol->alloc_keystore(instance->keystore);
+        } else {
+            instance->protocols[i] = protocol->alloc();
+        }
+    }
+
+    instance->stats = furi_stats_group_alloc("subghz_parser");
+    for(size_t i = 0; i < SubGhzProtocolTypeMax; i++) {
+        instance->stats_hits[i] =
+            furi_stats_counter_alloc(instance->stats, instance->protocols[i]->name);
+    }
+
+    subghz_parser_set_protocol_mask(instance, SUBGHZ_PARSER_PROTOCOL_MASK_ALL);
 
     return instance;
 }
@@ -126,36 +248,10 @@ SubGhzParser* subghz_parser_alloc() {
 void subghz_parser_free(SubGhzParser* instance) {
     furi_assert(instance);
 
-    subghz_protocol_came_free((SubGhzProtocolCame*)instance->protocols[SubGhzProtocolTypeCame]);
-    subghz_protocol_came_twee_free(
-        (SubGhzProtocolCameTwee*)instance->protocols[SubGhzProtocolTypeCameTwee]);
-    subghz_protocol_came_atomo_free(
-        (SubGhzProtocolCameAtomo*)instance->protocols[SubGhzProtocolTypeCameAtomo]);
-    subghz_protocol_keeloq_free(
-        (SubGhzProtocolKeeloq*)instance->protocols[SubGhzProtocolTypeKeeloq]);
-    subghz_decoder_princeton_free(
-        (SubGhzDecoderPrinceton*)instance->protocols[SubGhzProtocolTypePrinceton]);
-    subghz_protocol_nice_flo_free(
-        (SubGhzProtocolNiceFlo*)instance->protocols[SubGhzProtocolTypeNiceFlo]);
-    subghz_protocol_nice_flor_s_free(
-        (SubGhzProtocolNiceFlorS*)instance->protocols[SubGhzProtocolTypeNiceFlorS]);
-    subghz_protocol_gate_tx_free(
-        (SubGhzProtocolGateTX*)instance->protocols[SubGhzProtocolTypeGateTX]);
-    subghz_protocol_ido_free((SubGhzProtocolIDo*)instance->protocols[SubGhzProtocolTypeIDo]);
-    subghz_protocol_faac_slh_free(
-        (SubGhzProtocolFaacSLH*)instance->protocols[SubGhzProtocolTypeFaacSLH]);
-    subghz_protocol_nero_sketch_free(
-        (SubGhzProtocolNeroSketch*)instance->protocols[SubGhzProtocolTypeNeroSketch]);
-    subghz_protocol_star_line_free(
-        (SubGhzProtocolStarLine*)instance->protocols[SubGhzProtocolTypeStarLine]);
-    subghz_protocol_nero_radio_free(
-        (SubGhzProtocolNeroRadio*)instance->protocols[SubGhzProtocolTypeNeroRadio]);
-    subghz_protocol_scher_khan_free(
-        (SubGhzProtocolScherKhan*)instance->protocols[SubGhzProtocolTypeScherKhan]);
-    subghz_protocol_kia_free((SubGhzProtocolKIA*)instance->protocols[SubGhzProtocolTypeKIA]);
-    subghz_protocol_raw_free((SubGhzProtocolRAW*)instance->protocols[SubGhzProtocolTypeRAW]);
-    subghz_protocol_hormann_free(
-        (SubGhzProtocolHormann*)instance->protocols[SubGhzProtocolTypeHormann]);
+    furi_stats_group_free(instance->stats);
+    for(size_t i = 0; i < SubGhzProtocolTypeMax; i++) {
+        subghz_parser_protocols[i].free(instance->protocols[i]);
+    }
 
     subghz_keystore_free(instance->keystore);
 
@@ -224,36 +320,34 @@ void subghz_parser_load_keeloq_file(SubGhzParser* instance, const char* file_nam
 }
 
 void subghz_parser_reset(SubGhzParser* instance) {
-    subghz_protocol_came_reset((SubGhzProtocolCame*)instance->protocols[SubGhzProtocolTypeCame]);
-    subghz_protocol_came_twee_reset(
-        (SubGhzProtocolCameTwee*)instance->protocols[SubGhzProtocolTypeCameTwee]);
-    subghz_protocol_came_atomo_reset(
-        (SubGhzProtocolCameAtomo*)instance->protocols[SubGhzProtocolTypeCameAtomo]);
-    subghz_protocol_keeloq_reset(
-        (SubGhzProtocolKeeloq*)instance->protocols[SubGhzProtocolTypeKeeloq]);
-    subghz_decoder_princeton_reset(
-        (SubGhzDecoderPrinceton*)instance->protocols[SubGhzProtocolTypePrinceton]);
-    subghz_protocol_nice_flo_reset(
-        (SubGhzProtocolNiceFlo*)instance->protocols[SubGhzProtocolTypeNiceFlo]);
-    subghz_protocol_nice_flor_s_reset(
-        (SubGhzProtocolNiceFlorS*)instance->protocols[SubGhzProtocolTypeNiceFlorS]);
-    subghz_protocol_gate_tx_reset(
-        (SubGhzProtocolGateTX*)instance->protocols[SubGhzProtocolTypeGateTX]);
-    subghz_protocol_ido_reset((SubGhzProtocolIDo*)instance->protocols[SubGhzProtocolTypeIDo]);
-    subghz_protocol_faac_slh_reset(
-        (SubGhzProtocolFaacSLH*)instance->protocols[SubGhzProtocolTypeFaacSLH]);
-    subghz_protocol_nero_sketch_reset(
-        (SubGhzProtocolNeroSketch*)instance->protocols[SubGhzProtocolTypeNeroSketch]);
-    subghz_protocol_star_line_reset(
-        (SubGhzProtocolStarLine*)instance->protocols[SubGhzProtocolTypeStarLine]);
-    subghz_protocol_nero_radio_reset(
-        (SubGhzProtocolNeroRadio*)instance->protocols[SubGhzProtocolTypeNeroRadio]);
-    subghz_protocol_scher_khan_reset(
-        (SubGhzProtocolScherKhan*)instance->protocols[SubGhzProtocolTypeScherKhan]);
-    subghz_protocol_kia_reset((SubGhzProtocolKIA*)instance->protocols[SubGhzProtocolTypeKIA]);
-    subghz_protocol_raw_reset((SubGhzProtocolRAW*)instance->protocols[SubGhzProtocolTypeRAW]);
-    subghz_protocol_hormann_reset(
-        (SubGhzProtocolHormann*)instance->protocols[SubGhzProtocolTypeHormann]);
+    for(size_t i = 0; i < SubGhzProtocolTypeMax; i++) {
+        subghz_parser_protocols[i].reset(instance->protocols[i]);
+    }
+}
+
+void subghz_parser_set_protocol_mask(SubGhzParser* instance, uint32_t mask) {
+    furi_assert(instance);
+
+    instance->active_count = 0;
+    for(size_t i = 0; i < SubGhzProtocolTypeMax; i++) {
+        if(!(mask & SUBGHZ_PARSER_PROTOCOL_MASK(i))) continue;
+
+        // Protocol missed edges while disabled, start it from scratch
+        if(!(instance->protocol_mask & SUBGHZ_PARSER_PROTOCOL_MASK(i))) {
+            subghz_parser_protocols[i].reset(instance->protocols[i]);
+        }
+        if(subghz_parser_protocols[i].parse) {
+            instance->active[instance->active_count].parse = subghz_parser_protocols[i].parse;
+            instance->active[instance->active_count].protocol = instance->protocols[i];
+            instance->active_count++;
+        }
+    }
+    instance->protocol_mask = mask & SUBGHZ_PARSER_PROTOCOL_MASK_ALL;
+}
+
+uint32_t subghz_parser_get_protocol_mask(SubGhzParser* instance) {
+    furi_assert(instance);
+    return instance->protocol_mask;
 }
 
 void subghz_parser_raw_parse(SubGhzParser* instance, bool level, uint32_t duration) {
@@ -262,48 +356,7 @@ void subghz_parser_raw_parse(SubGhzParser* instance, bool level, uint32_t durati
 }
 
 void subghz_parser_parse(SubGhzParser* instance, bool level, uint32_t duration) {
-    subghz_protocol_came_parse(
-        (SubGhzProtocolCame*)instance->protocols[SubGhzProtocolTypeCame], level, duration);
-    subghz_protocol_came_twee_parse(
-        (SubGhzProtocolCameTwee*)instance->protocols[SubGhzProtocolTypeCameTwee], level, duration);
-    subghz_protocol_came_atomo_parse(
-        (SubGhzProtocolCameAtomo*)instance->protocols[SubGhzProtocolTypeCameAtomo],
-        level,
-        duration);
-    subghz_protocol_keeloq_parse(
-        (SubGhzProtocolKeeloq*)instance->protocols[SubGhzProtocolTypeKeeloq], level, duration);
-    subghz_decoder_princeton_parse(
-        (SubGhzDecoderPrinceton*)instance->protocols[SubGhzProtocolTypePrinceton],
-        level,
-        duration);
-    subghz_protocol_nice_flo_parse(
-        (SubGhzProtocolNiceFlo*)instance->protocols[SubGhzProtocolTypeNiceFlo], level, duration);
-    subghz_protocol_nice_flor_s_parse(
-        (SubGhzProtocolNiceFlorS*)instance->protocols[SubGhzProtocolTypeNiceFlorS],
-        level,
-        duration);
-    subghz_protocol_gate_tx_parse(
-        (SubGhzProtocolGateTX*)instance->protocols[SubGhzProtocolTypeGateTX], level, duration);
-    subghz_protocol_ido_parse(
-        (SubGhzProtocolIDo*)instance->protocols[SubGhzProtocolTypeIDo], level, duration);
-    subghz_protocol_faac_slh_parse(
-        (SubGhzProtocolFaacSLH*)instance->protocols[SubGhzProtocolTypeFaacSLH], level, duration);
-    subghz_protocol_nero_sketch_parse(
-        (SubGhzProtocolNeroSketch*)instance->protocols[SubGhzProtocolTypeNeroSketch],
-        level,
-        duration);
-    subghz_protocol_star_line_parse(
-        (SubGhzProtocolStarLine*)instance->protocols[SubGhzProtocolTypeStarLine], level, duration);
-    subghz_protocol_nero_radio_parse(
-        (SubGhzProtocolNeroRadio*)instance->protocols[SubGhzProtocolTypeNeroRadio],
-        level,
-        duration);
-    subghz_protocol_scher_khan_parse(
-        (SubGhzProtocolScherKhan*)instance->protocols[SubGhzProtocolTypeScherKhan],
-        level,
-        duration);
-    subghz_protocol_kia_parse(
-        (SubGhzProtocolKIA*)instance->protocols[SubGhzProtocolTypeKIA], level, duration);
-    subghz_protocol_hormann_parse(
-        (SubGhzProtocolHormann*)instance->protocols[SubGhzProtocolTypeHormann], level, duration);
+    for(size_t i = 0; i < instance->active_count; i++) {
+        instance->active[i].parse(instance->active[i].protocol, level, duration);
+    }
 }
@@ -7,6 +7,32 @@ typedef void (*SubGhzProtocolCommonCallbackDump)(SubGhzProtocolCommon* parser, v
 
 typedef struct SubGhzParser SubGhzParser;
 
+/** Protocols are fed with edges in this order */
+typedef enum {
+    SubGhzProtocolTypeCame,
+    SubGhzProtocolTypeCameTwee,
+    SubGhzProtocolTypeCameAtomo,
+    SubGhzProtocolTypeKeeloq,
+    SubGhzProtocolTypePrinceton,
+    SubGhzProtocolTypeNiceFlo,
+    SubGhzProtocolTypeNiceFlorS,
+    SubGhzProtocolTypeGateTX,
+    SubGhzProtocolTypeIDo,
+    SubGhzProtocolTypeFaacSLH,
+    SubGhzProtocolTypeNeroSketch,
+    SubGhzProtocolTypeStarLine,
+    SubGhzProtocolTypeNeroRadio,
+    SubGhzProtocolTypeScherKhan,
+    SubGhzProtocolTypeKIA,
+    SubGhzProtocolTypeRAW,
+    SubGhzProtocolTypeHormann,
+
+    SubGhzProtocolTypeMax,
+} SubGhzProtocolType;
+
+#define SUBGHZ_PARSER_PROTOCOL_MASK(type) (1UL << (type))
+#define SUBGHZ_PARSER_PROTOCOL_MASK_ALL ((1UL << SubGhzProtocolTypeMax) - 1)
+
 /** Allocate SubGhzParser
  * 
  * @return SubGhzParser* 
@@ -76,9 +102,23 @@ void subghz_parser_load_keeloq_file(SubGhzParser* instance, const char* file_nam
  */
 void subghz_parser_reset(SubGhzParser* instance);
 
+/** Select protocols fed by subghz_parser_parse
+ * 
+ * @param instance - SubGhzParser instance
+ * @param mask - SUBGHZ_PARSER_PROTOCOL_MASK of enabled protocols, all are enabled after alloc
+ */
+void subghz_parser_set_protocol_mask(SubGhzParser* instance, uint32_t mask);
+
+/** Get enabled protocols
+ * 
+ * @param instance - SubGhzParser instance
+ * @return SUBGHZ_PARSER_PROTOCOL_MASK of enabled protocols
+ */
+uint32_t subghz_parser_get_protocol_mask(SubGhzParser* instance);
+
 void subghz_parser_raw_parse(SubGhzParser* instance, bool level, uint32_t duration);
 
-/** Loading data into all parsers
+/** Loading data into enabled parsers
  * 
  * @param instance - SubGhzParser instance
  * @param level - true is high, false if low
@@ -19,6 +19,12 @@ struct SubGhzWorker {
     SubGhzWorkerOverrunCallback overrun_callback;
     SubGhzWorkerPairCallback pair_callback;
     void* context;
+
+    FuriStatsGroup* stats;
+    FuriStatsCounter* stats_edges;
+    FuriStatsCounter* stats_overruns;
+    FuriStatsCounter* stats_stream_max;
+    FuriStatsHistogram* stats_pair_latency;
 };
 
 /** Rx callback timer
@@ -32,13 +38,19 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
 
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     LevelDuration level_duration = level_duration_make(level, duration);
-    if(instance->overrun) {
+    furi_stats_counter_add(instance->stats_edges, 1);
+    // Overrun lasts until reset marker gets into the stream
+    bool overrun = instance->overrun;
+    if(overrun) {
         instance->overrun = false;
         level_duration = level_duration_reset();
     }
     size_t ret = xStreamBufferSendFromISR(
         instance->stream, &level_duration, sizeof(LevelDuration), &xHigherPriorityTaskWoken);
-    if(sizeof(LevelDuration) != ret) instance->overrun = true;
+    if(sizeof(LevelDuration) != ret) {
+        if(!overrun) furi_stats_counter_add(instance->stats_overruns, 1);
+        instance->overrun = true;
+    }
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
@@ -55,8 +67,11 @@ static int32_t subghz_worker_thread_callback(void* context) {
         int ret =
             xStreamBufferReceive(instance->stream, &level_duration, sizeof(LevelDuration), 10);
         if(ret == sizeof(LevelDuration)) {
+            furi_stats_counter_max(
+                instance->stats_stream_max,
+                xStreamBufferBytesAvailable(instance->stream) / sizeof(LevelDuration) + 1);
             if(level_duration_is_reset(level_duration)) {
-                FURI_LOG_E(TAG, "Overrun buffer");;
+                FURI_LOG_E(TAG, "Overrun buffer");
                 if(instance->overrun_callback) instance->overrun_callback(instance->context);
             } else {
                 bool level = level_duration_get_level(level_duration);
@@ -68,18 +83,22 @@ static int32_t subghz_worker_thread_callback(void* context) {
                         instance->filter_level_duration.duration += duration;
 
                     } else if(instance->filter_level_duration.level != level) {
-                        if(instance->pair_callback)
+                        if(instance->pair_callback) {
+                            uint32_t start = furi_stats_timer_start();
                             instance->pair_callback(
                                 instance->context,
                                 instance->filter_level_duration.level,
                                 instance->filter_level_duration.duration);
+                            furi_stats_timer_stop(instance->stats_pair_latency, start);
+                        }
 
                         instance->filter_level_duration.duration = duration;
                         instance->filter_level_duration.level = level;
                     }
-                } else {
-                    if(instance->pair_callback)
-                        instance->pair_callback(instance->context, level, duration);
+                } else if(instance->pair_callback) {
+                    uint32_t start = furi_stats_timer_start();
+                    instance->pair_callback(instance->context, level, duration);
+                    furi_stats_timer_stop(instance->stats_pair_latency, start);
                 }
             }
         }
@@ -103,12 +122,20 @@ SubGhzWorker* subghz_worker_alloc() {
     instance->filter_running = true;
     instance->filter_duration = 20;
 
+    instance->stats = furi_stats_group_alloc("subghz_worker");
+    instance->stats_edges = furi_stats_counter_alloc(instance->stats, "edges");
+    instance->stats_overruns = furi_stats_counter_alloc(instance->stats, "overruns");
+    instance->stats_stream_max = furi_stats_counter_alloc(instance->stats, "stream_max");
+    instance->stats_pair_latency =
+        furi_stats_histogram_alloc(instance->stats, "pair_latency", "us");
+
     return instance;
 }
 
 void subghz_worker_free(SubGhzWorker* instance) {
     furi_assert(instance);
 
+    furi_stats_group_free(instance->stats);
     vStreamBufferDelete(instance->stream);
     furi_thread_free(instance->thread);
 
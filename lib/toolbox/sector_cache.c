@@ -0,0 +1,216 @@
+#include "sector_cache.h"
+
+#include <furi.h>
+
+typedef struct {
+    uint32_t sector;
+    uint32_t last_used;
+    bool valid;
+    bool dirty;
+} SectorCacheItem;
+
+struct SectorCache {
+    size_t count;
+    size_t sector_size;
+    SectorCacheItem* items;
+    uint8_t* data;
+    uint32_t tick;
+
+    SectorCacheReadCallback read;
+    SectorCacheWriteCallback write;
+    void* context;
+
+    SectorCacheStats stats;
+};
+
+static inline uint8_t* sector_cache_item_data(SectorCache* cache, size_t index) {
+    return &cache->data[index * cache->sector_size];
+}
+
+static SectorCacheItem* sector_cache_find(SectorCache* cache, uint32_t sector) {
+    for(size_t i = 0; i < cache->count; i++) {
+        if(cache->items[i].valid && cache->items[i].sector == sector) return &cache->items[i];
+    }
+    return NULL;
+}
+
+/** Writes back dirty run that starts at the index, slots next to each other go in one request */
+static bool sector_cache_write_back(SectorCache* cache, size_t index) {
+    size_t count = 1;
+    while(index + count < cache->count) {
+        SectorCacheItem* next = &cache->items[index + count];
+        if(!next->valid || !next->dirty || next->sector != cache->items[index].sector + count)
+            break;
+        count++;
+    }
+
+    if(!cache->write(
+           cache->context,
+           sector_cache_item_data(cache, index),
+           cache->items[index].sector,
+           count)) {
+        return false;
+    }
+
+    for(size_t i = index; i < index + count; i++) cache->items[i].dirty = false;
+    cache->stats.write_backs += count;
+    return true;
+}
+
+/** Free or least recently used slot, evicted sector is written back if dirty */
+static SectorCacheItem* sector_cache_slot(SectorCache* cache) {
+    size_t lru = 0;
+    for(size_t i = 0; i < cache->count; i++) {
+        if(!cache->items[i].valid) {
+            lru = i;
+            break;
+        }
+        if(cache->items[i].last_used < cache->items[lru].last_used) lru = i;
+    }
+
+    SectorCacheItem* item = &cache->items[lru];
+    if(item->valid && item->dirty && !sector_cache_write_back(cache, lru)) return NULL;
+    item->valid = false;
+    return item;
+}
+
+SectorCache* sector_cache_alloc(
+    size_t sectors,
+    size_t sector_size,
+    SectorCacheReadCallback read,
+    SectorCacheWriteCallback write,
+    void* context) {
+    furi_assert(sectors);
+    furi_assert(sector_size);
+    furi_assert(read);
+    furi_assert(write);
+
+    SectorCache* cache = furi_alloc(sizeof(SectorCache));
+    cache->count = sectors;
+    cache->sector_size = sector_size;
+    cache->items = furi_alloc(sizeof(SectorCacheItem) * sectors);
+    cache->data = furi_alloc(sector_size * sectors);
+    cache->read = read;
+    cache->write = write;
+    cache->context = context;
+    cache->stats.sectors = sectors;
+    return cache;
+}
+
+void sector_cache_free(SectorCache* cache) {
+    furi_assert(cache);
+    free(cache->data);
+    free(cache->items);
+    free(cache);
+}
+
+bool sector_cache_read(SectorCache* cache, uint8_t* data, uint32_t sector, uint32_t count) {
+    furi_assert(cache);
+    furi_assert(data);
+
+    if(count > 1) {
+        if(!cache->read(cache->context, data, sector, count)) return false;
+        // Cached copy is the newest one
+        for(size_t i = 0; i < cache->count; i++) {
+            SectorCacheItem* item = &cache->items[i];
+            if(item->valid && item->sector >= sector && item->sector - sector < count) {
+                memcpy(
+                    &data[(item->sector - sector) * cache->sector_size],
+                    sector_cache_item_data(cache, i),
+                    cache->sector_size);
+            }
+        }
+        cache->stats.bypassed += count;
+        return true;
+    }
+
+    cache->stats.reads++;
+    SectorCacheItem* item = sector_cache_find(cache, sector);
+    if(item) {
+        cache->stats.read_hits++;
+    } else {
+        item = sector_cache_slot(cache);
+        if(!item) return false;
+        if(!cache->read(
+               cache->context, sector_cache_item_data(cache, item - cache->items), sector, 1)) {
+            return false;
+        }
+        item->sector = sector;
+        item->valid = true;
+        item->dirty = false;
+    }
+
+    item->last_used = ++cache->tick;
+    memcpy(data, sector_cache_item_data(cache, item - cache->items), cache->sector_size);
+    return true;
+}
+
+bool sector_cache_write(SectorCache* cache, const uint8_t* data, uint32_t sector, uint32_t count) {
+    furi_assert(cache);
+    furi_assert(data);
+
+    if(count > 1) {
+        if(!cache->write(cache->context, data, sector, count)) return false;
+        // Disk has the newest data now, keep cached copies in sync
+        for(size_t i = 0; i < cache->count; i++) {
+            SectorCacheItem* item = &cache->items[i];
+            if(item->valid && item->sector >= sector && item->sector - sector < count) {
+                memcpy(
+                    sector_cache_item_data(cache, i),
+                    &data[(item->sector - sector) * cache->sector_size],
+                    cache->sector_size);
+                item->dirty = false;
+            }
+        }
+        cache->stats.bypassed += count;
+        return true;
+    }
+
+    cache->stats.writes++;
+    SectorCacheItem* item = sector_cache_find(cache, sector);
+    if(item) {
+        if(item->dirty) cache->stats.writes_merged++;
+    } else {
+        item = sector_cache_slot(cache);
+        if(!item) return false;
+        item->sector = sector;
+        item->valid = true;
+    }
+
+    item->dirty = true;
+    item->last_used = ++cache->tick;
+    memcpy(sector_cache_item_data(cache, item - cache->items), data, cache->sector_size);
+    return true;
+}
+
+bool sector_cache_flush(SectorCache* cache) {
+    furi_assert(cache);
+
+    while(true) {
+        // Lowest dirty sector first, so card sees ascending addresses
+        size_t first = cache->count;
+        for(size_t i = 0; i < cache->count; i++) {
+            SectorCacheItem* item = &cache->items[i];
+            if(item->valid && item->dirty &&
+               (first == cache->count || item->sector < cache->items[first].sector)) {
+                first = i;
+            }
+        }
+        if(first == cache->count) return true;
+        if(!sector_cache_write_back(cache, first)) return false;
+    }
+}
+
+void sector_cache_invalidate(SectorCache* cache) {
+    furi_assert(cache);
+    for(size_t i = 0; i < cache->count; i++) {
+        cache->items[i].valid = false;
+        cache->items[i].dirty = false;
+    }
+}
+
+void sector_cache_get_stats(SectorCache* cache, SectorCacheStats* stats) {
+    furi_assert(cache);
+    furi_assert(stats);
+    *stats = cache->stats;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** LRU cache of disk sectors with write-back
+ *
+ * Single sector requests (FAT, directories, small file reads) go through the cache,
+ * writes stay in it until flush or eviction. Multi sector requests are file data
+ * runs, they go to the disk directly, so they don't evict metadata.
+ * Not thread safe, expected to be used from the thread that owns the disk.
+ */
+typedef struct SectorCache SectorCache;
+
+/** Disk read, returns true on success */
+typedef bool (
+    *SectorCacheReadCallback)(void* context, uint8_t* data, uint32_t sector, uint32_t count);
+
+/** Disk write, returns true on success */
+typedef bool (*SectorCacheWriteCallback)(
+    void* context,
+    const uint8_t* data,
+    uint32_t sector,
+    uint32_t count);
+
+typedef struct {
+    uint32_t sectors; /**< Cache capacity */
+    uint32_t reads; /**< Single sector reads */
+    uint32_t read_hits; /**< Single sector reads served from cache */
+    uint32_t writes; /**< Single sector writes */
+    uint32_t writes_merged; /**< Writes to already dirty sector, one disk write saved */
+    uint32_t write_backs; /**< Sectors written to disk on flush or eviction */
+    uint32_t bypassed; /**< Sectors of multi sector requests */
+} SectorCacheStats;
+
+/** Allocate cache
+ *
+ * @param sectors cache capacity in sectors
+ * @param sector_size sector size in bytes
+ * @param read disk read callback
+ * @param write disk write callback
+ * @param context callbacks context
+ * @return SectorCache instance
+ */
+SectorCache* sector_cache_alloc(
+    size_t sectors,
+    size_t sector_size,
+    SectorCacheReadCallback read,
+    SectorCacheWriteCallback write,
+    void* context);
+
+/** Free cache, dirty sectors are not written
+ *
+ * @param cache SectorCache instance
+ */
+void sector_cache_free(SectorCache* cache);
+
+/** Read sectors
+ *
+ * @param cache SectorCache instance
+ * @param data buffer, count * sector_size
+ * @param sector first sector
+ * @param count sectors count
+ * @return true on success
+ */
+bool sector_cache_read(SectorCache* cache, uint8_t* data, uint32_t sector, uint32_t count);
+
+/** Write sectors
+ *
+ * @param cache SectorCache instance
+ * @param data buffer, count * sector_size
+ * @param sector first sector
+ * @param count sectors count
+ * @return true on success
+ */
+bool sector_cache_write(SectorCache* cache, const uint8_t* data, uint32_t sector, uint32_t count);
+
+/** Write all dirty sectors to disk, in ascending order
+ *
+ * @param cache SectorCache instance
+ * @return true on success
+ */
+bool sector_cache_flush(SectorCache* cache);
+
+/** Drop all sectors, dirty ones included. For disk change.
+ *
+ * @param cache SectorCache instance
+ */
+void sector_cache_invalidate(SectorCache* cache);
+
+/** Get statistics
+ *
+ * @param cache SectorCache instance
+ * @param stats output
+ */
+void sector_cache_get_stats(SectorCache* cache, SectorCacheStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
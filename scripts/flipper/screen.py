@@ -0,0 +1,144 @@
+import serial
+import struct
+
+from flipper.storage import BufferedRead
+
+
+class HeatshrinkDecoder:
+    """
+    Heatshrink decoder matching furi_hal_compress: window 2^8, lookahead 2^4
+    """
+
+    WINDOW_BITS = 8
+    LOOKAHEAD_BITS = 4
+
+    def __init__(self, data: bytes):
+        self.data = data
+        self.bit = 0
+
+    def _bits(self, count: int):
+        if self.bit + count > len(self.data) * 8:
+            return None
+        value = 0
+        for _ in range(count):
+            byte = self.data[self.bit >> 3]
+            value = (value << 1) | ((byte >> (7 - (self.bit & 7))) & 1)
+            self.bit += 1
+        return value
+
+    def decode(self) -> bytes:
+        # Window starts zeroed, back references may point there
+        window = 1 << self.WINDOW_BITS
+        output = bytearray(window)
+        while True:
+            tag = self._bits(1)
+            if tag is None:
+                break
+            if tag:
+                literal = self._bits(8)
+                if literal is None:
+                    break
+                output.append(literal)
+            else:
+                index = self._bits(self.WINDOW_BITS)
+                count = self._bits(self.LOOKAHEAD_BITS)
+                if index is None or count is None:
+                    break
+                for _ in range(count + 1):
+                    output.append(output[-(index + 1)])
+        return bytes(output[window:])
+
+
+def decompress(payload: bytes) -> bytes:
+    """
+    Undo furi_hal_compress_encode: 4 byte header and heatshrink data,
+    or 0x00 and raw data if compression didn't help
+    """
+    if payload[0] == 1:
+        (size,) = struct.unpack_from("<H", payload, 2)
+        return HeatshrinkDecoder(payload[4:size]).decode()
+    return bytes(payload[1:])
+
+
+class ScreenStreamDecoder:
+    """
+    Rebuilds frames from `screen_stream delta` packets,
+    see applications/gui/screen_stream_encoder.h
+    """
+
+    PACKET_KEY = 0x00
+    PACKET_DELTA = 0x01
+
+    def __init__(self, frame_size: int = 1024):
+        self.frame = bytearray(frame_size)
+        self.synced = False
+
+    def feed(self, packet_type: int, payload: bytes):
+        """
+        Returns the frame, or None until the first key packet arrives
+        """
+        data = decompress(payload)
+        if len(data) != len(self.frame):
+            raise Exception(f"Bad frame size: {len(data)}")
+
+        if packet_type == self.PACKET_KEY:
+            self.frame[:] = data
+            self.synced = True
+        elif packet_type == self.PACKET_DELTA:
+            for i, value in enumerate(data):
+                self.frame[i] ^= value
+        else:
+            raise Exception(f"Unknown packet type: {packet_type}")
+
+        return bytes(self.frame) if self.synced else None
+
+
+class FlipperScreen:
+    MAGIC = bytes([0xF0, 0xE1, 0xD2, 0xC3])
+
+    def __init__(self, portname: str):
+        self.port = serial.Serial()
+        self.port.port = portname
+        self.port.timeout = 2
+        self.port.baudrate = 115200
+        self.read = BufferedRead(self.port)
+        self.decoder = ScreenStreamDecoder()
+
+    def start(self):
+        self.port.open()
+        self.port.reset_input_buffer()
+        self.port.write(b"screen_stream delta\r")
+
+    def stop(self):
+        # Any key except escape stops streaming
+        self.port.write(b"\r")
+        self.port.close()
+
+    def _fill(self, size: int):
+        while len(self.read.buffer) < size:
+            self.read.buffer.extend(self.port.read(max(1, self.port.in_waiting)))
+
+    def _sync(self):
+        while True:
+            i = self.read.buffer.find(self.MAGIC)
+            if i >= 0:
+                self.read.buffer = self.read.buffer[i + len(self.MAGIC) :]
+                return
+            self._fill(len(self.read.buffer) + 1)
+
+    def _read_exactly(self, size: int) -> bytes:
+        self._fill(size)
+        data = bytes(self.read.buffer[:size])
+        self.read.buffer = self.read.buffer[size:]
+        return data
+
+    def frames(self):
+        """
+        Yields 1024 byte frames in u8g2 page layout
+        """
+        while True:
+            self._sync()
+            packet_type, size = struct.unpack("<BH", self._read_exactly(3))
+            frame = self.decoder.feed(packet_type, self._read_exactly(size))
+            if frame is not None:
+                yield frame